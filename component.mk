@@ -1,2 +1,2 @@
 COMPONENT_ADD_INCLUDEDIRS=src
-COMPONENT_SRCDIRS=src src/platform src/drivers
+COMPONENT_SRCDIRS=src src/platform src/drivers src/utils
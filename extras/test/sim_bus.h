@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_BUS__
+#define __OWNG_TEST_SIM_BUS__
+
+#include "common.h"
+
+#define MAX_SIM_SLAVES 20
+#define MAX_SIM_TX 160
+
+/**
+ * Set emulated device id with a given family code and serial number.
+ */
+static inline void setId(OneWireNg::Id& id, uint8_t family, uint8_t sn)
+{
+    memset(&id[0], 0, sizeof(OneWireNg::Id));
+    id[0] = family;
+    id[1] = sn;
+    id[7] = OneWireNg::crc8(&id[0], 7);
+}
+
+/**
+ * Emulated 1-wire slave device.
+ *
+ * ROM commands layer is handled by @c SimBus. Function commands are passed
+ * to the slave byte-by-byte via @ref onByte(). The slave responds by queuing
+ * bytes to send with @ref send().
+ */
+class SimSlave
+{
+public:
+    SimSlave(const OneWireNg::Id& id): _txLen(0), _txPos(0), _rx(0), _rxBits(0) {
+        memcpy(_id, id, sizeof(OneWireNg::Id));
+    }
+
+    virtual ~SimSlave() {}
+
+    const OneWireNg::Id& getId() const {
+        return _id;
+    }
+
+    /** Alarm state (for conditional search) */
+    virtual bool alarm() const {
+        return false;
+    }
+
+    /** Sequence detect chain state (responding to Conditional Read ROM) */
+    virtual bool chainActive() const {
+        return false;
+    }
+
+    /** Called on reset pulse */
+    virtual void onReset() {}
+
+    /** Called on the slave addressed by ROM command */
+    virtual void onSelect() {}
+
+    /** Called on a function command layer byte received from the master */
+    virtual void onByte(uint8_t byte) = 0;
+
+    /**
+     * Bit driven by the slave on read slot if there is nothing to send
+     * (e.g. busy indication while performing conversion).
+     */
+    virtual int idleBit() {
+        return 1;
+    }
+
+    void reset()
+    {
+        _txLen = _txPos = 0;
+        _rx = 0;
+        _rxBits = 0;
+        onReset();
+    }
+
+    /** Function commands layer bit touch */
+    int touchBit(int bit)
+    {
+        if (_txPos < _txLen * 8) {
+            int ret = (_tx[_txPos >> 3] >> (_txPos & 7)) & 1;
+            if (++_txPos >= _txLen * 8)
+                _txLen = _txPos = 0;
+            return ret;
+        }
+
+        int ret = (bit ? idleBit() : 0);
+        if (bit) _rx |= (uint8_t)(1 << _rxBits);
+        if (++_rxBits >= 8) {
+            uint8_t byte = _rx;
+            _rx = 0;
+            _rxBits = 0;
+            onByte(byte);
+        }
+        return ret;
+    }
+
+protected:
+    void send(const uint8_t *bytes, size_t len)
+    {
+        for (size_t i = 0; i < len && _txLen < MAX_SIM_TX; i++)
+            _tx[_txLen++] = bytes[i];
+    }
+
+    void sendByte(uint8_t byte) {
+        send(&byte, 1);
+    }
+
+    OneWireNg::Id _id;
+
+private:
+    uint8_t _tx[MAX_SIM_TX];
+    size_t _txLen;
+    size_t _txPos;
+    uint8_t _rx;
+    int _rxBits;
+};
+
+/**
+ * Emulated 1-wire bus with attached slave devices.
+ */
+class SimBus: public OneWireNg
+{
+public:
+    SimBus(): nResets(0), nBits(0), _n(0), _state(ST_IDLE), _resume(-1) {}
+
+    void attach(SimSlave *slave)
+    {
+        if (_n < MAX_SIM_SLAVES) {
+            _slaves[_n] = slave;
+            _sel[_n] = false;
+            _n++;
+        }
+    }
+
+    void detachAll() {
+        _n = 0;
+    }
+
+#if CONFIG_OVERDRIVE_ENABLED
+    bool isOverdrive() const {
+        return _overdrive;
+    }
+#endif
+
+    ErrorCode reset()
+    {
+        nResets++;
+        _state = ST_ROM_CMD;
+        _cnt = 0;
+        _cmd = 0;
+
+        for (int i = 0; i < _n; i++) {
+            _sel[i] = false;
+            _slaves[i]->reset();
+        }
+        return (_n > 0 ? EC_SUCCESS : EC_NO_DEVS);
+    }
+
+    int touchBit(int bit, bool power)
+    {
+        (void)power;
+        bit = (bit != 0);
+        nBits++;
+
+        switch (_state)
+        {
+        case ST_ROM_CMD:
+            if (bit) _cmd |= (uint8_t)(1 << _cnt);
+            if (++_cnt >= 8)
+                romCommand();
+            return bit;
+
+        case ST_READ_ROM:
+          {
+            int res = bit;
+            for (int i = 0; i < _n; i++) {
+                if (_sel[i])
+                    res &= idBit(i, _cnt);
+            }
+            if (++_cnt >= 64)
+                selected();
+            return res;
+          }
+
+        case ST_MATCH:
+            for (int i = 0; i < _n; i++) {
+                if (_sel[i] && idBit(i, _cnt) != bit)
+                    _sel[i] = false;
+            }
+            if (++_cnt >= 64)
+                selected();
+            return bit;
+
+        case ST_SEARCH:
+            return searchTouch(bit);
+
+        case ST_FUNC:
+          {
+            int res = bit;
+            for (int i = 0; i < _n; i++) {
+                if (_sel[i])
+                    res &= _slaves[i]->touchBit(bit);
+            }
+            return res;
+          }
+
+        default:
+            return bit;
+        }
+    }
+
+    /** Number of transmitted resets */
+    unsigned long nResets;
+    /** Number of touched bits */
+    unsigned long nBits;
+
+private:
+    enum {
+        ST_IDLE = 0,
+        ST_ROM_CMD,
+        ST_READ_ROM,
+        ST_MATCH,
+        ST_SEARCH,
+        ST_FUNC
+    };
+
+    /* DS28EA00 sequence detect */
+    const static uint8_t CMD_COND_READ_ROM = 0x0f;
+
+    int idBit(int i, int n) {
+        return (_slaves[i]->getId()[n >> 3] >> (n & 7)) & 1;
+    }
+
+    void romCommand()
+    {
+        _cnt = 0;
+
+        switch (_cmd)
+        {
+        case CMD_READ_ROM:
+            selectAll();
+            _state = ST_READ_ROM;
+            break;
+
+        case CMD_MATCH_ROM:
+#if CONFIG_OVERDRIVE_ENABLED
+        case CMD_MATCH_ROM_OVERDRIVE:
+#endif
+            selectAll();
+            _state = ST_MATCH;
+            break;
+
+        case CMD_SKIP_ROM:
+#if CONFIG_OVERDRIVE_ENABLED
+        case CMD_SKIP_ROM_OVERDRIVE:
+#endif
+            selectAll();
+            _resume = -1;
+            _state = ST_FUNC;
+            break;
+
+        case CMD_RESUME:
+            if (_resume >= 0 && _resume < _n) {
+                _sel[_resume] = true;
+                _slaves[_resume]->onSelect();
+            }
+            _state = ST_FUNC;
+            break;
+
+        case CMD_COND_READ_ROM:
+            for (int i = 0; i < _n; i++)
+                _sel[i] = _slaves[i]->chainActive();
+            _state = ST_READ_ROM;
+            break;
+
+        case CMD_SEARCH_ROM:
+        case CMD_SEARCH_ROM_COND:
+            for (int i = 0; i < _n; i++) {
+                _sel[i] = (_cmd == CMD_SEARCH_ROM || _slaves[i]->alarm());
+            }
+            _state = ST_SEARCH;
+            break;
+
+        default:
+            _state = ST_IDLE;
+            break;
+        }
+    }
+
+    void selectAll()
+    {
+        for (int i = 0; i < _n; i++)
+            _sel[i] = true;
+    }
+
+    /* ROM layer finished; selected slaves proceed with function commands */
+    void selected()
+    {
+        int nsel = 0;
+        for (int i = 0; i < _n; i++) {
+            if (_sel[i]) {
+                _resume = i;
+                nsel++;
+                _slaves[i]->onSelect();
+            }
+        }
+        if (nsel != 1) _resume = -1;
+        _state = ST_FUNC;
+    }
+
+    int searchTouch(int bit)
+    {
+        int n = _cnt / 3;
+        int trpl = _cnt % 3;
+        int res = bit;
+
+        for (int i = 0; i < _n; i++)
+        {
+            if (!_sel[i]) continue;
+
+            int bv = idBit(i, n);
+            if (trpl == 2) {
+                /* selection bit */
+                if (bv != bit)
+                    _sel[i] = false;
+            } else {
+                /* presence bits */
+                res &= (!trpl ? bv : !bv);
+            }
+        }
+        if (++_cnt >= 3 * 64)
+            selected();
+        return res;
+    }
+
+    SimSlave *_slaves[MAX_SIM_SLAVES];
+    bool _sel[MAX_SIM_SLAVES];
+    int _n;
+
+    int _state;
+    int _cnt;
+    uint8_t _cmd;
+    int _resume;
+};
+
+#endif /* __OWNG_TEST_SIM_BUS__ */
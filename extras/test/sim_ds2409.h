@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_DS2409__
+#define __OWNG_TEST_SIM_DS2409__
+
+#include "sim_bus.h"
+#include "drivers/DS2409.h"
+
+#define MAX_SIM_BRANCH 8
+
+/**
+ * Emulated DS2409 coupler with devices on its branches.
+ */
+class SimDS2409: public SimSlave
+{
+public:
+    SimDS2409(const OneWireNg::Id& id):
+        SimSlave(id), active(-1), nSmartOn(0), nOff(0), _state(0)
+    {
+        _nBranch[0] = _nBranch[1] = 0;
+    }
+
+    void attachBranch(int branch, SimSlave *slave)
+    {
+        if (_nBranch[branch] < MAX_SIM_BRANCH)
+            _branch[branch][_nBranch[branch]++] = slave;
+    }
+
+    size_t branchSize(int branch) const {
+        return _nBranch[branch];
+    }
+
+    SimSlave *branchSlave(int branch, size_t i) const {
+        return _branch[branch][i];
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            _state = -1;
+            switch (byte)
+            {
+            case DS2409::CMD_ALL_LINES_OFF:
+            case DS2409::CMD_DISCHARGE_LINES:
+                active = -1;
+                nOff++;
+                sendByte(byte);
+                break;
+
+            case DS2409::CMD_DIRECT_ON_MAIN:
+                active = DS2409::BRANCH_MAIN;
+                sendByte(byte);
+                break;
+
+            case DS2409::CMD_SMART_ON_MAIN:
+            case DS2409::CMD_SMART_ON_AUX:
+                /* wait for the reset stimulus */
+                _state = byte;
+                break;
+            }
+            break;
+
+        case DS2409::CMD_SMART_ON_MAIN:
+        case DS2409::CMD_SMART_ON_AUX:
+            active = (_state == DS2409::CMD_SMART_ON_AUX ?
+                DS2409::BRANCH_AUX : DS2409::BRANCH_MAIN);
+            nSmartOn++;
+            /* presence detect byte, confirmation byte */
+            sendByte(_nBranch[active] > 0 ? 0x00 : 0xff);
+            sendByte((uint8_t)_state);
+            _state = -1;
+            break;
+        }
+    }
+
+    /** Connected branch (-1: none) */
+    int active;
+    /** Number of smart-on commands */
+    int nSmartOn;
+    /** Number of all lines off commands */
+    int nOff;
+
+private:
+    SimSlave *_branch[2][MAX_SIM_BRANCH];
+    size_t _nBranch[2];
+    int _state;
+};
+
+/**
+ * Emulated trunk bus with DS2409 couplers. Devices on the connected
+ * branches are attached to the bus on each reset.
+ */
+class SimMicroLan: public SimBus
+{
+public:
+    SimMicroLan(): _n(0), _nc(0) {}
+
+    void attachTrunk(SimSlave *slave)
+    {
+        if (_n < MAX_SIM_SLAVES)
+            _trunk[_n++] = slave;
+    }
+
+    void attachCoupler(SimDS2409 *coupler)
+    {
+        attachTrunk(coupler);
+        if (_nc < MAX_SIM_SLAVES)
+            _couplers[_nc++] = coupler;
+    }
+
+    ErrorCode reset()
+    {
+        detachAll();
+        for (size_t i = 0; i < _n; i++)
+            attach(_trunk[i]);
+
+        for (size_t i = 0; i < _nc; i++) {
+            int br = _couplers[i]->active;
+            if (br < 0) continue;
+            for (size_t j = 0; j < _couplers[i]->branchSize(br); j++)
+                attach(_couplers[i]->branchSlave(br, j));
+        }
+        return SimBus::reset();
+    }
+
+private:
+    SimSlave *_trunk[MAX_SIM_SLAVES];
+    SimDS2409 *_couplers[MAX_SIM_SLAVES];
+    size_t _n;
+    size_t _nc;
+};
+
+#endif /* __OWNG_TEST_SIM_DS2409__ */
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_DS2423__
+#define __OWNG_TEST_SIM_DS2423__
+
+#include "sim_bus.h"
+#include "drivers/DS2423.h"
+
+/**
+ * Emulated DS2423 counter.
+ *
+ * "Read Memory + Counter" command streams memory pages bit-by-bit on read
+ * slots, each page followed by its counter, 4 zero bytes and inverted
+ * CRC-16.
+ */
+class SimDS2423: public SimSlave
+{
+public:
+    SimDS2423(const OneWireNg::Id& id):
+        SimSlave(id), crcErr(false), _state(0)
+    {
+        for (size_t i = 0; i < sizeof(_mem); i++)
+            _mem[i] = (uint8_t)(i * 7 + id[1]);
+        for (int i = 0; i < DS2423::PAGES_NUM; i++)
+            _counters[i] = 0xffffffff;
+    }
+
+    void setCounter(int page, uint32_t val) {
+        _counters[page] = val;
+    }
+
+    const uint8_t *getPage(int page) const {
+        return &_mem[page * DS2423::PAGE_SIZE];
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    int idleBit()
+    {
+        if (_state != ST_STREAM)
+            return 1;
+
+        if (!_bit)
+            _byte = nextByte();
+
+        int ret = (_byte >> _bit) & 1;
+        _bit = (_bit + 1) & 7;
+        return ret;
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            _state = (byte == DS2423::CMD_READ_MEMORY_COUNTER ? ST_TA1 : -1);
+            _crc = OneWireNg::crc16(&byte, 1);
+            break;
+
+        case ST_TA1:
+            _addr = byte;
+            _crc = OneWireNg::crc16(&byte, 1, _crc);
+            _state = ST_TA2;
+            break;
+
+        case ST_TA2:
+            _addr |= (unsigned)byte << 8;
+            _crc = OneWireNg::crc16(&byte, 1, _crc);
+            _trailer = 0;
+            _bit = 0;
+            _state = ST_STREAM;
+            break;
+        }
+    }
+
+    bool crcErr;
+
+private:
+    enum {
+        ST_TA1 = 1,
+        ST_TA2,
+        ST_STREAM
+    };
+
+    uint8_t nextByte()
+    {
+        uint8_t ret;
+
+        if (!_trailer) {
+            if (_addr >= sizeof(_mem))
+                return 0xff;
+
+            ret = _mem[_addr++];
+            _crc = OneWireNg::crc16(&ret, 1, _crc);
+            if (!(_addr % DS2423::PAGE_SIZE))
+                _trailer = 1;
+            return ret;
+        }
+
+        /* counter, 4 zero bytes, inverted CRC-16 */
+        int i = _trailer - 1;
+        if (i < 8) {
+            uint32_t cnt = _counters[(_addr - 1) / DS2423::PAGE_SIZE];
+            ret = (i < 4 ? (uint8_t)(cnt >> (8 * i)) : 0);
+            _crc = OneWireNg::crc16(&ret, 1, _crc);
+            _trailer++;
+        } else {
+            uint16_t crc = (uint16_t)~_crc;
+            if (crcErr)
+                crc ^= 1;
+            ret = (i == 8 ? (uint8_t)crc : (uint8_t)(crc >> 8));
+            if (i == 9) {
+                _trailer = 0;
+                _crc = 0;
+            } else
+                _trailer++;
+        }
+        return ret;
+    }
+
+    uint8_t _mem[DS2423::PAGES_NUM * DS2423::PAGE_SIZE];
+    uint32_t _counters[DS2423::PAGES_NUM];
+    int _state;
+    unsigned _addr;
+    uint16_t _crc;
+    int _trailer;
+    uint8_t _byte;
+    int _bit;
+};
+
+#endif /* __OWNG_TEST_SIM_DS2423__ */
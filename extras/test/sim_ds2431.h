@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_DS2431__
+#define __OWNG_TEST_SIM_DS2431__
+
+#include "sim_bus.h"
+#include "drivers/DS2431.h"
+
+/**
+ * Emulated DS2431 EEPROM.
+ *
+ * Scratchpad writes, reads and copies are emulated together with page
+ * protection (write protection, EPROM mode) and copy completion pattern.
+ * Programming is performed immediately.
+ */
+class SimDS2431: public SimSlave
+{
+public:
+    SimDS2431(const OneWireNg::Id& id):
+        SimSlave(id), nWrites(0), nCopies(0), nMemReads(0),
+        _ta(0), _es(0), _cnt(0), _copied(false), _state(0)
+    {
+        memset(_mem, 0xff, sizeof(_mem));
+        memset(&_mem[DS2431::ADDR_PAGE_PROT], 0x00, 5);
+        _mem[DS2431::ADDR_FACTORY] = 0x55;
+        memset(_scrpd, 0xff, sizeof(_scrpd));
+    }
+
+    uint8_t *getMem() {
+        return _mem;
+    }
+
+    void onReset()
+    {
+        _state = 0;
+        _copied = false;
+    }
+
+    /* 0xAA pattern signalled after copy completion */
+    int idleBit() {
+        return (_copied ? (_cnt++ & 1) : 1);
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            _state = byte;
+            _cnt = 0;
+            _crc = OneWireNg::crc16(&byte, 1);
+            if (byte == DS2431::CMD_READ_SCRATCHPAD)
+                readScratchpad();
+            break;
+
+        case DS2431::CMD_WRITE_SCRATCHPAD:
+            _crc = OneWireNg::crc16(&byte, 1, _crc);
+            if (_cnt == 0) {
+                _ta = byte;
+            } else if (_cnt == 1) {
+                _ta |= (unsigned)byte << 8;
+                _es = (uint8_t)(_ta & 7);
+            } else {
+                unsigned off = (_ta & 7) + (_cnt - 2);
+                _scrpd[off] = byte;
+                _es = (uint8_t)off;
+                if (off == 7) {
+                    /* write protected data is substituted */
+                    unsigned row = _ta & ~7U;
+                    if (row < DS2431::MEM_SIZE && protection(row) == 0x55)
+                        memcpy(_scrpd, &_mem[row], 8);
+
+                    uint16_t crc = (uint16_t)~_crc;
+                    sendByte((uint8_t)(crc & 0xff));
+                    sendByte((uint8_t)(crc >> 8));
+                    nWrites++;
+                    _state = -1;
+                }
+            }
+            _cnt++;
+            break;
+
+        case DS2431::CMD_COPY_SCRATCHPAD:
+          {
+            uint8_t auth[3] = {
+                (uint8_t)(_ta & 0xff), (uint8_t)(_ta >> 8), _es };
+            if (byte != auth[_cnt]) {
+                _state = -1;
+                break;
+            }
+            if (++_cnt >= 3) {
+                unsigned row = _ta & ~7U;
+                if (protection(row) != 0x55) {
+                    for (int i = 0; i < 8; i++) {
+                        _mem[row + i] = (protection(row) == 0xaa ?
+                            (uint8_t)(_mem[row + i] & _scrpd[i]) : _scrpd[i]);
+                    }
+                }
+                _es |= 0x80;
+                _copied = true;
+                _cnt = 0;
+                nCopies++;
+                _state = -1;
+            }
+            break;
+          }
+
+        case DS2431::CMD_READ_MEMORY:
+            if (_cnt == 0) {
+                _ta = byte;
+            } else {
+                _ta |= (unsigned)byte << 8;
+                if (_ta < DS2431::MEM_SIZE)
+                    send(&_mem[_ta], DS2431::MEM_SIZE - _ta);
+                nMemReads++;
+                _state = -1;
+            }
+            _cnt++;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /** Number of writes to scratchpad */
+    int nWrites;
+    /** Number of scratchpad copies */
+    int nCopies;
+    /** Number of memory reads */
+    int nMemReads;
+
+private:
+    uint8_t protection(unsigned row) const
+    {
+        if (row < DS2431::DATA_SIZE)
+            return _mem[DS2431::ADDR_PAGE_PROT + row / DS2431::PAGE_SIZE];
+        return (_mem[DS2431::ADDR_COPY_PROT] == 0x55 ||
+            _mem[DS2431::ADDR_COPY_PROT] == 0xaa ? 0x55 : 0);
+    }
+
+    void readScratchpad()
+    {
+        uint8_t resp[3 + 8 + 2];
+        size_t n = 0;
+
+        resp[n++] = (uint8_t)(_ta & 0xff);
+        resp[n++] = (uint8_t)(_ta >> 8);
+        resp[n++] = _es;
+        for (unsigned i = (_ta & 7); i <= (unsigned)(_es & 7); i++)
+            resp[n++] = _scrpd[i];
+
+        uint16_t crc = (uint16_t)~OneWireNg::crc16(resp, n, _crc);
+        resp[n++] = (uint8_t)(crc & 0xff);
+        resp[n++] = (uint8_t)(crc >> 8);
+
+        send(resp, n);
+        _state = -1;
+    }
+
+    uint8_t _mem[DS2431::MEM_SIZE];
+    uint8_t _scrpd[8];
+    unsigned _ta;
+    uint8_t _es;
+    int _cnt;
+    uint16_t _crc;
+    bool _copied;
+    int _state;
+};
+
+#endif /* __OWNG_TEST_SIM_DS2431__ */
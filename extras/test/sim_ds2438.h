@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_DS2438__
+#define __OWNG_TEST_SIM_DS2438__
+
+#include "sim_bus.h"
+#include "drivers/DS2438.h"
+
+/**
+ * Emulated DS2438 smart battery monitor.
+ *
+ * Conversions hold the bus low for @c busySlots read slots. Measured values
+ * are set by @ref setInputs().
+ */
+class SimDS2438: public SimSlave
+{
+public:
+    SimDS2438(const OneWireNg::Id& id):
+        SimSlave(id), nConvT(0), nConvV(0), nRecalls(0), busySlots(3),
+        crcErr(false), _temp(0), _vad(0), _vdd(0), _busy(0), _state(0)
+    {
+        memset(_mem, 0, sizeof(_mem));
+        memset(_scrpd, 0, sizeof(_scrpd));
+    }
+
+    /**
+     * Set measured inputs: temperature (1/256 C units), VAD and VDD
+     * voltages (10 mV units) and current A/D value.
+     */
+    void setInputs(int16_t temp, uint16_t vad, uint16_t vdd, int16_t curr)
+    {
+        _temp = temp;
+        _vad = vad;
+        _vdd = vdd;
+        _mem[0][5] = (uint8_t)curr;
+        _mem[0][6] = (uint8_t)((uint16_t)curr >> 8);
+    }
+
+    const uint8_t *getPage(uint8_t page) const {
+        return _mem[page];
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    int idleBit()
+    {
+        if (_busy > 0) {
+            _busy--;
+            return 0;
+        }
+        return 1;
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            _cmd = byte;
+            _state = command(byte);
+            break;
+
+        case ST_PAGE:
+            _page = byte & 7;
+            _state = -1;
+
+            switch (_cmd)
+            {
+            case DS2438::CMD_RECALL_MEMORY:
+                nRecalls++;
+                memcpy(_scrpd[_page], _mem[_page], DS2438::PAGE_SIZE);
+                break;
+
+            case DS2438::CMD_READ_SCRATCHPAD:
+              {
+                uint8_t crc = OneWireNg::crc8(_scrpd[_page], DS2438::PAGE_SIZE);
+                send(_scrpd[_page], DS2438::PAGE_SIZE);
+                sendByte(crcErr ? (uint8_t)~crc : crc);
+                break;
+              }
+
+            case DS2438::CMD_WRITE_SCRATCHPAD:
+                _cnt = 0;
+                _state = ST_WRITE;
+                break;
+
+            case DS2438::CMD_COPY_SCRATCHPAD:
+                if (_page == 0) {
+                    /* config bits and threshold are writable only */
+                    _mem[0][0] = (uint8_t)((_mem[0][0] & 0xf0) |
+                        (_scrpd[0][0] & 0x0f));
+                    _mem[0][7] = _scrpd[0][7];
+                } else
+                    memcpy(_mem[_page], _scrpd[_page], DS2438::PAGE_SIZE);
+                break;
+            }
+            break;
+
+        case ST_WRITE:
+            if (_cnt < DS2438::PAGE_SIZE)
+                _scrpd[_page][_cnt++] = byte;
+            break;
+        }
+    }
+
+    unsigned long nConvT;
+    unsigned long nConvV;
+    unsigned long nRecalls;
+    int busySlots;
+    bool crcErr;
+
+private:
+    enum {
+        ST_PAGE = 1,
+        ST_WRITE
+    };
+
+    int command(uint8_t cmd)
+    {
+        switch (cmd)
+        {
+        case DS2438::CMD_CONVERT_T:
+            nConvT++;
+            _mem[0][1] = (uint8_t)(_temp & 0xf8);
+            _mem[0][2] = (uint8_t)((uint16_t)_temp >> 8);
+            _busy = busySlots;
+            return -1;
+
+        case DS2438::CMD_CONVERT_V:
+          {
+            uint16_t v = (_mem[0][0] & DS2438::CFG_AD ? _vdd : _vad);
+            nConvV++;
+            _mem[0][3] = (uint8_t)v;
+            _mem[0][4] = (uint8_t)((v >> 8) & 3);
+            _busy = busySlots;
+            return -1;
+          }
+
+        case DS2438::CMD_RECALL_MEMORY:
+        case DS2438::CMD_READ_SCRATCHPAD:
+        case DS2438::CMD_WRITE_SCRATCHPAD:
+        case DS2438::CMD_COPY_SCRATCHPAD:
+            return ST_PAGE;
+
+        default:
+            return -1;
+        }
+    }
+
+    uint8_t _mem[DS2438::PAGES_NUM][DS2438::PAGE_SIZE];
+    uint8_t _scrpd[DS2438::PAGES_NUM][DS2438::PAGE_SIZE];
+    int16_t _temp;
+    uint16_t _vad;
+    uint16_t _vdd;
+    int _busy;
+    int _state;
+    uint8_t _cmd;
+    uint8_t _page;
+    size_t _cnt;
+};
+
+#endif /* __OWNG_TEST_SIM_DS2438__ */
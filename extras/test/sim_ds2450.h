@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_DS2450__
+#define __OWNG_TEST_SIM_DS2450__
+
+#include "sim_bus.h"
+#include "drivers/DS2450.h"
+
+/**
+ * Emulated DS2450 quad A/D converter.
+ *
+ * Channels inputs are set by @ref setInput() as full-scale fractions
+ * (16-bit); conversion truncates them to the configured resolution.
+ * Conversion holds the bus low for @c busySlots read slots.
+ */
+class SimDS2450: public SimSlave
+{
+public:
+    SimDS2450(const OneWireNg::Id& id):
+        SimSlave(id), nConv(0), busySlots(3), crcErr(false),
+        _busy(0), _state(0)
+    {
+        memset(_mem, 0, sizeof(_mem));
+        memset(_inputs, 0, sizeof(_inputs));
+
+        /* power-on control: 8 bits resolution, 2.56V range */
+        for (int ch = 0; ch < DS2450::CHANNELS_NUM; ch++) {
+            _mem[DS2450::ADDR_CONTROL + 2 * ch] = 0x08;
+            _mem[DS2450::ADDR_CONTROL + 2 * ch + 1] = 0x8c;
+        }
+    }
+
+    void setInput(int ch, uint16_t val) {
+        _inputs[ch] = val;
+    }
+
+    const uint8_t *getMem() const {
+        return _mem;
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    int idleBit()
+    {
+        if (_busy > 0) {
+            _busy--;
+            return 0;
+        }
+        return 1;
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            _cmd[0] = byte;
+            _cnt = 1;
+            _state = (byte == DS2450::CMD_READ_MEMORY ||
+                byte == DS2450::CMD_WRITE_MEMORY ||
+                byte == DS2450::CMD_CONVERT ? ST_ARGS : -1);
+            break;
+
+        case ST_ARGS:
+            _cmd[_cnt++] = byte;
+            if (_cnt < 3)
+                break;
+
+            _addr = _cmd[1];
+            if (_cmd[0] == DS2450::CMD_READ_MEMORY) {
+                readMemory();
+                _state = -1;
+            } else if (_cmd[0] == DS2450::CMD_WRITE_MEMORY) {
+                _state = ST_WRITE;
+            } else {
+                sendCrc(OneWireNg::crc16(_cmd, 3));
+                convert(_cmd[1], _cmd[2]);
+                _state = -1;
+            }
+            break;
+
+        case ST_WRITE:
+          {
+            uint16_t crc;
+            if (_cnt) {
+                _cmd[3] = byte;
+                crc = OneWireNg::crc16(_cmd, 4);
+                _cnt = 0;
+            } else {
+                uint8_t buf[3] = { _addr, 0, byte };
+                crc = OneWireNg::crc16(buf, sizeof(buf));
+            }
+            /* results page is read only */
+            if (_addr >= DS2450::PAGE_SIZE && _addr < DS2450::MEM_SIZE)
+                _mem[_addr] = byte;
+
+            sendCrc(crc);
+            sendByte(_addr < DS2450::MEM_SIZE ? _mem[_addr] : 0xff);
+            _addr++;
+            break;
+          }
+        }
+    }
+
+    unsigned long nConv;
+    int busySlots;
+    bool crcErr;
+
+private:
+    enum {
+        ST_ARGS = 1,
+        ST_WRITE
+    };
+
+    void sendCrc(uint16_t crc)
+    {
+        crc = (uint16_t)~crc;
+        if (crcErr)
+            crc ^= 1;
+        sendByte((uint8_t)crc);
+        sendByte((uint8_t)(crc >> 8));
+    }
+
+    void readMemory()
+    {
+        uint16_t crc = OneWireNg::crc16(_cmd, 3);
+
+        for (unsigned a = _addr; a < DS2450::MEM_SIZE; a++) {
+            sendByte(_mem[a]);
+            crc = OneWireNg::crc16(&_mem[a], 1, crc);
+            if ((a + 1) % DS2450::PAGE_SIZE == 0) {
+                sendCrc(crc);
+                crc = 0;
+            }
+        }
+    }
+
+    void convert(uint8_t mask, uint8_t preset)
+    {
+        nConv++;
+
+        for (int ch = 0; ch < DS2450::CHANNELS_NUM; ch++)
+        {
+            uint16_t res;
+
+            if (mask & (1 << ch)) {
+                int bits = _mem[DS2450::ADDR_CONTROL + 2 * ch] & 0x0f;
+                if (!bits) bits = 16;
+                res = (uint16_t)(_inputs[ch] & ~((1u << (16 - bits)) - 1));
+            } else {
+                int pr = (preset >> (2 * ch)) & 3;
+                if (pr == 1)
+                    res = 0;
+                else if (pr == 2)
+                    res = 0xffff;
+                else
+                    continue;
+            }
+            _mem[2 * ch] = (uint8_t)res;
+            _mem[2 * ch + 1] = (uint8_t)(res >> 8);
+        }
+        _busy = busySlots;
+    }
+
+    uint8_t _mem[DS2450::MEM_SIZE];
+    uint16_t _inputs[DS2450::CHANNELS_NUM];
+    int _busy;
+    int _state;
+    uint8_t _cmd[4];
+    int _cnt;
+    uint8_t _addr;
+};
+
+#endif /* __OWNG_TEST_SIM_DS2450__ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_DS28EA00__
+#define __OWNG_TEST_SIM_DS28EA00__
+
+#include "sim_bus.h"
+#include "drivers/DS28EA00.h"
+
+/**
+ * Emulated DS28EA00 sequence detect and PIO functionality.
+ *
+ * Sensors are chained by passing the previous sensor in the chain (whose
+ * PIOA drives EN input of the sensor). EN input of the first sensor in
+ * the chain is grounded.
+ */
+class SimDS28EA00: public SimSlave
+{
+public:
+    SimDS28EA00(const OneWireNg::Id& id, const SimDS28EA00 *prev = NULL):
+        SimSlave(id), nChainCmds(0), _prev(prev), _chain(CH_OFF),
+        _pio(0xff), _state(0), _cnt(0)
+    {}
+
+    bool chainActive() const {
+        return (_chain == CH_ON && enActive());
+    }
+
+    bool isDone() const {
+        return (_chain == CH_DONE);
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            _state = byte;
+            _cnt = 0;
+            if (byte == DS28EA00::CMD_PIO_READ) {
+                sendByte(status());
+                _state = -1;
+            }
+            break;
+
+        case DS28EA00::CMD_CHAIN:
+        case DS28EA00::CMD_PIO_WRITE:
+            _arg[_cnt++] = byte;
+            if (_cnt < 2)
+                break;
+
+            if ((uint8_t)~_arg[0] == _arg[1]) {
+                if (_state == DS28EA00::CMD_CHAIN)
+                    chain(_arg[0]);
+                else if (_chain == CH_OFF) {
+                    _pio = _arg[0];
+                    sendByte(0xaa);
+                    sendByte(status());
+                }
+            }
+            _state = -1;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /** Number of accepted chain commands */
+    int nChainCmds;
+
+private:
+    enum {
+        CH_OFF = 0,
+        CH_ON,
+        CH_DONE
+    };
+
+    /* EN input (PIOB) driven low by the previous sensor */
+    bool enActive() const {
+        return (!_prev || _prev->isDone());
+    }
+
+    void chain(uint8_t ctrl)
+    {
+        switch (ctrl)
+        {
+        case DS28EA00::CHAIN_OFF:
+            _chain = CH_OFF;
+            break;
+        case DS28EA00::CHAIN_ON:
+            _chain = CH_ON;
+            break;
+        case DS28EA00::CHAIN_DONE:
+            if (_chain != CH_ON) return;
+            _chain = CH_DONE;
+            break;
+        default:
+            return;
+        }
+        nChainCmds++;
+        sendByte(0xaa);
+    }
+
+    uint8_t status() const
+    {
+        /* PIOA pin, PIOA latch, PIOB pin, PIOB latch */
+        uint8_t pioa = (_chain == CH_DONE ? 0 : (_pio & 1));
+        uint8_t piob = (_chain != CH_OFF ? !enActive() : ((_pio >> 1) & 1));
+        uint8_t st = (uint8_t)(pioa | (pioa << 1) | (piob << 2) | (piob << 3));
+        return (uint8_t)(st | ((~st & 0x0f) << 4));
+    }
+
+    const SimDS28EA00 *_prev;
+    int _chain;
+    uint8_t _pio;
+    int _state;
+    int _cnt;
+    uint8_t _arg[2];
+};
+
+#endif /* __OWNG_TEST_SIM_DS28EA00__ */
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_DSTHERM__
+#define __OWNG_TEST_SIM_DSTHERM__
+
+#include <time.h>
+#include "sim_bus.h"
+#include "drivers/DSTherm.h"
+
+/**
+ * Emulated Dallas thermometer.
+ *
+ * Temperature is set via @ref setTemp() (16 scaled) and latched into the
+ * scratchpad on conversion. Conversion completion is signalled on the bus
+ * after @c convMs milliseconds per resolution step (9-bit: 1 step, 12-bit:
+ * 8 steps) mimicking the real devices timings.
+ */
+class SimDSTherm: public SimSlave
+{
+public:
+    SimDSTherm(const OneWireNg::Id& id, long temp = 0, int convMs = 2):
+        SimSlave(id), nConv(0), nWrites(0), nCopies(0), nReads(0),
+        _temp(temp), _convMs(convMs), _busyUntil(0), _alarm(false), _state(0)
+    {
+        memset(_scrpd, 0, sizeof(_scrpd));
+        _scrpd[0] = 0x50;   /* 85 C power-on value */
+        _scrpd[1] = 0x05;
+        _scrpd[4] = (isDS18S20() ? 0xff : 0x7f);
+        _scrpd[5] = 0xff;
+        _scrpd[6] = 0x0c;
+        _scrpd[7] = 0x10;
+        updateCrc();
+        memcpy(_eeprom, &_scrpd[2], sizeof(_eeprom));
+    }
+
+    /** Set temperature (16 scaled) to be measured by the next conversion */
+    void setTemp(long temp) {
+        _temp = temp;
+    }
+
+    /** Configured resolution steps (0: 9-bit, ..., 3: 12-bit) */
+    int resSteps() const {
+        return (isDS18S20() ? 3 : (_scrpd[4] >> 5) & 3);
+    }
+
+    int8_t getTh() const { return (int8_t)_scrpd[2]; }
+    int8_t getTl() const { return (int8_t)_scrpd[3]; }
+    const uint8_t *getEeprom() const { return _eeprom; }
+
+    bool alarm() const {
+        return _alarm;
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    int idleBit() {
+        return (nowMs() >= _busyUntil);
+    }
+
+    /** Conversion time in milliseconds for the configured resolution */
+    long convTime() const {
+        return (long)_convMs << resSteps();
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            command(byte);
+            break;
+
+        case DSTherm::CMD_WRITE_SCRATCHPAD:
+            _scrpd[2 + _wrn++] = byte;
+            if (_wrn >= (isDS18S20() ? 2 : 3)) {
+                if (!isDS18S20())
+                    _scrpd[4] |= 0x1f;
+                updateCrc();
+                nWrites++;
+                _state = -1;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /** Number of performed conversions */
+    int nConv;
+    /** Number of writes to scratchpad */
+    int nWrites;
+    /** Number of scratchpad copies to EEPROM */
+    int nCopies;
+    /** Number of scratchpad reads */
+    int nReads;
+
+private:
+    static long nowMs()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (long)ts.tv_sec * 1000L + ts.tv_nsec / 1000000L;
+    }
+
+    bool isDS18S20() const {
+        return (_id[0] == DSTherm::DS18S20);
+    }
+
+    void updateCrc() {
+        _scrpd[8] = OneWireNg::crc8(_scrpd, 8);
+    }
+
+    void command(uint8_t cmd)
+    {
+        _state = -1;
+
+        switch (cmd)
+        {
+        case DSTherm::CMD_CONVERT_T:
+          {
+            long t;
+            if (isDS18S20()) {
+                t = _temp >> 3;
+            } else {
+                /* mask undefined bits */
+                t = _temp & ~((1L << (3 - resSteps())) - 1);
+            }
+            _scrpd[0] = (uint8_t)(t & 0xff);
+            _scrpd[1] = (uint8_t)((t >> 8) & 0xff);
+            updateCrc();
+
+            long ti = (_temp >> 4);
+            _alarm = (ti >= (int8_t)_scrpd[2] || ti <= (int8_t)_scrpd[3]);
+            _busyUntil = nowMs() + convTime();
+            nConv++;
+            break;
+          }
+
+        case DSTherm::CMD_READ_SCRATCHPAD:
+            send(_scrpd, sizeof(_scrpd));
+            nReads++;
+            break;
+
+        case DSTherm::CMD_WRITE_SCRATCHPAD:
+            _wrn = 0;
+            _state = cmd;
+            break;
+
+        case DSTherm::CMD_COPY_SCRATCHPAD:
+            memcpy(_eeprom, &_scrpd[2], sizeof(_eeprom));
+            nCopies++;
+            break;
+
+        case DSTherm::CMD_RECALL_E2:
+            memcpy(&_scrpd[2], _eeprom, sizeof(_eeprom));
+            updateCrc();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    uint8_t _scrpd[DSTherm::Scratchpad::LENGTH];
+    uint8_t _eeprom[3];
+
+    long _temp;
+    int _convMs;
+    long _busyUntil;
+    bool _alarm;
+    int _state;
+    int _wrn;
+};
+
+#endif /* __OWNG_TEST_SIM_DSTHERM__ */
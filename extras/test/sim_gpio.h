@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_GPIO__
+#define __OWNG_TEST_SIM_GPIO__
+
+#include <time.h>
+#include <unistd.h>
+#include "common.h"
+
+/*
+ * Simulated clock (usecs). In the test environment the bit-banging delays
+ * are performed by usleep(3), which is overridden here to advance the clock
+ * instead of sleeping. The clock is read by clock_gettime(3) (overridden as
+ * well), which is the time source of the library in the test environment.
+ */
+static unsigned long simUs;
+
+extern "C" int usleep(useconds_t us)
+{
+    simUs += us;
+    return 0;
+}
+
+extern "C" int clock_gettime(clockid_t clk, struct timespec *ts) throw()
+{
+    (void)clk;
+    ts->tv_sec = simUs / 1000000UL;
+    ts->tv_nsec = (simUs % 1000000UL) * 1000L;
+    return 0;
+}
+
+/**
+ * Bit-banged bus with simulated data GPIO. The bus line may be configured
+ * with a presence pulse responded after the bus release or as shorted
+ * (held low).
+ */
+class SimGpioBus: public OneWireNg_BitBang
+{
+public:
+    SimGpioBus(): present(false), shorted(false), presStart(30),
+        presLength(120), _low(false), _release(0)
+    {
+        setupDtaGpio();
+    }
+
+    bool present;
+    bool shorted;
+    unsigned long presStart;    /* since the bus release (usecs) */
+    unsigned long presLength;   /* usecs */
+
+protected:
+    int readDtaGpioIn()
+    {
+        if (shorted || _low)
+            return 0;
+
+        unsigned long t = simUs - _release;
+        return !(present && t >= presStart && t < presStart + presLength);
+    }
+
+    void setDtaGpioAsInput()
+    {
+        if (_low) {
+            _low = false;
+            _release = simUs;
+        }
+    }
+
+#if CONFIG_PWR_CTRL_ENABLED
+    void writeGpioOut(int state, GpioType gpio) {
+        (void)state;
+        (void)gpio;
+    }
+
+    void setGpioAsOutput(int state, GpioType gpio)
+    {
+        if (gpio == GPIO_DTA)
+            _low = !state;
+    }
+#else
+    void writeGpioOut(int state) {
+        (void)state;
+    }
+
+    void setGpioAsOutput(int state) {
+        _low = !state;
+    }
+#endif
+
+private:
+    bool _low;
+    unsigned long _release;
+};
+
+#endif /* __OWNG_TEST_SIM_GPIO__ */
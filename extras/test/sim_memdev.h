@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_MEMDEV__
+#define __OWNG_TEST_SIM_MEMDEV__
+
+#include "sim_bus.h"
+#include "drivers/MemDevice.h"
+
+/**
+ * Emulated memory device.
+ *
+ * Memory is streamed bit-by-bit on read slots (no limit of the streamed
+ * data length). For devices with CRC read command, the CRC is sent as
+ * specified by the device's datasheet:
+ * - inverted CRC-16 at the end of each page, the 1st one covering the
+ *   command and address (DS28EC20),
+ * - CRC-8 of the command and address just after the address, CRC-8 of
+ *   the page data at the end of each page (DS2505, DS2506).
+ */
+class SimMemDevice: public SimSlave
+{
+public:
+    SimMemDevice(const OneWireNg::Id& id):
+        SimSlave(id), nBytes(0), errPage(-1),
+        _geom(MemDevice::getGeometry(id)), _state(0)
+    {
+        _mem = new uint8_t[_geom->size];
+        for (uint32_t i = 0; i < _geom->size; i++)
+            _mem[i] = (uint8_t)(i * 13 + (i >> 8));
+    }
+
+    ~SimMemDevice() {
+        delete[] _mem;
+    }
+
+    const uint8_t *getMem() const {
+        return _mem;
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    int idleBit()
+    {
+        if (_state != ST_STREAM)
+            return 1;
+
+        if (!_bit)
+            _byte = nextByte();
+
+        int ret = (_byte >> _bit) & 1;
+        _bit = (_bit + 1) & 7;
+        return ret;
+    }
+
+    void onByte(uint8_t byte)
+    {
+        switch (_state)
+        {
+        case 0:
+            _crcType = (byte == _geom->readCmd ?
+                _geom->crc : MemDevice::CRC_NONE);
+            _state = (byte == MemDevice::CMD_READ_MEMORY ||
+                _crcType != MemDevice::CRC_NONE ? ST_TA1 : -1);
+            _cmd[0] = byte;
+            break;
+
+        case ST_TA1:
+            _cmd[1] = byte;
+            _addr = byte;
+            _state = ST_TA2;
+            break;
+
+        case ST_TA2:
+            _cmd[2] = byte;
+            _addr |= (unsigned)byte << 8;
+            _bit = 0;
+            _nPend = 0;
+            _crc16 = 0;
+            _crc8 = 0;
+
+            if (_crcType == MemDevice::CRC_INV16) {
+                _crc16 = OneWireNg::crc16(_cmd, sizeof(_cmd));
+            } else
+            if (_crcType == MemDevice::CRC_8) {
+                _pend[0] = OneWireNg::crc8(_cmd, sizeof(_cmd));
+                _nPend = 1;
+            }
+            _pendPos = 0;
+            _state = ST_STREAM;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /** Number of streamed bytes */
+    unsigned long nBytes;
+    /** Page with corrupted data (-1: none) */
+    int errPage;
+
+private:
+    enum {
+        ST_TA1 = 1,
+        ST_TA2,
+        ST_STREAM
+    };
+
+    uint8_t nextByte()
+    {
+        nBytes++;
+
+        /* pending CRC bytes */
+        if (_pendPos < _nPend) {
+            uint8_t ret = _pend[_pendPos++];
+            if (_pendPos >= _nPend)
+                _pendPos = _nPend = 0;
+            return ret;
+        }
+
+        if (_addr >= _geom->size)
+            return 0xff;
+
+        uint8_t ret = _mem[_addr];
+        _crc16 = OneWireNg::crc16(&ret, 1, _crc16);
+        _crc8 = OneWireNg::crc8(&ret, 1, _crc8);
+        if ((int)(_addr / _geom->pageSize) == errPage)
+            ret ^= 0x01;
+
+        _addr++;
+        if (!(_addr % _geom->pageSize))
+        {
+            /* page end */
+            if (_crcType == MemDevice::CRC_INV16) {
+                uint16_t crc = (uint16_t)~_crc16;
+                _pend[0] = (uint8_t)(crc & 0xff);
+                _pend[1] = (uint8_t)(crc >> 8);
+                _nPend = 2;
+            } else
+            if (_crcType == MemDevice::CRC_8) {
+                _pend[0] = _crc8;
+                _nPend = 1;
+            }
+            _crc16 = 0;
+            _crc8 = 0;
+        }
+        return ret;
+    }
+
+    const MemDevice::Geometry *_geom;
+    uint8_t *_mem;
+    int _state;
+    uint8_t _cmd[3];
+    uint8_t _crcType;
+    unsigned _addr;
+    uint16_t _crc16;
+    uint8_t _crc8;
+    uint8_t _pend[2];   /* CRC bytes pending to send */
+    int _nPend;
+    int _pendPos;
+    uint8_t _byte;
+    int _bit;
+};
+
+#endif /* __OWNG_TEST_SIM_MEMDEV__ */
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_PIO__
+#define __OWNG_TEST_SIM_PIO__
+
+#include "common.h"
+
+#define SIM_PIO_FIFO_DEPTH 4
+
+/**
+ * Pin connected to the emulated PIO state machine.
+ */
+class SimPioPin
+{
+public:
+    virtual ~SimPioPin() {}
+
+    /** Called on the pin's direction (1: out) or output value change */
+    virtual void update(int dir, int out, unsigned long cycle) = 0;
+
+    /** Read the pin's state */
+    virtual int read(unsigned long cycle) = 0;
+};
+
+/**
+ * RP2040 PIO state machine instruction level emulator.
+ *
+ * Emulated subset: single pin mapped to IN, SET and side-set (1-bit, not
+ * optional, pin values) base; JMP, IN, OUT, PUSH, PULL, MOV and SET
+ * instructions (no WAIT and IRQ); autopush and autopull. Each instruction
+ * takes 1 cycle plus its delay, a stalled instruction is repeated every
+ * cycle with its side-set asserted. Shift configuration defaults are the same
+ * as Pico SDK's default SM config (right shifts, no autopush/autopull).
+ */
+class SimPio
+{
+public:
+    SimPio(SimPioPin& pin, const uint16_t *prog, int len,
+        int wrapTarget, int wrap):
+        inShiftRight(true), autopush(false), pushThr(32),
+        outShiftRight(true), autopull(false), pullThr(32),
+        cycles(0), _pin(pin), _prog(prog), _len(len),
+        _wrapTarget(wrapTarget), _wrap(wrap), _dir(0), _out(1)
+    {
+        restart(0);
+        clearFifos();
+    }
+
+    /** Restart the SM at a given program address */
+    void restart(int pc)
+    {
+        _pc = pc;
+        _x = _y = 0;
+        _isr = _osr = 0;
+        _isrCnt = 0;
+        _osrCnt = 32;   /* OSR empty */
+        _delay = 0;
+        _exec = false;
+    }
+
+    void clearFifos() {
+        _txN = _rxN = 0;
+    }
+
+    bool put(uint32_t v)
+    {
+        if (_txN >= SIM_PIO_FIFO_DEPTH)
+            return false;
+        _tx[_txN++] = v;
+        return true;
+    }
+
+    bool get(uint32_t& v)
+    {
+        if (!_rxN)
+            return false;
+        v = _rx[0];
+        memmove(&_rx[0], &_rx[1], --_rxN * sizeof(_rx[0]));
+        return true;
+    }
+
+    bool txFull() const { return _txN >= SIM_PIO_FIFO_DEPTH; }
+    bool rxEmpty() const { return !_rxN; }
+
+    /** Execute single cycle */
+    void step()
+    {
+        if (_delay > 0) {
+            _delay--;
+        } else {
+            assert(_pc < _len);
+            uint16_t instr = (_exec ? _execInstr : _prog[_pc]);
+            bool fromExec = _exec;
+            _exec = false;
+
+            /* side-set is asserted even if the instruction stalls */
+            setPin(_dir, (instr >> 12) & 1);
+
+            int res = execute(instr);
+            if (res == STALL) {
+                /* repeat the instruction on the next cycle */
+                if (fromExec) {
+                    _exec = true;
+                    _execInstr = instr;
+                }
+            } else {
+                /* PC is not advanced by exec'ed instruction */
+                if (res == NEXT && !fromExec)
+                    _pc = (_pc == _wrap ? _wrapTarget : _pc + 1);
+
+                /* delay of OUT/MOV EXEC instruction is ignored */
+                _delay = (_exec ? 0 : (instr >> 8) & 0xf);
+            }
+        }
+        cycles++;
+    }
+
+    /* configuration */
+    bool inShiftRight;
+    bool autopush;
+    int pushThr;
+    bool outShiftRight;
+    bool autopull;
+    int pullThr;
+
+    /** Number of executed cycles */
+    unsigned long cycles;
+
+private:
+    enum { NEXT = 0, JUMPED, STALL };
+
+    void setPin(int dir, int out)
+    {
+        if (dir != _dir || out != _out) {
+            _dir = dir;
+            _out = out;
+            _pin.update(dir, out, cycles);
+        }
+    }
+
+    bool doPush(bool block)
+    {
+        if (_rxN >= SIM_PIO_FIFO_DEPTH)
+            return !block;
+        _rx[_rxN++] = _isr;
+        _isr = 0;
+        _isrCnt = 0;
+        return true;
+    }
+
+    bool doPull(bool block)
+    {
+        if (!_txN) {
+            if (block) return false;
+            _osr = _x;
+        } else {
+            _osr = _tx[0];
+            memmove(&_tx[0], &_tx[1], --_txN * sizeof(_tx[0]));
+        }
+        _osrCnt = 0;
+        return true;
+    }
+
+    void shiftIn(uint32_t data, int n)
+    {
+        uint32_t mask = (n >= 32 ? 0xffffffff : ((1UL << n) - 1));
+        data &= mask;
+        if (inShiftRight) {
+            _isr = (n >= 32 ? data : ((_isr >> n) | (data << (32 - n))));
+        } else {
+            _isr = (n >= 32 ? data : ((_isr << n) | data));
+        }
+        _isrCnt += n;
+        if (_isrCnt > 32) _isrCnt = 32;
+    }
+
+    uint32_t shiftOut(int n)
+    {
+        uint32_t data;
+        if (outShiftRight) {
+            data = (n >= 32 ? _osr : (_osr & ((1UL << n) - 1)));
+            _osr = (n >= 32 ? 0 : (_osr >> n));
+        } else {
+            data = (n >= 32 ? _osr : (_osr >> (32 - n)));
+            _osr = (n >= 32 ? 0 : (_osr << n));
+        }
+        _osrCnt += n;
+        if (_osrCnt > 32) _osrCnt = 32;
+        return data;
+    }
+
+    int execute(uint16_t instr)
+    {
+        int op = (instr >> 13) & 7;
+        int dst = (instr >> 5) & 7;
+        int n = instr & 0x1f;
+        if (!n) n = 32;
+
+        switch (op)
+        {
+        case 0: /* JMP */
+          {
+            bool cond;
+            switch (dst) {
+            case 0: cond = true; break;
+            case 1: cond = !_x; break;
+            case 2: cond = (_x-- != 0); break;
+            case 3: cond = !_y; break;
+            case 4: cond = (_y-- != 0); break;
+            case 5: cond = (_x != _y); break;
+            case 7: cond = (_osrCnt < pullThr); break;
+            default: assert(false); cond = false; break;
+            }
+            if (cond) {
+                _pc = instr & 0x1f;
+                return JUMPED;
+            }
+            return NEXT;
+          }
+
+        case 2: /* IN */
+          {
+            if (autopush && _isrCnt >= pushThr) {
+                if (!doPush(true))
+                    return STALL;
+            }
+            uint32_t data;
+            switch (dst) {
+            case 0: data = (uint32_t)_pin.read(cycles); break;
+            case 1: data = _x; break;
+            case 2: data = _y; break;
+            case 3: data = 0; break;
+            case 6: data = _isr; break;
+            case 7: data = _osr; break;
+            default: assert(false); data = 0; break;
+            }
+            shiftIn(data, n);
+            if (autopush && _isrCnt >= pushThr)
+                doPush(false);
+            return NEXT;
+          }
+
+        case 3: /* OUT */
+          {
+            if (autopull && _osrCnt >= pullThr) {
+                if (!doPull(true))
+                    return STALL;
+            }
+            uint32_t data = shiftOut(n);
+            switch (dst) {
+            case 0: setPin(_dir, data & 1); break;
+            case 1: _x = data; break;
+            case 2: _y = data; break;
+            case 3: break;
+            case 4: setPin(data & 1, _out); break;
+            case 5: _pc = data & 0x1f; return JUMPED;
+            case 6: _isr = data; _isrCnt = n; break;
+            case 7: _exec = true; _execInstr = (uint16_t)data; break;
+            }
+            return NEXT;
+          }
+
+        case 4: /* PUSH/PULL */
+          {
+            bool block = (instr >> 5) & 1;
+            bool ifcond = (instr >> 6) & 1;
+            if (!(instr & 0x80)) {
+                if (ifcond && _isrCnt < pushThr)
+                    return NEXT;
+                return (doPush(block) ? NEXT : STALL);
+            } else {
+                if (ifcond && _osrCnt < pullThr)
+                    return NEXT;
+                return (doPull(block) ? NEXT : STALL);
+            }
+          }
+
+        case 5: /* MOV */
+          {
+            uint32_t data;
+            switch (instr & 7) {
+            case 0: data = (uint32_t)_pin.read(cycles); break;
+            case 1: data = _x; break;
+            case 2: data = _y; break;
+            case 3: data = 0; break;
+            case 6: data = _isr; break;
+            case 7: data = _osr; break;
+            default: assert(false); data = 0; break;
+            }
+            switch ((instr >> 3) & 3) {
+            case 1: data = ~data; break;
+            case 2:
+              {
+                uint32_t r = 0;
+                for (int i = 0; i < 32; i++)
+                    if (data & (1UL << i)) r |= (1UL << (31 - i));
+                data = r;
+                break;
+              }
+            default: break;
+            }
+            switch (dst) {
+            case 0: setPin(_dir, data & 1); break;
+            case 1: _x = data; break;
+            case 2: _y = data; break;
+            case 4: _exec = true; _execInstr = (uint16_t)data; break;
+            case 5: _pc = data & 0x1f; return JUMPED;
+            case 6: _isr = data; _isrCnt = 0; break;
+            case 7: _osr = data; _osrCnt = 0; break;
+            default: assert(false); break;
+            }
+            return NEXT;
+          }
+
+        case 7: /* SET */
+            switch (dst) {
+            case 0: setPin(_dir, instr & 1); break;
+            case 1: _x = instr & 0x1f; break;
+            case 2: _y = instr & 0x1f; break;
+            case 4: setPin(instr & 1, _out); break;
+            default: assert(false); break;
+            }
+            return NEXT;
+
+        default:
+            /* WAIT, IRQ not supported */
+            assert(false);
+            return NEXT;
+        }
+    }
+
+    SimPioPin& _pin;
+    const uint16_t *_prog;
+    int _len;
+    int _wrapTarget;
+    int _wrap;
+
+    int _pc;
+    uint32_t _x, _y;
+    uint32_t _isr, _osr;
+    int _isrCnt, _osrCnt;
+    int _delay;
+    bool _exec;
+    uint16_t _execInstr;
+    int _dir, _out;
+
+    uint32_t _tx[SIM_PIO_FIFO_DEPTH];
+    int _txN;
+    uint32_t _rx[SIM_PIO_FIFO_DEPTH];
+    int _rxN;
+};
+
+#endif /* __OWNG_TEST_SIM_PIO__ */
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_TEST_SIM_SWITCH__
+#define __OWNG_TEST_SIM_SWITCH__
+
+#include "sim_bus.h"
+#include "drivers/DS2408.h"
+#include "drivers/DS2413.h"
+
+/**
+ * Emulated addressable switch (DS2408, DS2413).
+ *
+ * PIO inputs change with each sample taken (see @ref input()). Pins state
+ * is a wired-AND of the inputs and output latches (open drain outputs).
+ * Read samples are streamed bit-by-bit on read slots.
+ */
+class SimSwitch: public SimSlave
+{
+public:
+    SimSwitch(const OneWireNg::Id& id):
+        SimSlave(id), nSamples(0), errSample(-1),
+        _latch(0xff), _state(0), _cnt(0)
+    {}
+
+    /** Input state of k-th sample */
+    static uint8_t input(unsigned long k) {
+        return (uint8_t)(k * 37 + 11);
+    }
+
+    uint8_t getLatch() const {
+        return _latch;
+    }
+
+    void onReset() {
+        _state = 0;
+    }
+
+    int idleBit()
+    {
+        if (_state != ST_STREAM)
+            return 1;
+
+        if (!_bit)
+            _byte = nextByte();
+
+        int ret = (_byte >> _bit) & 1;
+        _bit = (_bit + 1) & 7;
+        return ret;
+    }
+
+    void onByte(uint8_t byte)
+    {
+        if (_state == 0) {
+            _cnt = 0;
+            _state = command(byte);
+        } else if (_state == ST_WRITE) {
+            _arg[_cnt++] = byte;
+            if (_cnt >= 2) {
+                _cnt = 0;
+                if ((uint8_t)~_arg[0] != _arg[1]) {
+                    _state = -1;
+                    return;
+                }
+                _latch = _arg[0];
+                sendByte(0xaa);
+                sendByte(status(pins()));
+            }
+        }
+    }
+
+    /** Number of taken samples */
+    unsigned long nSamples;
+    /** Sample to corrupt (-1: none) */
+    long errSample;
+
+protected:
+    enum {
+        ST_WRITE = 1,
+        ST_STREAM
+    };
+
+    /** Handle function command; returns the next state */
+    virtual int command(uint8_t cmd) = 0;
+
+    /** Next byte of the read stream */
+    virtual uint8_t nextByte() = 0;
+
+    /** PIO status byte */
+    virtual uint8_t status(uint8_t pins) const = 0;
+
+    /** Take a sample of PIO pins state */
+    uint8_t pins() {
+        return (uint8_t)(input(nSamples++) & _latch);
+    }
+
+    uint8_t corrupt(uint8_t b) const {
+        return ((long)nSamples - 1 == errSample ? (uint8_t)(b ^ 0x10) : b);
+    }
+
+    void startStream() {
+        _bit = 0;
+    }
+
+    uint8_t _latch;
+
+private:
+    int _state;
+    int _cnt;
+    uint8_t _arg[2];
+    uint8_t _byte;
+    int _bit;
+};
+
+class SimDS2408: public SimSwitch
+{
+public:
+    SimDS2408(const OneWireNg::Id& id): SimSwitch(id) {}
+
+protected:
+    int command(uint8_t cmd)
+    {
+        switch (cmd)
+        {
+        case DS2408::CMD_CHANNEL_READ:
+            _crc = OneWireNg::crc16(&cmd, 1);
+            _blk = 0;
+            startStream();
+            return ST_STREAM;
+
+        case DS2408::CMD_CHANNEL_WRITE:
+            return ST_WRITE;
+
+        case DS2408::CMD_RESET_ACTIVITY:
+            sendByte(0xaa);
+            return -1;
+
+        default:
+            return -1;
+        }
+    }
+
+    uint8_t nextByte()
+    {
+        if (_blk >= DS2408::CRC_BLOCK) {
+            /* inverted CRC-16 after each block */
+            uint16_t crc = (uint16_t)~_crc;
+            uint8_t ret = (_blk == DS2408::CRC_BLOCK ? crc & 0xff : crc >> 8);
+            if (++_blk >= DS2408::CRC_BLOCK + 2) {
+                _blk = 0;
+                _crc = 0;
+            }
+            return ret;
+        }
+
+        uint8_t smpl = pins();
+        _crc = OneWireNg::crc16(&smpl, 1, _crc);
+        _blk++;
+        return corrupt(smpl);
+    }
+
+    uint8_t status(uint8_t pins) const {
+        return pins;
+    }
+
+private:
+    uint16_t _crc;
+    size_t _blk;
+};
+
+class SimDS2413: public SimSwitch
+{
+public:
+    SimDS2413(const OneWireNg::Id& id): SimSwitch(id) {}
+
+protected:
+    int command(uint8_t cmd)
+    {
+        switch (cmd)
+        {
+        case DS2413::CMD_PIO_READ:
+            startStream();
+            return ST_STREAM;
+
+        case DS2413::CMD_PIO_WRITE:
+            return ST_WRITE;
+
+        default:
+            return -1;
+        }
+    }
+
+    uint8_t nextByte() {
+        return corrupt(status(pins()));
+    }
+
+    uint8_t status(uint8_t pins) const
+    {
+        /* PIOA pin, PIOA latch, PIOB pin, PIOB latch */
+        uint8_t st = (uint8_t)((pins & 1) | ((_latch & 1) << 1) |
+            ((pins & 2) << 1) | ((_latch & 2) << 2));
+        return (uint8_t)(st | ((~st & 0x0f) << 4));
+    }
+};
+
+#endif /* __OWNG_TEST_SIM_SWITCH__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2023 Piotr Stolarz
+ * Copyright (c) 2019-2023,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -11,6 +11,7 @@
  */
 
 #include "common.h"
+#include "sim_bus.h"
 
 #define MAX_TEST_SLAVES 20
 
@@ -279,6 +280,45 @@ public:
         TEST_SUCCESS();
     }
 
+    static void test_verify()
+    {
+        OneWireNg_Test ow;
+        size_t i, n = TAB_SZ(TEST1_IDS);
+
+        /* no devices */
+        assert(ow.verify(TEST1_IDS[0]) == EC_NO_DEVS);
+
+        /* all devices but the 1st one */
+        for (i = 1; i < n; i++)
+            ow.addSlave(TEST1_IDS[i]);
+
+        for (i = 0; i < n; i++)
+            assert(ow.verify(TEST1_IDS[i]) == (i ? EC_SUCCESS : EC_NO_DEVS));
+
+        /* id differing on the last bit */
+        Id id;
+        memcpy(&id, &TEST1_IDS[1], sizeof(Id));
+        id[7] ^= 0x80;
+        assert(ow.verify(id) == EC_NO_DEVS);
+
+        /* batch verification */
+        bool present[TAB_SZ(TEST1_IDS)];
+        assert(ow.verify(TEST1_IDS, n, present) == n - 1);
+        for (i = 0; i < n; i++)
+            assert(present[i] == (i != 0));
+
+        /* search-scan process is not affected by the verification */
+        size_t nfnd = 0;
+        ow.searchReset();
+        while (ow.search(id) == EC_MORE) {
+            assert(ow.verify(id) == EC_SUCCESS);
+            nfnd++;
+        }
+        assert(nfnd == n - 1);
+
+        TEST_SUCCESS();
+    }
+
     static void test_filter()
     {
         OneWireNg_Test ow;
@@ -417,6 +457,68 @@ public:
     }
 };
 
+/**
+ * Bus with bulk write/read primitives overridden (extended virtual interface).
+ */
+class BulkBus: public SimBus
+{
+public:
+    BulkBus(): nWrites(0), nReads(0), nWritten(0), nRead(0) {}
+
+    void writeBytes(const uint8_t *bytes, size_t len, bool power = false)
+    {
+        nWrites++;
+        nWritten += len;
+        OneWireNg::writeBytes(bytes, len, power);
+    }
+
+    void readBytes(uint8_t *bytes, size_t len)
+    {
+        nReads++;
+        nRead += len;
+        OneWireNg::readBytes(bytes, len);
+    }
+
+    int nWrites, nReads;
+    size_t nWritten, nRead;
+};
+
+class SimPlain: public SimSlave
+{
+public:
+    SimPlain(const OneWireNg::Id& id): SimSlave(id) {}
+
+    void onByte(uint8_t byte) {
+        (void)byte;
+    }
+};
+
+static void test_bulk()
+{
+    BulkBus bus;
+    SimPlain slave(TEST1_IDS[0]);
+    bus.attach(&slave);
+
+    /* ROM layer routines called via the generic interface */
+    OneWireNg& ow = bus;
+    OneWireNg::Id id;
+
+    assert(ow.readSingleId(id) == OneWireNg::EC_SUCCESS);
+    assert(!memcmp(id, TEST1_IDS[0], sizeof(id)));
+    assert(bus.nReads == 1 && bus.nRead == sizeof(id));
+
+    assert(ow.addressSingle(id) == OneWireNg::EC_SUCCESS);
+    assert(bus.nWrites == 1 && bus.nWritten == sizeof(id));
+
+    /* id sent in a single bulk write */
+    unsigned long nBits = bus.nBits;
+    assert(ow.overdriveSingle(id) == OneWireNg::EC_SUCCESS);
+    ow.setOverdrive(false);
+    assert(bus.nWrites == 2 && bus.nBits - nBits == 8 + 64);
+
+    TEST_SUCCESS();
+}
+
 int main(void)
 {
     OneWireNg_Test::test_crc8();
@@ -424,8 +526,10 @@ int main(void)
     OneWireNg_Test::test_checkInvCrc16();
     OneWireNg_Test::test_getLSB();
     OneWireNg_Test::test_search();
+    OneWireNg_Test::test_verify();
     OneWireNg_Test::test_filter();
     OneWireNg_Test::test_filteredSearch();
+    test_bulk();
 
     return 0;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019,2021 Piotr Stolarz
+ * Copyright (c) 2019,2021,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -11,6 +11,7 @@
  */
 
 #include "common.h"
+#include "sim_gpio.h"
 
 class OneWireNg_BitBang_Test: OneWireNg_BitBang
 {
@@ -39,7 +40,44 @@ private:
 #endif
 };
 
+static void test_resetTiming()
+{
+    SimGpioBus bus;
+    OneWireNg_BitBang::PresenceTiming tm;
+
+    /* no devices */
+    unsigned long start = simUs;
+    assert(bus.reset(tm) == OneWireNg::EC_NO_DEVS);
+    assert(!tm.start && !tm.length);
+    assert(simUs - start == 480 + 480);
+
+    /* presence pulse; measured with 2 usecs step */
+    bus.present = true;
+    start = simUs;
+    assert(bus.reset(tm) == OneWireNg::EC_SUCCESS);
+    assert(tm.start >= 30 && tm.start < 30 + 2);
+    assert(tm.length > 120 - 2 && tm.length <= 120 + 2);
+    assert(simUs - start == 480 + 480);
+
+    /* bus held low */
+    bus.shorted = true;
+    start = simUs;
+    assert(bus.reset(tm) == OneWireNg::EC_BUS_ERROR);
+    assert(tm.start && !tm.length);
+    assert(simUs - start == 480 + 480);
+
+    /* the same result as of the ordinary reset */
+    bus.shorted = false;
+    assert(bus.reset() == OneWireNg::EC_SUCCESS);
+    bus.present = false;
+    assert(bus.reset() == OneWireNg::EC_NO_DEVS);
+
+    TEST_SUCCESS();
+}
+
 int main(void)
 {
+    test_resetTiming();
+
     return 0;
 }
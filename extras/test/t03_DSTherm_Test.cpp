@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021,2022,2024 Piotr Stolarz
+ * Copyright (c) 2021,2022,2024,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -12,6 +12,11 @@
 
 #include "common.h"
 #include "drivers/DSTherm.h"
+#include "platform/Platform_New.h"
+#include "platform/Platform_Delay.h"
+#include "utils/Placeholder.h"
+#include "utils/ReadingsQueue.h"
+#include "sim_dstherm.h"
 
 class DSTherm_Test: OneWireNg
 {
@@ -198,6 +203,402 @@ public:
         TEST_SUCCESS();
     }
 
+    static void test_alarmPolling()
+    {
+        SimBus bus;
+        DSTherm dsth(bus);
+        ALLOC_ALIGNED uint8_t buf[sizeof(DSTherm::Scratchpad)];
+        DSTherm::Scratchpad *scrpd =
+            reinterpret_cast<DSTherm::Scratchpad*>(&buf[0]);
+
+        OneWireNg::Id id[4];
+        setId(id[0], DSTherm::DS18B20, 1);
+        setId(id[1], DSTherm::DS18B20, 2);
+        setId(id[2], DSTherm::DS1822, 3);
+        setId(id[3], DSTherm::DS18S20, 4);
+
+        SimDSTherm s0(id[0], 320);  /* 20 C */
+        SimDSTherm s1(id[1], 408);  /* 25.5 C */
+        SimDSTherm s2(id[2], -52);  /* -3.25 C */
+        SimDSTherm s3(id[3], 480);  /* 30 C */
+        SimDSTherm *sims[] = { &s0, &s1, &s2, &s3 };
+
+        for (size_t i = 0; i < TAB_SZ(sims); i++)
+            bus.attach(sims[i]);
+
+        /* arm alarm windows */
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        for (size_t i = 0; i < TAB_SZ(id); i++) {
+            assert(dsth.readScratchpad(id[i], scrpd) == OneWireNg::EC_SUCCESS);
+            assert(dsth.setAlarmWindow(*scrpd) == OneWireNg::EC_SUCCESS);
+        }
+        assert(s0.getTh() == 21 && s0.getTl() == 19);
+        assert(s1.getTh() == 26 && s1.getTl() == 24);
+        assert(s2.getTh() == -3 && s2.getTl() == -5);
+        assert(s3.getTh() == 31 && s3.getTl() == 29);
+
+        /* empty window rejected */
+        assert(dsth.setAlarmWindow(*scrpd, 0) == OneWireNg::EC_UNSUPPORED);
+        assert(dsth.readScratchpadAlarm(scrpd, -1) ==
+            OneWireNg::EC_UNSUPPORED);
+        assert(s3.getTh() == 31 && s3.getTl() == 29);
+
+        /* no changes - no scratchpads read */
+        int nReads = s0.nReads + s1.nReads + s2.nReads + s3.nReads;
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        bus.searchReset();
+        assert(dsth.readScratchpadAlarm(scrpd) == OneWireNg::EC_NO_DEVS);
+
+        /* changes within the windows */
+        s0.setTemp(328);    /* 20.5 C */
+        s2.setTemp(-63);    /* -3.9375 C */
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        bus.searchReset();
+        assert(dsth.readScratchpadAlarm(scrpd) == OneWireNg::EC_NO_DEVS);
+        assert(nReads == s0.nReads + s1.nReads + s2.nReads + s3.nReads);
+
+        /* changes outside the windows */
+        s1.setTemp(432);    /* 27 C */
+        s2.setTemp(-88);    /* -5.5 C */
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        bus.searchReset();
+
+        int n = 0;
+        while (dsth.readScratchpadAlarm(scrpd) == OneWireNg::EC_MORE) {
+            if (!memcmp(scrpd->getId(), id[1], sizeof(OneWireNg::Id))) {
+                assert(scrpd->getTemp() == 27000);
+            } else {
+                assert(!memcmp(scrpd->getId(), id[2], sizeof(OneWireNg::Id)));
+                assert(scrpd->getTemp() == -5500);
+            }
+            n++;
+        }
+        assert(n == 2);
+        assert(nReads + 2 == s0.nReads + s1.nReads + s2.nReads + s3.nReads);
+
+        /* windows re-armed */
+        assert(s1.getTh() == 28 && s1.getTl() == 26);
+        assert(s2.getTh() == -5 && s2.getTl() == -7);
+        assert(s0.getTh() == 21 && s0.getTl() == 19);
+
+        /* alarm triggers are not stored in EEPROM */
+        assert(!s1.nCopies && !s2.nCopies);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_readTempAll()
+    {
+        SimBus bus;
+        DSTherm dsth(bus);
+        ReadingsQueue<4> queue;
+        DSTherm::Reading rd;
+        size_t n;
+
+        OneWireNg::Id id[5];
+        SimDSTherm *sims[TAB_SZ(id)];
+        for (size_t i = 0; i < TAB_SZ(id); i++) {
+            setId(id[i], (i == 3 ? DSTherm::DS18S20 : DSTherm::DS18B20),
+                (uint8_t)(i + 1));
+            sims[i] = new SimDSTherm(id[i], 320 + 8 * (long)i);
+            bus.attach(sims[i]);
+        }
+
+        /* the last reading doesn't fit into the queue */
+        unsigned long start = timeMs();
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        assert(dsth.readTempAll(queue, false, &n) == OneWireNg::EC_FULL);
+        assert(n == 4 && queue.size() == 4 && queue.getDropped() == 1);
+
+        for (size_t i = 0; i < n; i++) {
+            assert(queue.pop(rd));
+            size_t j = 0;
+            while (memcmp(rd.id, id[j], sizeof(OneWireNg::Id))) j++;
+
+            assert(rd.status == OneWireNg::EC_SUCCESS);
+            /* DS18S20 reading 16 scaled as well */
+            assert(rd.temp == 320 + 8 * (int)j);
+            assert((long)(rd.time - (uint32_t)start) >= 0);
+        }
+        assert(!queue.pop(rd));
+
+        /* alarm state set for a single sensor only */
+        assert(dsth.writeScratchpadAll(30, 10, DSTherm::RES_12_BIT) ==
+            OneWireNg::EC_SUCCESS);
+        sims[2]->setTemp(16 * 100);
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        assert(dsth.readTempAll(queue, true, &n) == OneWireNg::EC_SUCCESS);
+        assert(n == 1 && queue.pop(rd) && !queue.pop(rd));
+        assert(!memcmp(rd.id, id[2], sizeof(OneWireNg::Id)) &&
+            rd.temp == 16 * 100);
+
+        for (size_t i = 0; i < TAB_SZ(id); i++)
+            delete sims[i];
+
+        TEST_SUCCESS();
+    }
+
+    static void test_cacheConvTime()
+    {
+        SimBus bus;
+        DSTherm::Cache::Entry entries[3];
+        DSTherm::Cache cache(entries, TAB_SZ(entries));
+        DSTherm dsth(bus, &cache);
+        Placeholder<DSTherm::Scratchpad> scrpd;
+
+        OneWireNg::Id id[4];
+        setId(id[0], DSTherm::DS18B20, 1);
+        setId(id[1], DSTherm::DS18B20, 2);
+        setId(id[2], DSTherm::DS1822, 3);
+        setId(id[3], DSTherm::DS18S20, 4);
+
+        SimDSTherm s0(id[0]), s1(id[1]), s2(id[2]), s3(id[3]);
+        bus.attach(&s0);
+        bus.attach(&s1);
+        bus.attach(&s2);
+
+        /* nothing cached yet */
+        assert(cache.getConvTime(&id[0], DSTherm::MAX_CONV_TIME) ==
+            DSTherm::MAX_CONV_TIME);
+        assert(cache.getConvTime(NULL, DSTherm::MAX_CONV_TIME) ==
+            DSTherm::MAX_CONV_TIME);
+
+        /* resolution learned from write; cache not complete */
+        assert(dsth.writeScratchpadAll(0, 0, DSTherm::RES_9_BIT) ==
+            OneWireNg::EC_SUCCESS);
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(cache.size() == 1 && !cache.isComplete());
+        assert(cache.getConvTime(&id[0], DSTherm::MAX_CONV_TIME) == 94);
+        assert(cache.getConvTime(&id[1], DSTherm::MAX_CONV_TIME) ==
+            DSTherm::MAX_CONV_TIME);
+        assert(cache.getConvTime(NULL, DSTherm::MAX_CONV_TIME) ==
+            DSTherm::MAX_CONV_TIME);
+
+        /* complete cache */
+        assert(dsth.fillCache() == OneWireNg::EC_SUCCESS);
+        assert(cache.size() == 3 && cache.isComplete());
+        assert(cache.getConvTime(NULL, DSTherm::MAX_CONV_TIME) == 94);
+
+        /* resolution learned from scratchpad write */
+        scrpd->setResolution(DSTherm::RES_11_BIT);
+        assert(scrpd->writeScratchpad() == OneWireNg::EC_SUCCESS);
+        assert(cache.getConvTime(&id[0], DSTherm::MAX_CONV_TIME) == 375);
+        assert(cache.getConvTime(&id[1], DSTherm::MAX_CONV_TIME) == 94);
+        assert(cache.getConvTime(NULL, DSTherm::MAX_CONV_TIME) == 375);
+
+        /* max time respected */
+        assert(cache.getConvTime(NULL, 100) == 100);
+
+        /* all sensors addressed */
+        assert(dsth.writeScratchpadAll(0, 0, DSTherm::RES_10_BIT) ==
+            OneWireNg::EC_SUCCESS);
+        assert(cache.getConvTime(NULL, DSTherm::MAX_CONV_TIME) == 188);
+
+        /* new sensor appeared; DS18S20 conversion time is constant */
+        bus.attach(&s3);
+        assert(dsth.readScratchpad(id[3], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(cache.getConvTime(&id[3], DSTherm::MAX_CONV_TIME) ==
+            DSTherm::MAX_CONV_TIME);
+        assert(cache.size() == 3 && !cache.isComplete());
+        assert(cache.getConvTime(NULL, DSTherm::MAX_CONV_TIME) ==
+            DSTherm::MAX_CONV_TIME);
+
+        /* cache overflow */
+        assert(dsth.fillCache() == OneWireNg::EC_SUCCESS);
+        assert(cache.size() == 3 && !cache.isComplete());
+
+        TEST_SUCCESS();
+    }
+
+    static void test_cacheLearnConvTime()
+    {
+        SimBus bus;
+        DSTherm::Cache::Entry entries[2];
+        DSTherm::Cache cache(entries, TAB_SZ(entries));
+        DSTherm dsth(bus, &cache);
+
+        OneWireNg::Id id[2];
+        setId(id[0], DSTherm::DS18B20, 1);
+        setId(id[1], DSTherm::DS18B20, 2);
+
+        /* 20 ms conversion time for 10-bits resolution */
+        SimDSTherm s0(id[0], 0, 10), s1(id[1], 0, 10);
+        bus.attach(&s0);
+        bus.attach(&s1);
+
+        assert(dsth.writeScratchpadAll(0, 0, DSTherm::RES_10_BIT) ==
+            OneWireNg::EC_SUCCESS);
+        assert(dsth.fillCache() == OneWireNg::EC_SUCCESS);
+        assert(!cache.getPredConvTime(&id[0]) && !cache.getPredConvTime(NULL));
+
+        /* initial conversion - full bus scan */
+        unsigned long nBits = bus.nBits;
+        assert(dsth.convertTemp(id[0]) == OneWireNg::EC_SUCCESS);
+        unsigned long scanBits = bus.nBits - nBits;
+
+        int predTime = cache.getPredConvTime(&id[0]);
+        assert(predTime > 0 && predTime <= s0.convTime());
+
+        /* learned conversion time - narrow bus scan */
+        for (int i = 0; i < 4; i++) {
+            nBits = bus.nBits;
+            assert(dsth.convertTemp(id[0]) == OneWireNg::EC_SUCCESS);
+            assert(s0.idleBit());
+        }
+        assert(bus.nBits - nBits < scanBits);
+        assert(cache.getPredConvTime(&id[0]) > 0 &&
+            cache.getPredConvTime(&id[0]) <= s0.convTime());
+        assert(!cache.getPredConvTime(&id[1]));
+
+        /* all sensors conversion time learned separately */
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        assert(s0.idleBit() && s1.idleBit());
+        assert(cache.getPredConvTime(NULL) > 0);
+
+        /* resolution change invalidates learned times */
+        assert(dsth.writeScratchpad(id[0], 0, 0, DSTherm::RES_9_BIT) ==
+            OneWireNg::EC_SUCCESS);
+        assert(!cache.getPredConvTime(&id[0]) && !cache.getPredConvTime(NULL));
+
+        TEST_SUCCESS();
+    }
+
+    static void test_cacheScratchpad()
+    {
+        SimBus bus;
+        DSTherm::Cache::Entry entries[2];
+        DSTherm::Cache cache(entries, TAB_SZ(entries));
+        DSTherm dsth(bus, &cache);
+        Placeholder<DSTherm::Scratchpad> scrpd;
+
+        OneWireNg::Id id[2];
+        setId(id[0], DSTherm::DS18B20, 1);
+        setId(id[1], DSTherm::DS18B20, 2);
+
+        SimDSTherm s0(id[0], 320), s1(id[1], 400);
+        bus.attach(&s0);
+        bus.attach(&s1);
+
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+
+        /* TTL not configured */
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s0.nReads == 2);
+
+        cache.setTtl(1000);
+
+        /* read-through */
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        unsigned long nBits = bus.nBits;
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s0.nReads == 3 && bus.nBits == nBits);
+        assert(scrpd->getTemp() == 20000 &&
+            !memcmp(scrpd->getId(), id[0], sizeof(OneWireNg::Id)));
+
+        assert(dsth.readScratchpad(id[1], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(dsth.readScratchpad(id[1], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s1.nReads == 1 && scrpd->getTemp() == 25000);
+
+        /* conversion invalidates addressed sensor only */
+        s0.setTemp(336);
+        assert(dsth.convertTemp(id[0]) == OneWireNg::EC_SUCCESS);
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s0.nReads == 4 && scrpd->getTemp() == 21000);
+        assert(dsth.readScratchpad(id[1], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s1.nReads == 1);
+
+        /* scratchpad write invalidates */
+        scrpd->setThl(10, -10);
+        assert(scrpd->writeScratchpad() == OneWireNg::EC_SUCCESS);
+        assert(dsth.readScratchpad(id[1], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s1.nReads == 2 && scrpd->getTh() == 10);
+
+        /* all sensors conversion invalidates all */
+        assert(dsth.convertTempAll() == OneWireNg::EC_SUCCESS);
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(dsth.readScratchpad(id[1], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s0.nReads == 5 && s1.nReads == 3);
+
+        /* TTL expiration */
+        cache.setTtl(10);
+        delayMs(20);
+        assert(dsth.readScratchpad(id[0], scrpd) == OneWireNg::EC_SUCCESS);
+        assert(s0.nReads == 6);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_syncConfig()
+    {
+        SimBus bus;
+        DSTherm dsth(bus);
+        size_t updated;
+
+        OneWireNg::Id id[4];
+        setId(id[0], DSTherm::DS18B20, 1);
+        setId(id[1], DSTherm::DS18B20, 2);
+        setId(id[2], DSTherm::DS18S20, 3);
+        setId(id[3], DSTherm::DS1825, 4);
+
+        SimDSTherm s0(id[0]), s1(id[1]), s2(id[2]), s3(id[3]);
+        SimDSTherm *sims[] = { &s0, &s1, &s2, &s3 };
+
+        bus.attach(&s0);
+        bus.attach(&s1);
+        bus.attach(&s2);
+
+        /* all sensors differ - configuration sent to all at once */
+        unsigned long nBits = bus.nBits;
+        assert(dsth.syncConfig(50, -10, DSTherm::RES_10_BIT, false,
+            &updated) == OneWireNg::EC_SUCCESS && updated == 3);
+        unsigned long syncBits = bus.nBits - nBits;
+
+        for (int i = 0; i < 3; i++) {
+            assert(sims[i]->nWrites == 1 && sims[i]->nCopies == 1);
+            assert(sims[i]->getTh() == 50 && sims[i]->getTl() == -10);
+            assert((int8_t)sims[i]->getEeprom()[0] == 50);
+        }
+        assert(s0.resSteps() == 1 && s1.resSteps() == 1);
+
+        /* nothing changed - no writes */
+        nBits = bus.nBits;
+        assert(dsth.syncConfig(50, -10, DSTherm::RES_10_BIT, false,
+            &updated) == OneWireNg::EC_SUCCESS && !updated);
+        assert(bus.nBits - nBits < syncBits);
+        for (int i = 0; i < 3; i++)
+            assert(sims[i]->nWrites == 1 && sims[i]->nCopies == 1);
+
+        /* scratchpad differs, EEPROM doesn't - no writes */
+        assert(dsth.writeScratchpad(id[1], 50, -10, DSTherm::RES_12_BIT) ==
+            OneWireNg::EC_SUCCESS);
+        assert(dsth.syncConfig(50, -10, DSTherm::RES_10_BIT, false,
+            &updated) == OneWireNg::EC_SUCCESS && !updated);
+        assert(s1.nWrites == 2 && s1.nCopies == 1 && s1.resSteps() == 1);
+
+        /* single sensor differs */
+        assert(dsth.writeScratchpad(id[1], 50, -10, DSTherm::RES_12_BIT) ==
+            OneWireNg::EC_SUCCESS);
+        assert(dsth.copyScratchpad(id[1]) == OneWireNg::EC_SUCCESS);
+        assert(dsth.syncConfig(50, -10, DSTherm::RES_10_BIT, false,
+            &updated) == OneWireNg::EC_SUCCESS && updated == 1);
+        assert(s0.nWrites == 1 && s0.nCopies == 1);
+        assert(s1.nWrites == 4 && s1.nCopies == 3 && s1.resSteps() == 1);
+        assert(s2.nWrites == 1 && s2.nCopies == 1);
+
+        /* DS1825 address retained */
+        bus.attach(&s3);
+        assert(dsth.syncConfig(20, 10, DSTherm::RES_9_BIT, false,
+            &updated) == OneWireNg::EC_SUCCESS && updated == 4);
+        for (int i = 0; i < 4; i++) {
+            assert(sims[i]->getTh() == 20 && sims[i]->getTl() == 10);
+            assert(sims[i]->nCopies == (i == 1 ? 4 : (i == 3 ? 1 : 2)));
+        }
+        assert(s0.resSteps() == 0 && s3.resSteps() == 0);
+
+        TEST_SUCCESS();
+    }
+
 private:
     DSTherm_Test() {}
 
@@ -217,6 +618,12 @@ int main(void)
     DSTherm_Test::test_conversionTime();
     DSTherm_Test::test_scratchpadTemp();
     DSTherm_Test::test_scratchpadConfig();
+    DSTherm_Test::test_alarmPolling();
+    DSTherm_Test::test_readTempAll();
+    DSTherm_Test::test_cacheConvTime();
+    DSTherm_Test::test_cacheLearnConvTime();
+    DSTherm_Test::test_cacheScratchpad();
+    DSTherm_Test::test_syncConfig();
 
     return 0;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021,2022,2024 Piotr Stolarz
+ * Copyright (c) 2021,2022,2024,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -12,6 +12,9 @@
 
 #include "common.h"
 #include "drivers/MAX31850.h"
+#include "utils/Placeholder.h"
+#include "utils/ReadingsQueue.h"
+#include "sim_dstherm.h"
 
 class MAX31850_Test: OneWireNg
 {
@@ -107,6 +110,61 @@ public:
         TEST_SUCCESS();
     }
 
+    static void test_cacheScratchpad()
+    {
+        SimBus bus;
+        MAX31850::Cache::Entry entries[1];
+        MAX31850::Cache cache(entries, TAB_SZ(entries), 1000);
+        MAX31850 max31850(bus, &cache);
+        Placeholder<MAX31850::Scratchpad> scrpd;
+
+        OneWireNg::Id id = { MAX31850::FAMILY_CODE, 1 };
+        id[7] = OneWireNg::crc8(id, sizeof(id) - 1);
+
+        SimDSTherm sim(id, 400);
+        bus.attach(&sim);
+
+        assert(max31850.convertTemp(id) == OneWireNg::EC_SUCCESS);
+        assert(max31850.readScratchpad(id, scrpd) == OneWireNg::EC_SUCCESS);
+        assert(max31850.readScratchpad(id, scrpd) == OneWireNg::EC_SUCCESS);
+        assert(sim.nReads == 1 && scrpd->getTemp() == 25000);
+
+        assert(max31850.convertTemp(id) == OneWireNg::EC_SUCCESS);
+        assert(max31850.readScratchpad(id, scrpd) == OneWireNg::EC_SUCCESS);
+        assert(sim.nReads == 2);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_readTempAll()
+    {
+        SimBus bus;
+        MAX31850 max31850(bus);
+        ReadingsQueue<4> queue;
+        DSTherm::Reading rd;
+        size_t n;
+
+        OneWireNg::Id id = { MAX31850::FAMILY_CODE, 1 };
+        id[7] = OneWireNg::crc8(id, sizeof(id) - 1);
+        OneWireNg::Id thId = { DSTherm::DS18B20, 2 };
+        thId[7] = OneWireNg::crc8(thId, sizeof(thId) - 1);
+
+        SimDSTherm sim(id, 400), therm(thId, 320);
+        bus.attach(&sim);
+        bus.attach(&therm);
+
+        assert(max31850.convertTemp(id) == OneWireNg::EC_SUCCESS);
+
+        /* thermocouples only */
+        assert(max31850.readTempAll(queue, false, &n) ==
+            OneWireNg::EC_SUCCESS);
+        assert(n == 1 && queue.pop(rd) && !queue.pop(rd));
+        assert(!memcmp(rd.id, id, sizeof(OneWireNg::Id)));
+        assert(rd.status == OneWireNg::EC_SUCCESS && rd.temp == 400);
+
+        TEST_SUCCESS();
+    }
+
 private:
     MAX31850_Test() {}
 
@@ -124,6 +182,8 @@ int main(void)
 {
     MAX31850_Test::test_scratchpadTemp();
     MAX31850_Test::test_scratchpadTempInternal();
+    MAX31850_Test::test_cacheScratchpad();
+    MAX31850_Test::test_readTempAll();
 
     return 0;
 }
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "OneWireNg_BitBangAsync.h"
+#include "sim_dstherm.h"
+
+/*
+ * Simulated timer. Time is advanced by the test loop driving the engine.
+ */
+class SimTimer: public OneWireNg_BitBangAsync::Timer
+{
+public:
+    SimTimer(): now(0), expire(0), armed(false), nStarts(0) {}
+
+    void start(unsigned us)
+    {
+        expire = now + us;
+        armed = true;
+        nStarts++;
+    }
+
+    /** current simulated time (usecs) */
+    unsigned long now;
+    unsigned long expire;
+    bool armed;
+    unsigned long nStarts;
+};
+
+/*
+ * Bit-banging driver with GPIO connected to emulated bus. Slots are decoded
+ * on the bus release basing on the low pulse duration.
+ */
+class OneWireNg_BitBangAsync_Test: OneWireNg_BitBang
+{
+public:
+    static void test_requests()
+    {
+        SimTimer timer;
+        OneWireNg_BitBangAsync_Test bb(timer);
+        OneWireNg_BitBangAsync async(bb, timer);
+
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 0x5a);
+        SimDSTherm therm(id, 320);
+        bb.bus.attach(&therm);
+
+        /* read ROM */
+        uint8_t readRom[1 + sizeof(OneWireNg::Id)];
+        memset(readRom, 0xff, sizeof(readRom));
+        readRom[0] = OneWireNg::CMD_READ_ROM;
+
+        /* convert T for all sensors */
+        uint8_t convert[2] = { OneWireNg::CMD_SKIP_ROM, DSTherm::CMD_CONVERT_T };
+
+        OneWireNg_BitBangAsync::Request req1, req2;
+        int ncb = 0;
+        req1.set(readRom, sizeof(readRom), true, false, callback, &ncb);
+        req2.set(convert, sizeof(convert), true, false, callback, &ncb);
+
+        assert(async.isIdle());
+        assert(async.submit(req1) == OneWireNg::EC_SUCCESS);
+        assert(async.submit(req2) == OneWireNg::EC_SUCCESS);
+        assert(async.submit(req1) == OneWireNg::EC_FULL);
+        assert(!req1.isDone() && !req2.isDone() && !async.isIdle());
+
+        unsigned long busyUs = run(async, timer);
+
+        assert(ncb == 2 && req1.isDone() && req2.isDone() && async.isIdle());
+        assert(req1.getStatus() == OneWireNg::EC_SUCCESS &&
+            req2.getStatus() == OneWireNg::EC_SUCCESS);
+        assert(!memcmp(&readRom[1], id, sizeof(id)));
+        assert(therm.nConv == 1);
+
+        /*
+         * 2 resets and 11 bytes transmitted in standard mode; bus time
+         * of a slot is 70 usecs.
+         */
+        assert(bb.bus.nResets == 2 && bb.bus.nBits == 11 * 8);
+        assert(timer.now >= 2 * 960 && timer.now <= 2 * 960 + 11 * 8 * 70);
+
+        /* CPU is busy only for short parts of read slots */
+        assert(busyUs * 4 < timer.now);
+
+        /* no devices */
+        bb.bus.detachAll();
+        req1.set(readRom, sizeof(readRom), true);
+        assert(async.submit(req1) == OneWireNg::EC_SUCCESS);
+        run(async, timer);
+        assert(req1.isDone() && req1.getStatus() == OneWireNg::EC_NO_DEVS);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_power()
+    {
+        SimTimer timer;
+        OneWireNg_BitBangAsync_Test bb(timer);
+        OneWireNg_BitBangAsync async(bb, timer);
+
+        uint8_t bytes[2] = { 0xcc, 0x44 };
+        OneWireNg_BitBangAsync::Request req;
+
+        /* bus powered after the last bit */
+        req.set(bytes, sizeof(bytes), false, true);
+        assert(async.submit(req) == OneWireNg::EC_SUCCESS);
+        run(async, timer);
+        assert(req.isDone() && bb._pwre);
+
+        /* and de-powered on the next request */
+        req.set(bytes, 0, true);
+        assert(async.submit(req) == OneWireNg::EC_SUCCESS);
+        assert(!bb._pwre);
+        run(async, timer);
+        assert(req.isDone());
+
+        TEST_SUCCESS();
+    }
+
+    static void test_chain()
+    {
+        SimTimer timer;
+        OneWireNg_BitBangAsync_Test bb(timer);
+        OneWireNg_BitBangAsync async(bb, timer);
+
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 0x5a);
+        SimDSTherm therm(id, 320);
+        bb.bus.attach(&therm);
+
+        uint8_t convert[2] = { OneWireNg::CMD_SKIP_ROM, DSTherm::CMD_CONVERT_T };
+        uint8_t readPow[3] = {
+            OneWireNg::CMD_SKIP_ROM, DSTherm::CMD_READ_POW_SUPPLY, 0xff };
+
+        /* the next request submitted by the completion callback */
+        Chain chain;
+        chain.async = &async;
+        chain.req2.set(readPow, sizeof(readPow), true);
+        chain.req1.set(convert, sizeof(convert), true, false,
+            submitNext, &chain);
+
+        assert(async.submit(chain.req1) == OneWireNg::EC_SUCCESS);
+        run(async, timer);
+
+        assert(chain.req1.isDone() && chain.req2.isDone() && async.isIdle());
+        assert(chain.req2.getStatus() == OneWireNg::EC_SUCCESS);
+        /* the chained reset pulse not cut short */
+        assert(bb.bus.nResets == 2 && bb.bus.nBits == 5 * 8);
+        assert(therm.nConv == 1);
+
+        TEST_SUCCESS();
+    }
+
+private:
+    OneWireNg_BitBangAsync_Test(SimTimer& timer):
+        _timer(timer), _low(false), _lowStart(0), _smpl(1) {}
+
+    typedef struct {
+        OneWireNg_BitBangAsync *async;
+        OneWireNg_BitBangAsync::Request req1, req2;
+    } Chain;
+
+    static void submitNext(OneWireNg_BitBangAsync::Request& req, void *arg)
+    {
+        (void)req;
+        Chain *chain = (Chain*)arg;
+        assert(chain->async->submit(chain->req2) == OneWireNg::EC_SUCCESS);
+    }
+
+    static void callback(OneWireNg_BitBangAsync::Request& req, void *arg)
+    {
+        assert(req.isDone());
+        (*(int*)arg)++;
+    }
+
+    /*
+     * Drive the engine with the simulated timer until idle. Returns time
+     * the CPU has been busy-waiting inside the engine steps.
+     */
+    static unsigned long run(OneWireNg_BitBangAsync& async, SimTimer& timer)
+    {
+        unsigned long busyUs = 0;
+
+        while (timer.armed) {
+            timer.armed = false;
+            timer.now = timer.expire;
+
+            unsigned long n = timer.nStarts;
+            async.onTimer();
+
+            /* busy-wait of write-1 slots (low + sampling time) */
+            if (timer.nStarts > n && timer.expire - timer.now == 56)
+                busyUs += 5 + 8;
+        }
+        return busyUs;
+    }
+
+    int readDtaGpioIn() {
+        return (_low ? 0 : _smpl);
+    }
+
+    void setDtaGpioAsInput()
+    {
+        if (!_low)
+            return;
+        _low = false;
+
+        unsigned long dur = _timer.now - _lowStart;
+        if (dur >= 480) {
+            /* reset pulse; presence sampled till the next low */
+            _smpl = (bus.reset() == OneWireNg::EC_SUCCESS ? 0 : 1);
+        } else if (dur >= 60) {
+            /* write-0 */
+            bus.touchBit(0, false);
+            _smpl = 1;
+        } else {
+            /* write-1 / read */
+            _smpl = bus.touchBit(1, false);
+        }
+    }
+
+    void setBusLow()
+    {
+        if (!_low) {
+            _low = true;
+            _lowStart = _timer.now;
+        }
+    }
+
+#if CONFIG_PWR_CTRL_ENABLED
+    void writeGpioOut(int state, GpioType gpio) {
+        (void)state;
+        (void)gpio;
+    }
+
+    void setGpioAsOutput(int state, GpioType gpio) {
+        if (gpio == GPIO_DTA && !state) setBusLow();
+    }
+#else
+    void writeGpioOut(int state) {
+        (void)state;
+    }
+
+    void setGpioAsOutput(int state) {
+        if (!state) setBusLow();
+    }
+#endif
+
+    SimBus bus;
+    SimTimer& _timer;
+    bool _low;
+    unsigned long _lowStart;
+    int _smpl;
+};
+
+int main(void)
+{
+    OneWireNg_BitBangAsync_Test::test_requests();
+    OneWireNg_BitBangAsync_Test::test_power();
+    OneWireNg_BitBangAsync_Test::test_chain();
+
+    return 0;
+}
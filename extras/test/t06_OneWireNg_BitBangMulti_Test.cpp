@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include <unistd.h>
+#include "common.h"
+#include "OneWireNg_BitBangMulti.h"
+#include "sim_dstherm.h"
+
+#define BUSES_NUM 8
+
+/* reset vs touch slot low pulse duration threshold (usecs) */
+#define RESET_THRSH 240
+
+/* standard mode bus time of reset and touch slot (usecs) */
+#define RESET_TIME 960
+#define SLOT_TIME 70
+
+/*
+ * Simulated clock (usecs). In the test environment the bit-banging delays
+ * are performed by usleep(3), which is overridden here to advance the clock
+ * instead of sleeping. This makes the slots decoding independent of the
+ * host's scheduling jitter and allows to measure the bus time.
+ */
+static unsigned long simUs;
+
+extern "C" int usleep(useconds_t us)
+{
+    simUs += us;
+    return 0;
+}
+
+/*
+ * Lockstep bit-banging driver with simulated GPIO port. Each port's GPIO
+ * is connected to a separate emulated bus. Slots are decoded on the port
+ * sampling: GPIOs still low at this time are touched with 0, GPIOs released
+ * before are touched with 1 or reset (basing on the low pulse duration).
+ */
+class OneWireNg_BitBangMulti_Test: OneWireNg_BitBangMulti
+{
+public:
+    static void test_lockstep()
+    {
+        OneWireNg_BitBangMulti_Test mb;
+        SimDSTherm *therms[BUSES_NUM];
+
+        for (int i = 0; i < BUSES_NUM; i++) {
+            OneWireNg::Id id;
+            setId(id, DSTherm::DS18B20, (uint8_t)i);
+            therms[i] = new SimDSTherm(id, 16 * (20 + i) + i);
+            mb._bus[mb._lanes[i]].attach(therms[i]);
+        }
+        uint32_t all = mb.getBusesMask();
+        unsigned long start = simUs;
+
+        /* convert T on all the buses */
+        uint8_t convert[] = { OneWireNg::CMD_SKIP_ROM, DSTherm::CMD_CONVERT_T };
+        assert(mb.reset(all) == all);
+        mb.writeBytes(all, convert, sizeof(convert));
+
+        /* wait for all the conversions to finish */
+        while (mb.touchBits(all, all) != all);
+
+        /* read scratchpads */
+        uint8_t read[] = {
+            OneWireNg::CMD_SKIP_ROM, DSTherm::CMD_READ_SCRATCHPAD };
+        uint8_t scrpds[BUSES_NUM][DSTherm::Scratchpad::LENGTH];
+
+        assert(mb.reset(all) == all);
+        mb.writeBytes(all, read, sizeof(read));
+        mb.readBytes(all, &scrpds[0][0], sizeof(scrpds[0]));
+
+        for (int i = 0; i < BUSES_NUM; i++) {
+            assert(!OneWireNg::crc8(scrpds[i], sizeof(scrpds[i])));
+            assert(scrpds[i][0] + (scrpds[i][1] << 8) == 16 * (20 + i) + i);
+            assert(therms[i]->nConv == 1 && therms[i]->nReads == 1);
+        }
+
+        /*
+         * The buses were served in the bus time of a single one: each slot
+         * on the port was performed for all of them simultaneously.
+         */
+        const SimBus& bus0 = mb._bus[mb._lanes[0]];
+        for (int i = 0; i < BUSES_NUM; i++) {
+            const SimBus& bus = mb._bus[mb._lanes[i]];
+            assert(bus.nResets == 2 && bus.nBits == bus0.nBits);
+        }
+        assert(mb._nSlots == bus0.nResets + bus0.nBits);
+        assert(simUs - start ==
+            bus0.nResets * RESET_TIME + bus0.nBits * SLOT_TIME);
+
+        for (int i = 0; i < BUSES_NUM; i++)
+            delete therms[i];
+
+        TEST_SUCCESS();
+    }
+
+    static void test_touch()
+    {
+        OneWireNg_BitBangMulti_Test mb;
+        OneWireNg::Id ids[BUSES_NUM];
+        SimDSTherm *therms[BUSES_NUM];
+
+        /* bus on lane 3 is left empty */
+        for (int i = 0; i < BUSES_NUM; i++) {
+            setId(ids[i], DSTherm::DS18B20, (uint8_t)(0x10 + i));
+            therms[i] = new SimDSTherm(ids[i], 16 * i);
+            if (i != 3)
+                mb._bus[mb._lanes[i]].attach(therms[i]);
+        }
+        uint32_t all = mb.getBusesMask();
+        uint32_t pres = mb.reset(all);
+        assert(pres == (all & ~(1UL << mb._lanes[3])));
+
+        /*
+         * Read ROM on each bus - the read ids differ, therefore the buses
+         * are touched with different bits in the same slot.
+         */
+        uint8_t readRom = OneWireNg::CMD_READ_ROM;
+        OneWireNg::Id rdIds[BUSES_NUM - 1];
+        mb.writeBytes(pres, &readRom, 1);
+        mb.readBytes(pres, &rdIds[0][0], sizeof(rdIds[0]));
+
+        for (int i = 0, n = 0; i < BUSES_NUM; i++) {
+            if (i == 3) continue;
+            assert(!memcmp(rdIds[n++], ids[i], sizeof(OneWireNg::Id)));
+        }
+
+        /* per-bus match ROM and write scratchpad with bus specific data */
+        uint8_t cmds[BUSES_NUM - 1][1 + sizeof(OneWireNg::Id) + 4];
+        for (int i = 0, n = 0; i < BUSES_NUM; i++) {
+            if (i == 3) continue;
+            cmds[n][0] = OneWireNg::CMD_MATCH_ROM;
+            memcpy(&cmds[n][1], ids[i], sizeof(OneWireNg::Id));
+            cmds[n][9] = DSTherm::CMD_WRITE_SCRATCHPAD;
+            cmds[n][10] = (uint8_t)(0x40 + i);
+            cmds[n][11] = (uint8_t)(0x80 + i);
+            cmds[n][12] = 0x1f;
+            n++;
+        }
+        assert(mb.reset(pres) == pres);
+        mb.touchBytes(pres, &cmds[0][0], sizeof(cmds[0]));
+
+        for (int i = 0; i < BUSES_NUM; i++) {
+            if (i == 3) {
+                assert(!therms[i]->nWrites);
+                continue;
+            }
+            assert(therms[i]->nWrites == 1);
+            assert(therms[i]->getTh() == (int8_t)(0x40 + i) &&
+                therms[i]->getTl() == (int8_t)(0x80 + i));
+        }
+
+        /* powered after the last bit, de-powered on the next reset */
+        uint8_t convert[] = { OneWireNg::CMD_SKIP_ROM, DSTherm::CMD_CONVERT_T };
+        mb.writeBytes(pres, convert, sizeof(convert), true);
+        assert(mb._pwre == pres && mb._pwr == pres);
+        assert(mb.reset(pres) == pres);
+        assert(!mb._pwre && !mb._pwr);
+
+        for (int i = 0; i < BUSES_NUM; i++)
+            delete therms[i];
+
+        TEST_SUCCESS();
+    }
+
+private:
+    OneWireNg_BitBangMulti_Test():
+        _low(0), _pend(0), _dec(0), _pwr(0), _nSlots(0)
+    {
+        static const int lanes[BUSES_NUM] = { 0, 1, 3, 4, 7, 8, 12, 31 };
+        uint32_t mask = 0;
+
+        for (int i = 0; i < BUSES_NUM; i++) {
+            _lanes[i] = lanes[i];
+            mask |= (1UL << lanes[i]);
+        }
+        setupBuses(mask);
+    }
+
+    uint32_t readPortIn()
+    {
+        uint32_t smpl = ~_low;
+
+        for (int l = 0; l < 32; l++)
+        {
+            uint32_t lm = (1UL << l);
+
+            if ((_low & lm) && !(_dec & lm)) {
+                /* still low: write-0 */
+                _bus[l].touchBit(0, false);
+                _dec |= lm;
+            } else
+            if (_pend & lm) {
+                int bit;
+                if (_lowDur[l] >= RESET_THRSH) {
+                    bit = (_bus[l].reset() == OneWireNg::EC_SUCCESS ? 0 : 1);
+                } else {
+                    bit = _bus[l].touchBit(1, false);
+                }
+                if (!bit) smpl &= ~lm;
+                _pend &= ~lm;
+            }
+        }
+        return smpl;
+    }
+
+    void setPortAsInput(uint32_t mask)
+    {
+        unsigned long now = simUs;
+
+        for (int l = 0; l < 32; l++)
+        {
+            uint32_t lm = (1UL << l);
+
+            if ((mask & lm) && (_low & lm)) {
+                if (!(_dec & lm)) {
+                    _lowDur[l] = now - _lowStart[l];
+                    _pend |= lm;
+                }
+                _dec &= ~lm;
+            }
+        }
+        _low &= ~mask;
+        _pwr &= ~mask;
+    }
+
+    void setPortAsOutput(uint32_t mask, int state)
+    {
+        if (state) {
+            _pwr |= mask;
+            return;
+        }
+
+        unsigned long now = simUs;
+        for (int l = 0; l < 32; l++) {
+            if ((mask & ~_low) & (1UL << l))
+                _lowStart[l] = now;
+        }
+        _low |= mask;
+        _pend &= ~mask;
+        _nSlots++;
+    }
+
+    int _lanes[BUSES_NUM];  /* buses lanes (port bits) */
+    SimBus _bus[32];        /* emulated bus per port bit */
+
+    uint32_t _low;          /* GPIOs driven low */
+    uint32_t _pend;         /* GPIOs released, pending for sampling */
+    uint32_t _dec;          /* low GPIOs already decoded as write-0 */
+    uint32_t _pwr;          /* powered GPIOs */
+    unsigned long _lowStart[32];
+    unsigned long _lowDur[32];
+
+    /* number of slots (including resets) performed on the port */
+    unsigned long _nSlots;
+};
+
+int main(void)
+{
+    OneWireNg_BitBangMulti_Test::test_lockstep();
+    OneWireNg_BitBangMulti_Test::test_touch();
+
+    return 0;
+}
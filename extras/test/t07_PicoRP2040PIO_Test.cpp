@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#define PICO_NO_HARDWARE 1
+#include "platform/rp2040/w1.pio.h"
+#include "sim_pio.h"
+#include "sim_dstherm.h"
+
+/* max number of PIO cycles to run a program */
+#define MAX_CYCLES 100000UL
+
+/*
+ * 1-wire bus line driven by the emulated PIO SM. Time is expressed in 0.1us
+ * units (as PIO programs cycle times). Slots are decoded on the line release
+ * basing on the low pulse duration, then the slave's response is driven on
+ * the line for the sampling.
+ */
+class W1Line: public SimPioPin
+{
+public:
+    W1Line(bool od):
+        strong(false), nSlots(0), _od(od), _now(0), _cycle(0), _c0(0),
+        _low(false), _lowStart(0), _slotStart(0), _slaveLowUntil(0),
+        _touch1(false)
+    {
+        resetStats();
+    }
+
+    /** Start PIO program with a given cycle time at PIO cycle @c c0 */
+    void start(unsigned cycle, unsigned long c0)
+    {
+        /* some idle time between the programs */
+        _now += 100;
+        _cycle = cycle;
+        _c0 = c0;
+    }
+
+    /** Stop PIO program at PIO cycle @c c */
+    void stop(unsigned long c) {
+        time(c);
+    }
+
+    void resetStats()
+    {
+        w1LowMin = w0LowMin = smplMin = periodMin = ~0UL;
+        w1LowMax = w0LowMax = smplMax = periodMax = 0;
+    }
+
+    bool isLow() const {
+        return _low;
+    }
+
+    void update(int dir, int out, unsigned long c)
+    {
+        unsigned long t = time(c);
+        bool low = (dir && !out);
+
+        strong = (dir && out);
+        if (low && !_low)
+        {
+            if (nSlots > 0)
+                stat(periodMin, periodMax, t - _slotStart);
+            _low = true;
+            _lowStart = _slotStart = t;
+        } else
+        if (!low && _low)
+        {
+            unsigned long dur = t - _lowStart;
+            _low = false;
+
+            if (dur >= (_od ? 400 : 4000)) {
+                /* reset; presence pulse */
+                if (bus.reset() == OneWireNg::EC_SUCCESS)
+                    _slaveLowUntil = t + (_od ? 100 : 1000);
+                nSlots = 0;
+                _touch1 = false;
+            } else
+            if (dur >= (_od ? 20 : 150)) {
+                /* write-0 */
+                stat(w0LowMin, w0LowMax, dur);
+                bus.touchBit(0, false);
+                nSlots++;
+                _touch1 = false;
+            } else {
+                /* write-1; slave may keep the line low */
+                stat(w1LowMin, w1LowMax, dur);
+                if (!bus.touchBit(1, false))
+                    _slaveLowUntil = _lowStart + (_od ? 30 : 300);
+                nSlots++;
+                _touch1 = true;
+            }
+        }
+    }
+
+    int read(unsigned long c)
+    {
+        unsigned long t = time(c);
+
+        if (_low)
+            return 0;
+        if (_touch1)
+            stat(smplMin, smplMax, t - _slotStart);
+        return (t < _slaveLowUntil ? 0 : 1);
+    }
+
+    SimBus bus;
+    bool strong;                /* strong pull-up (driven high) */
+    unsigned long nSlots;       /* slots since the last reset */
+
+    /* timing statistics (0.1us) */
+    unsigned long w1LowMin, w1LowMax;
+    unsigned long w0LowMin, w0LowMax;
+    unsigned long smplMin, smplMax;     /* write-1 sampling time */
+    unsigned long periodMin, periodMax; /* slots period */
+
+private:
+    unsigned long time(unsigned long c)
+    {
+        unsigned long t = _now + (c - _c0) * _cycle;
+        if (t > _now) {
+            _now = t;
+            _c0 = c;
+        }
+        return t;
+    }
+
+    static void stat(unsigned long& min, unsigned long& max, unsigned long v)
+    {
+        if (v < min) min = v;
+        if (v > max) max = v;
+    }
+
+    bool _od;
+    unsigned long _now;
+    unsigned _cycle;
+    unsigned long _c0;
+
+    bool _low;
+    unsigned long _lowStart;
+    unsigned long _slotStart;
+    unsigned long _slaveLowUntil;
+    bool _touch1;
+};
+
+/*
+ * PIO programs executed the way OneWireNg_PicoRP2040PIO driver does.
+ */
+class PicoRP2040PIO_Test
+{
+public:
+    static void test_reset()
+    {
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 1);
+        SimDSTherm therm(id);
+
+        for (int od = 0; od < 2; od++)
+        {
+            W1Line line(od);
+            assert(reset(line, od) == OneWireNg::EC_NO_DEVS);
+
+            line.bus.attach(&therm);
+            assert(reset(line, od) == OneWireNg::EC_SUCCESS);
+            assert(line.bus.nResets == 2);
+        }
+
+        TEST_SUCCESS();
+    }
+
+    static void test_touch()
+    {
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 2);
+        SimDSTherm therm(id);
+        W1Line line(false);
+
+        line.bus.attach(&therm);
+        assert(reset(line, false) == OneWireNg::EC_SUCCESS);
+
+        /* read ROM bit-by-bit */
+        uint8_t cmd = OneWireNg::CMD_READ_ROM;
+        for (int i = 0; i < 8; i++)
+            touchBit(line, (cmd >> i) & 1, false);
+
+        OneWireNg::Id rdId;
+        memset(rdId, 0, sizeof(rdId));
+        for (int i = 0; i < 64; i++) {
+            if (touchBit(line, 1, (i >= 63)))
+                rdId[i >> 3] |= (uint8_t)(1 << (i & 7));
+        }
+        assert(!memcmp(rdId, id, sizeof(id)));
+
+        /* strong pull-up after the last bit */
+        assert(line.strong);
+
+        /* standard mode timings */
+        assert(line.w1LowMax <= 150 && line.w1LowMin >= 10);
+        assert(line.smplMax <= 150);
+        assert(line.w0LowMin >= 600 && line.w0LowMax <= 1200);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_bytes()
+    {
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 3);
+        SimDSTherm therm(id);
+
+        for (int od = 0; od < 2; od++)
+        {
+            W1Line line(od);
+            line.bus.attach(&therm);
+
+            /* read ROM */
+            uint8_t bytes[1 + sizeof(OneWireNg::Id)];
+            memset(bytes, 0xff, sizeof(bytes));
+            bytes[0] = OneWireNg::CMD_READ_ROM;
+
+            assert(reset(line, od) == OneWireNg::EC_SUCCESS);
+            line.resetStats();
+            unsigned long nFifo = touchBytes(line, bytes, sizeof(bytes), od);
+
+            assert(bytes[0] == OneWireNg::CMD_READ_ROM);
+            assert(!memcmp(&bytes[1], id, sizeof(id)));
+            assert(line.nSlots == 8 * sizeof(bytes));
+
+            /* CPU involved once per byte for each FIFO */
+            assert(nFifo == 2 * sizeof(bytes));
+
+            if (!od) {
+                /* standard mode: 4us write-1 low, sampling at 12us */
+                assert(line.w1LowMin == 40 && line.w1LowMax == 40);
+                assert(line.smplMin == 120 && line.smplMax == 120);
+                /* 60us write-0 low, 70us slot */
+                assert(line.w0LowMin == 600 && line.w0LowMax == 600);
+                assert(line.periodMin == 700 && line.periodMax == 700);
+            } else {
+                /* overdrive: sampling at max 2us, write-0 low 6-16us */
+                assert(line.smplMax <= 20);
+                assert(line.w0LowMin >= 60 && line.w0LowMax <= 160);
+                assert(line.periodMin == 70 && line.periodMax == 70);
+            }
+
+            /* read scratchpad (power-on content) */
+            uint8_t scrpd[2 + DSTherm::Scratchpad::LENGTH];
+            memset(scrpd, 0xff, sizeof(scrpd));
+            scrpd[0] = OneWireNg::CMD_SKIP_ROM;
+            scrpd[1] = DSTherm::CMD_READ_SCRATCHPAD;
+
+            assert(reset(line, od) == OneWireNg::EC_SUCCESS);
+            touchBytes(line, scrpd, sizeof(scrpd), od);
+            assert(!OneWireNg::crc8(&scrpd[2], DSTherm::Scratchpad::LENGTH));
+            assert(scrpd[2] == 0x50 && scrpd[3] == 0x05);
+        }
+
+        TEST_SUCCESS();
+    }
+
+    static void test_triplet()
+    {
+        OneWireNg::Id ids[3];
+        SimDSTherm *therms[3];
+
+        for (int od = 0; od < 2; od++)
+        {
+            W1Line line(od);
+
+            for (int i = 0; i < 3; i++) {
+                setId(ids[i], DSTherm::DS18B20, (uint8_t)(0x11 << i));
+                therms[i] = new SimDSTherm(ids[i]);
+                line.bus.attach(therms[i]);
+            }
+
+            /* search for each of the ids by the triplets directions */
+            for (int i = 0; i < 3; i++)
+            {
+                OneWireNg::Id id;
+                memset(id, 0, sizeof(id));
+
+                assert(reset(line, od) == OneWireNg::EC_SUCCESS);
+                uint8_t cmd = OneWireNg::CMD_SEARCH_ROM;
+                touchBytes(line, &cmd, 1, od);
+
+                int nDiscr = 0;
+                for (int n = 0; n < 64; n++)
+                {
+                    int dir = (ids[i][n >> 3] >> (n & 7)) & 1;
+                    int trpl = touchTriplet(line, dir, od);
+
+                    assert(trpl != 3);
+                    if (!trpl) nDiscr++;
+
+                    if ((!trpl ? dir : !(trpl >> 1)))
+                        id[n >> 3] |= (uint8_t)(1 << (n & 7));
+                }
+                assert(!memcmp(id, ids[i], sizeof(id)));
+                assert(nDiscr > 0);
+
+                /* single program run per triplet; read slots back-to-back */
+                assert(line.nSlots == 8 + 3 * 64);
+                assert(line.periodMin == (od ? 70 : 700));
+            }
+
+            line.bus.detachAll();
+            for (int i = 0; i < 3; i++)
+                delete therms[i];
+        }
+
+        TEST_SUCCESS();
+    }
+
+private:
+    /** Run single bit program until the result is pushed */
+    static uint32_t run(SimPio& pio, W1Line& line, unsigned cycle)
+    {
+        uint32_t res;
+
+        /* left-shift, no-autopush, IN threshold: 1 */
+        pio.inShiftRight = false;
+        pio.pushThr = 1;
+
+        line.start(cycle, pio.cycles);
+        pio.restart(0);
+        while (!pio.get(res)) {
+            assert(pio.cycles < MAX_CYCLES);
+            pio.step();
+        }
+        line.stop(pio.cycles);
+        return res;
+    }
+
+    static OneWireNg::ErrorCode reset(W1Line& line, bool od)
+    {
+        SimPio pio(line, w1_reset_program_instructions,
+            TAB_SZ(w1_reset_program_instructions),
+            w1_reset_wrap_target, w1_reset_wrap);
+
+        uint32_t res = run(pio, line, (od ? w1_reset_od_cycle : w1_reset_cycle));
+        return ((res & 1) ? OneWireNg::EC_NO_DEVS : OneWireNg::EC_SUCCESS);
+    }
+
+    static int touchBit(W1Line& line, int bit, bool power)
+    {
+        if (bit) {
+            SimPio pio(line, w1_touch1_program_instructions,
+                TAB_SZ(w1_touch1_program_instructions),
+                w1_touch1_wrap_target, w1_touch1_wrap);
+            pio.put(power ? w1_touch1_strong : w1_touch1_weak);
+            return (run(pio, line, w1_touch1_cycle) & 1);
+        } else {
+            SimPio pio(line, w1_touch0_program_instructions,
+                TAB_SZ(w1_touch0_program_instructions),
+                w1_touch0_wrap_target, w1_touch0_wrap);
+            pio.put(power ? w1_touch0_strong : w1_touch0_weak);
+            return (run(pio, line, w1_touch0_cycle) & 1);
+        }
+    }
+
+    /**
+     * Touch bytes by the bytes touch program. Returns number of FIFOs
+     * accesses performed by the CPU.
+     */
+    static unsigned long touchBytes(
+        W1Line& line, uint8_t *bytes, size_t len, bool od)
+    {
+        SimPio pio(line, w1_bytes_program_instructions,
+            TAB_SZ(w1_bytes_program_instructions),
+            w1_bytes_wrap_target, w1_bytes_wrap);
+
+        pio.inShiftRight = pio.outShiftRight = true;
+        pio.autopush = pio.autopull = true;
+        pio.pushThr = pio.pullThr = 8;
+
+        line.start((od ? w1_bytes_od_cycle : w1_bytes_cycle), pio.cycles);
+        pio.restart(0);
+
+        size_t tx = 0, rx = 0;
+        unsigned long nFifo = 0;
+
+        while (rx < len)
+        {
+            assert(pio.cycles < MAX_CYCLES);
+
+            if (tx < len && pio.put(bytes[tx])) {
+                tx++;
+                nFifo++;
+            }
+
+            uint32_t v;
+            if (pio.get(v)) {
+                /* the byte is pushed with the bus released */
+                assert(!line.isLow());
+                bytes[rx++] = (uint8_t)(v >> 24);
+                nFifo++;
+            }
+            pio.step();
+        }
+
+        /* the program stalls with the bus released */
+        for (int i = 0; i < 100; i++)
+            pio.step();
+        assert(!line.isLow());
+        line.stop(pio.cycles);
+
+        return nFifo;
+    }
+
+    /**
+     * Touch search triplet by the bytes touch program (1-bit FIFOs
+     * thresholds). Returns read bits in the same format as
+     * OneWireNg::touchTriplet().
+     */
+    static int touchTriplet(W1Line& line, int dir, bool od)
+    {
+        SimPio pio(line, w1_bytes_program_instructions,
+            TAB_SZ(w1_bytes_program_instructions),
+            w1_bytes_wrap_target, w1_bytes_wrap);
+
+        pio.inShiftRight = pio.outShiftRight = true;
+        pio.autopush = pio.autopull = true;
+        pio.pushThr = pio.pullThr = 1;
+
+        /* both read slots are queued at once */
+        pio.put(1);
+        pio.put(1);
+
+        line.start((od ? w1_bytes_od_cycle : w1_bytes_cycle), pio.cycles);
+        pio.restart(0);
+
+        int v[3];
+        for (int n = 0; n < 3;)
+        {
+            assert(pio.cycles < MAX_CYCLES);
+
+            uint32_t res;
+            if (pio.get(res)) {
+                v[n++] = (int)(res >> 31);
+                if (n == 2)
+                    pio.put((uint32_t)(v[0] != v[1] ? v[0] : dir));
+            }
+            pio.step();
+        }
+        assert(!line.isLow());
+        line.stop(pio.cycles);
+
+        return (v[0] | (v[1] << 1));
+    }
+};
+
+int main(void)
+{
+    PicoRP2040PIO_Test::test_reset();
+    PicoRP2040PIO_Test::test_touch();
+    PicoRP2040PIO_Test::test_bytes();
+    PicoRP2040PIO_Test::test_triplet();
+
+    return 0;
+}
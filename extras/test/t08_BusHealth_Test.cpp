@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "utils/BusHealth.h"
+#include "sim_gpio.h"
+#include "sim_dstherm.h"
+
+/*
+ * Bus held low: reset reports presence pulse, read slot returns 0.
+ */
+class ShortedBus: public OneWireNg
+{
+public:
+    ErrorCode reset() {
+        return EC_SUCCESS;
+    }
+
+    int touchBit(int bit, bool power) {
+        (void)bit;
+        (void)power;
+        return 0;
+    }
+};
+
+static void test_sweep()
+{
+    OneWireNg::Id id = {DSTherm::DS18B20, 1, 2, 3, 4, 5, 6, 0};
+    id[7] = OneWireNg::crc8(id, sizeof(id) - 1);
+    SimDSTherm therm(id);
+
+    SimBus busPres, busNoDevs;
+    ShortedBus busShrt;
+    SimGpioBus gpioPres, gpioNoDevs, gpioShrt;
+
+    busPres.attach(&therm);
+    gpioPres.present = true;
+    gpioShrt.shorted = true;
+
+    BusHealth<> hlth;
+    assert(hlth.add(busPres) == OneWireNg::EC_SUCCESS);     /* 0 */
+    assert(hlth.add(busNoDevs) == OneWireNg::EC_SUCCESS);   /* 1 */
+    assert(hlth.add(busShrt) == OneWireNg::EC_SUCCESS);     /* 2 */
+    assert(hlth.add(gpioPres) == OneWireNg::EC_SUCCESS);    /* 3 */
+    assert(hlth.add(gpioNoDevs) == OneWireNg::EC_SUCCESS);  /* 4 */
+    assert(hlth.add(gpioShrt) == OneWireNg::EC_SUCCESS);    /* 5 */
+    assert(hlth.getBuses() == 0x3f);
+
+    unsigned long start = simUs;
+    assert(hlth.sweep() == 0x09);
+    assert(hlth.getPresent() == 0x09);
+    assert(hlth.getShorted() == 0x24);
+    assert(hlth.getNoDevs() == 0x12);
+
+    /* bit-banged buses: single overlapped reset */
+    assert(simUs - start == 480 + 480);
+
+    assert(hlth.getState(0) == BusHealth<>::BUS_PRESENT);
+    assert(hlth.getState(1) == BusHealth<>::BUS_NO_DEVS);
+    assert(hlth.getState(2) == BusHealth<>::BUS_SHORTED);
+    assert(hlth.getState(5) == BusHealth<>::BUS_SHORTED);
+
+    /* presence pulse timing for bit-banged buses only */
+    assert(!hlth.getTiming(0) && !hlth.getTiming(2));
+    const OneWireNg_BitBang::PresenceTiming *tm = hlth.getTiming(3);
+    assert(tm && tm->start >= 30 && tm->start < 32);
+    assert(tm->length > 118 && tm->length <= 122);
+    tm = hlth.getTiming(4);
+    assert(tm && !tm->start);
+
+    /* the bus state changes */
+    busPres.detachAll();
+    gpioShrt.shorted = false;
+    gpioShrt.present = true;
+    assert(hlth.sweep() == 0x28);
+    assert(hlth.getShorted() == 0x04);
+    assert(hlth.getNoDevs() == 0x13);
+
+    TEST_SUCCESS();
+}
+
+/*
+ * Presence pulse started after the presence-detect window is not sampled.
+ */
+static void test_window()
+{
+    SimGpioBus gpioPres, gpioLate;
+    BusHealth<> hlth;
+
+    gpioPres.present = gpioLate.present = true;
+    gpioLate.presStart = 100;
+
+    assert(hlth.add(gpioPres) == OneWireNg::EC_SUCCESS);
+    assert(hlth.add(gpioLate) == OneWireNg::EC_SUCCESS);
+
+    unsigned long start = simUs;
+    assert(hlth.sweep() == 0x01);
+    assert(hlth.getNoDevs() == 0x02);
+    assert(simUs - start == 480 + 480);
+
+    const OneWireNg_BitBang::PresenceTiming *tm = hlth.getTiming(1);
+    assert(tm && !tm->start);
+
+    TEST_SUCCESS();
+}
+
+static void test_full()
+{
+    SimBus bus1, bus2, bus3;
+    BusHealth<2> hlth;
+
+    assert(hlth.add(bus1) == OneWireNg::EC_SUCCESS);
+    assert(hlth.add(bus2) == OneWireNg::EC_SUCCESS);
+    assert(hlth.add(bus3) == OneWireNg::EC_FULL);
+
+    assert(!hlth.sweep());
+    assert(hlth.getNoDevs() == 0x03);
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_sweep();
+    test_window();
+    test_full();
+
+    return 0;
+}
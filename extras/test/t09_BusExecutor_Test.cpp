@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include <thread>
+#include <unistd.h>
+#include "common.h"
+#include "utils/BusExecutor.h"
+#include "utils/Placeholder.h"
+#include "sim_dstherm.h"
+
+#define THREADS_NUM 4
+#define THREAD_REQS 50
+
+class BusExecutor_Test
+{
+public:
+    static void test_coalesce()
+    {
+        SimBus bus;
+        OneWireNg::Id id1, id2;
+        setId(id1, DSTherm::DS18B20, 1);
+        setId(id2, DSTherm::DS18B20, 2);
+        SimDSTherm therm1(id1, 16 * 21), therm2(id2, 16 * 22);
+        bus.attach(&therm1);
+        bus.attach(&therm2);
+
+        BusExecutor exe(bus);
+        BusExecutor::Request conv1, conv2, rd1a, rd1b, rd2;
+        Placeholder<DSTherm::Scratchpad> scrpd1a, scrpd1b, scrpd2;
+
+        conv1.setConvertTemp(&id1);
+        conv2.setConvertTemp(&id2);
+        rd1a.setReadScratchpad(id1, scrpd1a);
+        rd1b.setReadScratchpad(id1, scrpd1b);
+        rd2.setReadScratchpad(id2, scrpd2);
+
+        assert(exe.submit(conv1, 1) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(rd1a) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(rd2) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(conv2, 1) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(rd1b) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(rd1b) == OneWireNg::EC_FULL);
+
+        /* conversions coalesced into single conversion of all sensors */
+        assert(exe.process() == 2);
+        assert(conv1.isDone() && !conv1.isCoalesced());
+        assert(conv2.isDone() && conv2.isCoalesced());
+        assert(conv1.getStatus() == OneWireNg::EC_SUCCESS &&
+            conv2.getStatus() == OneWireNg::EC_SUCCESS);
+        assert(therm1.nConv == 1 && therm2.nConv == 1);
+        assert(!rd1a.isDone() && !rd1b.isDone() && !rd2.isDone());
+
+        /* duplicated reads collapsed */
+        assert(exe.process() == 2);
+        assert(rd1a.isDone() && rd1b.isDone() && rd1b.isCoalesced());
+        assert(rd1a.getStatus() == OneWireNg::EC_SUCCESS &&
+            rd1b.getStatus() == OneWireNg::EC_SUCCESS);
+        assert(therm1.nReads == 1);
+        assert(scrpd1a->getTemp() == 21000 && scrpd1b->getTemp() == 21000);
+        assert(!memcmp(scrpd1a->getRaw(), scrpd1b->getRaw(),
+            DSTherm::Scratchpad::LENGTH));
+
+        assert(exe.process() == 1);
+        assert(rd2.isDone() && rd2.getStatus() == OneWireNg::EC_SUCCESS);
+        assert(therm2.nReads == 1 && scrpd2->getTemp() == 22000);
+
+        assert(exe.isIdle() && !exe.process());
+
+        /* single conversion is not turned into conversion of all */
+        conv1.setConvertTemp(&id1);
+        assert(exe.submit(conv1) == OneWireNg::EC_SUCCESS);
+        assert(exe.processAll() == 1);
+        assert(therm1.nConv == 2 && therm2.nConv == 1);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_conflict()
+    {
+        SimBus bus;
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 1);
+        SimDSTherm therm(id, 16 * 21);
+        bus.attach(&therm);
+
+        BusExecutor exe(bus);
+        BusExecutor::Request rd1, conv, rd2;
+        Placeholder<DSTherm::Scratchpad> scrpd1, scrpd2;
+
+        rd1.setReadScratchpad(id, scrpd1);
+        conv.setConvertTemp(&id);
+        rd2.setReadScratchpad(id, scrpd2);
+
+        assert(exe.submit(rd1) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(conv) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(rd2) == OneWireNg::EC_SUCCESS);
+
+        /* read not coalesced across the conversion */
+        assert(exe.process() == 1);
+        assert(rd1.isDone() && !conv.isDone() && !rd2.isDone());
+        assert(scrpd1->getTemp() == 85000);
+
+        assert(exe.process() == 1);
+        assert(conv.isDone() && therm.nConv == 1);
+
+        assert(exe.process() == 1);
+        assert(rd2.isDone() && !rd2.isCoalesced());
+        assert(therm.nReads == 2 && scrpd2->getTemp() == 21000);
+
+        assert(exe.isIdle());
+
+        TEST_SUCCESS();
+    }
+
+    static void test_order()
+    {
+        SimBus bus;
+        BusExecutor exe(bus);
+        BusExecutor::Request reqs[6];
+
+        /* priority, deadline */
+        static const unsigned long params[][2] = {
+            { 0, 0 },       /* 5 */
+            { 0, 1000 },    /* 4 */
+            { 2, 0 },       /* 1 */
+            { 0, 500 },     /* 3 */
+            { 2, 0 },       /* 2 */
+            { 3, 1000 }     /* 0 */
+        };
+        static const int order[] = { 5, 2, 4, 3, 1, 0 };
+
+        _nDone = 0;
+        for (int i = 0; i < (int)TAB_SZ(reqs); i++) {
+            reqs[i].setCustom(trNop, NULL, onDone, (void*)(long)i);
+            assert(exe.submit(reqs[i], (uint8_t)params[i][0], params[i][1]) ==
+                OneWireNg::EC_SUCCESS);
+        }
+        assert(exe.processAll() == TAB_SZ(reqs));
+        assert(_nDone == (int)TAB_SZ(reqs));
+        assert(!memcmp(_done, order, sizeof(order)));
+
+        /* custom transactions are never coalesced */
+        for (int i = 0; i < (int)TAB_SZ(reqs); i++)
+            assert(!reqs[i].isCoalesced());
+
+        TEST_SUCCESS();
+    }
+
+    static void test_deadline()
+    {
+        SimBus bus;
+        BusExecutor exe(bus);
+        BusExecutor::Request req1, req2;
+
+        req1.setCustom(trNop, NULL);
+        req2.setCustom(trNop, NULL);
+        assert(exe.submit(req1, 0, 1) == OneWireNg::EC_SUCCESS);
+        assert(exe.submit(req2, 0, 1000) == OneWireNg::EC_SUCCESS);
+        usleep(5000);
+
+        /* expired request completed along with the processed one */
+        assert(exe.process() == 2);
+        assert(req1.isDone() && req1.getStatus() == OneWireNg::EC_TIMEOUT);
+        assert(req2.isDone() && req2.getStatus() == OneWireNg::EC_SUCCESS);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_threads()
+    {
+        SimBus bus;
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 1);
+        SimDSTherm therm(id);
+        bus.attach(&therm);
+
+        BusExecutor exe(bus);
+        std::thread *thrds[THREADS_NUM];
+        unsigned long nRequested = 0;
+
+        _nDone = 0;
+        for (int i = 0; i < THREADS_NUM; i++)
+            thrds[i] = new std::thread(submitter, &exe, i);
+
+        /* bus owner */
+        while (nRequested < THREADS_NUM * THREAD_REQS) {
+            nRequested += exe.process();
+        }
+        for (int i = 0; i < THREADS_NUM; i++) {
+            thrds[i]->join();
+            delete thrds[i];
+        }
+
+        assert(exe.isIdle());
+        assert(_nDone == THREADS_NUM * THREAD_REQS);
+        assert(therm.nReads <= THREADS_NUM * THREAD_REQS);
+
+        TEST_SUCCESS();
+    }
+
+private:
+    static OneWireNg::ErrorCode trNop(OneWireNg& ow, void *arg)
+    {
+        (void)arg;
+        ow.touchByte(0xff);
+        return OneWireNg::EC_SUCCESS;
+    }
+
+    static void onDone(BusExecutor::Request& req, void *arg)
+    {
+        (void)req;
+        _done[_nDone++] = (int)(long)arg;
+    }
+
+    /*
+     * Submits scratchpad reads of the same sensor, waiting for each of them
+     * to complete (the reads of different threads are coalesced).
+     */
+    static void submitter(BusExecutor *exe, int n)
+    {
+        (void)n;
+        OneWireNg::Id id;
+        setId(id, DSTherm::DS18B20, 1);
+
+        BusExecutor::Request req;
+        Placeholder<DSTherm::Scratchpad> scrpd;
+
+        for (int i = 0; i < THREAD_REQS; i++) {
+            req.setReadScratchpad(id, scrpd, onRead);
+            assert(exe->submit(req, (uint8_t)n) == OneWireNg::EC_SUCCESS);
+            while (!req.isDone()) usleep(10);
+
+            assert(req.getStatus() == OneWireNg::EC_SUCCESS);
+            /* power-on temperature (no conversion performed) */
+            assert(scrpd->getTemp() == 85000);
+        }
+    }
+
+    static void onRead(BusExecutor::Request& req, void *arg)
+    {
+        (void)req;
+        (void)arg;
+        __atomic_add_fetch(&_nDone, 1, __ATOMIC_SEQ_CST);
+    }
+
+    static int _done[16];
+    static int _nDone;
+};
+
+int BusExecutor_Test::_done[16];
+int BusExecutor_Test::_nDone;
+
+int main(void)
+{
+    BusExecutor_Test::test_coalesce();
+    BusExecutor_Test::test_conflict();
+    BusExecutor_Test::test_order();
+    BusExecutor_Test::test_deadline();
+    BusExecutor_Test::test_threads();
+
+    return 0;
+}
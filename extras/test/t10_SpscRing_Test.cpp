@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include <thread>
+#include "common.h"
+#include "utils/SpscRing.h"
+
+#define ITEMS_NUM 200000UL
+
+static void test_ring()
+{
+    SpscRing<int, 4> ring;
+    int v;
+
+    assert(ring.isEmpty() && !ring.isFull() && ring.capacity() == 4);
+    assert(!ring.pop(v) && !ring.peek());
+
+    for (int i = 0; i < 4; i++)
+        assert(ring.push(i));
+    assert(ring.isFull() && ring.size() == 4);
+    assert(!ring.push(4));
+
+    assert(*ring.peek() == 0);
+    assert(ring.pop(v) && v == 0);
+    assert(ring.push(4) && !ring.push(5));
+
+    /* wrapped around the buffer */
+    for (int i = 1; i <= 4; i++)
+        assert(ring.pop(v) && v == i);
+    assert(ring.isEmpty() && !ring.pop(v));
+
+    TEST_SUCCESS();
+}
+
+static SpscRing<unsigned long, 16> spsc;
+
+static void producer()
+{
+    for (unsigned long i = 0; i < ITEMS_NUM;) {
+        if (spsc.push(i))
+            i++;
+        else
+            std::this_thread::yield();
+    }
+}
+
+static void test_spsc()
+{
+    std::thread prod(producer);
+
+    /* consumer: items received in order, none lost */
+    unsigned long v;
+    for (unsigned long i = 0; i < ITEMS_NUM;) {
+        if (spsc.pop(v)) {
+            assert(v == i);
+            i++;
+        } else
+            std::this_thread::yield();
+    }
+    prod.join();
+    assert(spsc.isEmpty());
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_ring();
+    test_spsc();
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "drivers/DSThermBatch.h"
+#include "platform/Platform_New.h"
+#include "utils/Placeholder.h"
+
+#define BATCH_SZ 1024
+
+/*
+ * Raw temperatures covering positive and negative ranges with all
+ * combinations of the least significant bits.
+ */
+static const uint16_t RAWS[] = {
+    0x0000, 0x0001, 0x0002, 0x0003, 0x0004, 0x0007, 0x0008, 0x000f,
+    0x0010, 0x0191, 0x07d0, 0x0550, 0x00a2, 0x0640, 0x3e81, 0x644e,
+    0xffff, 0xfffe, 0xfffc, 0xfff8, 0xfff1, 0xff5e, 0xfe6f, 0xfc90,
+    0xf063, 0xc9f0, 0x8001, 0x7fff
+};
+
+class DSThermBatch_Test: OneWireNg
+{
+public:
+    static void test_dstherm()
+    {
+        DSThermBatch_Test ow;
+        DSThermBatch<BATCH_SZ> batch;
+        Placeholder<DSTherm::Scratchpad> scrpds[BATCH_SZ];
+        size_t n = 0;
+
+        OneWireNg::Id id = {};
+        uint8_t raw[DSTherm::Scratchpad::LENGTH] = {};
+
+        /* DS18B20 with all resolutions */
+        id[0] = DSTherm::DS18B20;
+        for (int res = 0; res < 4; res++) {
+            for (size_t i = 0; i < TAB_SZ(RAWS); i++) {
+                raw[0] = RAWS[i] & 0xff;
+                raw[1] = RAWS[i] >> 8;
+                raw[4] = (uint8_t)((res << 5) | 0x1f);
+                add(batch, scrpds[n++], ow, id, raw);
+            }
+        }
+
+        /* DS18S20 with standard and extended resolution */
+        id[0] = DSTherm::DS18S20;
+        raw[4] = 0xff;
+        for (int perC = 0; perC <= 16; perC += 16) {
+            for (int remain = 0; remain <= 16; remain += 3) {
+                for (size_t i = 0; i < TAB_SZ(RAWS); i++) {
+                    raw[0] = RAWS[i] & 0xff;
+                    raw[1] = RAWS[i] >> 8;
+                    raw[6] = (uint8_t)remain;
+                    raw[7] = (uint8_t)perC;
+                    add(batch, scrpds[n++], ow, id, raw);
+                }
+            }
+        }
+        assert(batch.size() == n);
+
+        long temps[BATCH_SZ], temps2[BATCH_SZ];
+        float tempsf[BATCH_SZ];
+        batch.decodeTemp(temps);
+        batch.decodeTemp2(temps2);
+        batch.decodeTempFloat(tempsf);
+
+        for (size_t i = 0; i < n; i++) {
+            assert(temps[i] == scrpds[i]->getTemp());
+            assert(temps2[i] == scrpds[i]->getTemp2());
+            assert(tempsf[i] == (float)scrpds[i]->getTemp2() / 16);
+        }
+
+        batch.clear();
+        assert(!batch.size());
+
+        TEST_SUCCESS();
+    }
+
+    static void test_max31850()
+    {
+        DSThermBatch_Test ow;
+        typedef DSThermBatch<2 * TAB_SZ(RAWS)> Batch;
+        Batch batch;
+        Placeholder<MAX31850::Scratchpad> scrpds[TAB_SZ(RAWS)];
+
+        OneWireNg::Id id = { MAX31850::FAMILY_CODE };
+        uint8_t raw[MAX31850::Scratchpad::LENGTH] = {};
+
+        for (size_t i = 0; i < TAB_SZ(RAWS); i++) {
+            raw[0] = RAWS[i] & 0xff;
+            raw[1] = RAWS[i] >> 8;
+            raw[2] = RAWS[TAB_SZ(RAWS) - 1 - i] & 0xff;
+            raw[3] = RAWS[TAB_SZ(RAWS) - 1 - i] >> 8;
+            new (&scrpds[i]) MAX31850::Scratchpad(ow, id, raw);
+            assert(batch.add(*scrpds[i]));
+            assert(batch.add(*scrpds[i], true));
+        }
+        assert(batch.size() == 2 * TAB_SZ(RAWS));
+        assert(batch.getFormat(0) == Batch::FMT_MAX31850 &&
+            batch.getFormat(1) == Batch::FMT_MAX31850_INT);
+
+        long temps[2 * TAB_SZ(RAWS)], temps2[2 * TAB_SZ(RAWS)];
+        batch.decodeTemp(temps);
+        batch.decodeTemp2(temps2);
+
+        for (size_t i = 0; i < TAB_SZ(RAWS); i++) {
+            assert(temps[2 * i] == scrpds[i]->getTemp());
+            assert(temps2[2 * i] == scrpds[i]->getTemp2());
+            assert(temps[2 * i + 1] == scrpds[i]->getTempInternal());
+            assert(temps2[2 * i + 1] == scrpds[i]->getTempInternal2());
+        }
+
+        TEST_SUCCESS();
+    }
+
+    static void test_full()
+    {
+        DSThermBatch_Test ow;
+        DSThermBatch<2> batch;
+        OneWireNg::Id id = { DSTherm::DS18B20 };
+        uint8_t raw[DSTherm::Scratchpad::LENGTH] = { 0x91, 0x01 };
+        DSTherm::Scratchpad scrpd(ow, id, raw);
+
+        assert(batch.add(scrpd) && batch.add(scrpd));
+        assert(!batch.add(scrpd) && batch.size() == 2);
+        assert(batch.getRaw(1) == 0x0191 &&
+            batch.getFormat(1) == DSThermBatch<2>::FMT_DSTHERM);
+
+        TEST_SUCCESS();
+    }
+
+private:
+    DSThermBatch_Test() {}
+
+    template<size_t N>
+    static void add(DSThermBatch<N>& batch,
+        Placeholder<DSTherm::Scratchpad>& scrpd, OneWireNg& ow,
+        const OneWireNg::Id& id, const uint8_t *raw)
+    {
+        new (&scrpd) DSTherm::Scratchpad(ow, id, raw);
+        assert(batch.add(*scrpd));
+    }
+
+    ErrorCode reset() {
+        return OneWireNg::EC_SUCCESS;
+    }
+
+    int touchBit(int bit, bool power) {
+        (void)power;
+        return bit;
+    }
+};
+
+int main(void)
+{
+    DSThermBatch_Test::test_dstherm();
+    DSThermBatch_Test::test_max31850();
+    DSThermBatch_Test::test_full();
+
+    return 0;
+}
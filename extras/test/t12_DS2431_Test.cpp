@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include <time.h>
+#include "common.h"
+#include "sim_ds2431.h"
+
+#define JIG_SIZE 16
+
+class DS2431_Test
+{
+public:
+    static void test_readWrite()
+    {
+        OneWireNg::Id id;
+        setId(id, DS2431::FAMILY_CODE, 1);
+
+        SimBus bus;
+        SimDS2431 eeprom(id);
+        bus.attach(&eeprom);
+
+        DS2431 ds(bus, id);
+        uint8_t img[DS2431::DATA_SIZE];
+        for (size_t i = 0; i < sizeof(img); i++)
+            img[i] = (uint8_t)i;
+
+        /* whole image: single read of unknown rows, all rows stored */
+        assert(ds.write(0, img, sizeof(img)) == OneWireNg::EC_SUCCESS);
+        assert(ds.isDirty() && !eeprom.nWrites);
+        assert(ds.flush() == OneWireNg::EC_SUCCESS);
+        assert(!ds.isDirty());
+        assert(eeprom.nMemReads == 1 && eeprom.nCopies == 16);
+        assert(!memcmp(eeprom.getMem(), img, sizeof(img)));
+
+        /* unchanged rows are skipped */
+        unsigned long nResets = bus.nResets;
+        assert(ds.write(0, img, sizeof(img)) == OneWireNg::EC_SUCCESS);
+        assert(!ds.isDirty());
+        assert(ds.flush() == OneWireNg::EC_SUCCESS);
+        assert(bus.nResets == nResets && eeprom.nCopies == 16);
+
+        /* partial write spanning 2 rows */
+        uint8_t data[4] = { 0xde, 0xad, 0xbe, 0xef };
+        assert(ds.write(0x26, data, sizeof(data)) == OneWireNg::EC_SUCCESS);
+        assert(ds.flush() == OneWireNg::EC_SUCCESS);
+        assert(eeprom.nMemReads == 1 && eeprom.nCopies == 18);
+        memcpy(&img[0x26], data, sizeof(data));
+        assert(!memcmp(eeprom.getMem(), img, sizeof(img)));
+
+        /* streamed read of the whole memory */
+        uint8_t mem[DS2431::MEM_SIZE];
+        assert(ds.read(0, mem, sizeof(mem)) == OneWireNg::EC_SUCCESS);
+        assert(!memcmp(mem, eeprom.getMem(), sizeof(mem)));
+
+        /* unaligned write to a row with unknown content loads it first */
+        DS2431 ds2(bus, id);
+        data[0] = 0x5a;
+        assert(ds2.write(0x41, data, 1) == OneWireNg::EC_SUCCESS);
+        assert(ds2.flush() == OneWireNg::EC_SUCCESS);
+        img[0x41] = 0x5a;
+        assert(!memcmp(eeprom.getMem(), img, sizeof(img)));
+
+        /* out of range */
+        assert(ds.write(DS2431::MEM_SIZE - DS2431::ROW_SIZE, data, 1) ==
+            OneWireNg::EC_UNSUPPORED);
+        assert(ds.read(DS2431::MEM_SIZE, data, 1) ==
+            OneWireNg::EC_UNSUPPORED);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_protection()
+    {
+        OneWireNg::Id id;
+        setId(id, DS2431::FAMILY_CODE, 2);
+
+        SimBus bus;
+        SimDS2431 eeprom(id);
+        bus.attach(&eeprom);
+
+        DS2431 ds(bus, id);
+        DS2431::Protection prot;
+        assert(ds.getProtection(1, prot) == OneWireNg::EC_SUCCESS &&
+            prot == DS2431::PROT_NONE);
+
+        /* EPROM mode: bits may be cleared only */
+        assert(ds.setProtection(1, DS2431::PROT_EPROM) ==
+            OneWireNg::EC_SUCCESS);
+        assert(ds.getProtection(1, prot) == OneWireNg::EC_SUCCESS &&
+            prot == DS2431::PROT_EPROM);
+
+        uint8_t row[DS2431::ROW_SIZE];
+        memset(row, 0x0f, sizeof(row));
+        assert(ds.write(DS2431::PAGE_SIZE, row, sizeof(row)) ==
+            OneWireNg::EC_SUCCESS);
+        assert(ds.flush() == OneWireNg::EC_SUCCESS);
+        memset(row, 0xf3, sizeof(row));
+        assert(ds.write(DS2431::PAGE_SIZE, row, sizeof(row)) ==
+            OneWireNg::EC_SUCCESS);
+        assert(ds.flush() == OneWireNg::EC_SUCCESS);
+        assert(ds.read(DS2431::PAGE_SIZE, row, sizeof(row)) ==
+            OneWireNg::EC_SUCCESS);
+        assert(row[0] == 0x03 && row[7] == 0x03);
+
+        /* write protected page */
+        assert(ds.setProtection(2, DS2431::PROT_WRITE) ==
+            OneWireNg::EC_SUCCESS);
+        int nCopies = eeprom.nCopies;
+        assert(ds.write(2 * DS2431::PAGE_SIZE, row, sizeof(row)) ==
+            OneWireNg::EC_SUCCESS);
+        assert(ds.flush() == OneWireNg::EC_UNSUPPORED);
+        assert(ds.isDirty() && eeprom.nCopies == nCopies);
+
+        /* protection bypassed by the cache is detected by the read-back */
+        DS2431 ds2(bus, id);
+        ds2._valid = ~(DS2431::RowsMask)0;
+        memset(ds2._mem, 0, sizeof(ds2._mem));
+        assert(ds2.write(2 * DS2431::PAGE_SIZE, row, sizeof(row)) ==
+            OneWireNg::EC_SUCCESS);
+        assert(ds2.flush() == OneWireNg::EC_UNSUPPORED);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_overdrive()
+    {
+        OneWireNg::Id id;
+        setId(id, DS2431::FAMILY_CODE, 3);
+
+        SimBus bus;
+        SimDS2431 eeprom(id);
+        bus.attach(&eeprom);
+
+        DS2431 ds(bus, id, true);
+        uint8_t data[DS2431::ROW_SIZE] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        assert(ds.write(0, data, sizeof(data)) == OneWireNg::EC_SUCCESS);
+        assert(ds.flush() == OneWireNg::EC_SUCCESS);
+        assert(!memcmp(eeprom.getMem(), data, sizeof(data)));
+
+        /* standard mode restored */
+        assert(!bus.isOverdrive());
+
+        TEST_SUCCESS();
+    }
+
+    static void test_flushAll()
+    {
+        OneWireNg::Id id[JIG_SIZE];
+        SimDS2431 *eeprom[JIG_SIZE];
+        DS2431 *ds[JIG_SIZE];
+        uint8_t img[JIG_SIZE][DS2431::DATA_SIZE];
+
+        SimBus bus;
+        for (int i = 0; i < JIG_SIZE; i++) {
+            setId(id[i], DS2431::FAMILY_CODE, (uint8_t)(0x10 + i));
+            eeprom[i] = new SimDS2431(id[i]);
+            bus.attach(eeprom[i]);
+            ds[i] = new DS2431(bus, id[i]);
+
+            for (size_t j = 0; j < DS2431::DATA_SIZE; j++)
+                img[i][j] = (uint8_t)(i * 7 + j);
+            assert(ds[i]->write(0, img[i], DS2431::DATA_SIZE) ==
+                OneWireNg::EC_SUCCESS);
+        }
+        /* row 0 of the first device is already programmed */
+        memcpy(eeprom[0]->getMem(), img[0], DS2431::ROW_SIZE);
+
+        struct timespec ts, te;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        assert(DS2431::flushAll(ds, JIG_SIZE) == OneWireNg::EC_SUCCESS);
+        clock_gettime(CLOCK_MONOTONIC, &te);
+
+        /* programming time spent once per row */
+        long ms = (te.tv_sec - ts.tv_sec) * 1000L +
+            (te.tv_nsec - ts.tv_nsec) / 1000000L;
+        assert(ms < (long)(JIG_SIZE * DS2431::PROG_TIME * JIG_SIZE / 2));
+
+        for (int i = 0; i < JIG_SIZE; i++) {
+            assert(!ds[i]->isDirty());
+            assert(!memcmp(eeprom[i]->getMem(), img[i], DS2431::DATA_SIZE));
+            assert(eeprom[i]->nWrites == (!i ? 15 : 16));
+        }
+
+        /* write protected row detected before programming */
+        eeprom[3]->getMem()[DS2431::ADDR_PAGE_PROT + 3] = DS2431::PROT_WRITE;
+        ds[3]->invalidate();
+        for (int i = 0; i < JIG_SIZE; i++) {
+            img[i][DS2431::DATA_SIZE - 1] ^= 0xff;
+            assert(ds[i]->write(DS2431::DATA_SIZE - 1,
+                &img[i][DS2431::DATA_SIZE - 1], 1) == OneWireNg::EC_SUCCESS);
+        }
+        assert(DS2431::flushAll(ds, JIG_SIZE) == OneWireNg::EC_UNSUPPORED);
+        assert(eeprom[0]->nWrites == 15);
+
+        for (int i = 0; i < JIG_SIZE; i++) {
+            delete ds[i];
+            delete eeprom[i];
+        }
+
+        TEST_SUCCESS();
+    }
+
+    static void test_cachedFlush()
+    {
+        OneWireNg::Id idA, idB;
+        setId(idA, DS2431::FAMILY_CODE, 5);
+        setId(idB, DS2431::FAMILY_CODE, 6);
+
+        SimBus bus;
+        SimDS2431 eeA(idA), eeB(idB);
+        bus.attach(&eeA);
+        bus.attach(&eeB);
+
+        DS2431 a(bus, idA), b(bus, idB);
+        uint8_t mem[DS2431::MEM_SIZE];
+
+        /* whole memories cached; B accessed last */
+        assert(a.read(0, mem, sizeof(mem)) == OneWireNg::EC_SUCCESS);
+        assert(b.read(0, mem, sizeof(mem)) == OneWireNg::EC_SUCCESS);
+        uint8_t memB[DS2431::DATA_SIZE];
+        memcpy(memB, eeB.getMem(), sizeof(memB));
+
+        /* no bus access while preparing; A must be addressed anyway */
+        uint8_t row[DS2431::ROW_SIZE];
+        for (size_t i = 0; i < sizeof(row); i++)
+            row[i] = (uint8_t)(i + 1);
+        assert(a.write(0, row, sizeof(row)) == OneWireNg::EC_SUCCESS);
+        assert(a.flush() == OneWireNg::EC_SUCCESS);
+
+        assert(!memcmp(eeA.getMem(), row, sizeof(row)));
+        assert(!memcmp(eeB.getMem(), memB, sizeof(memB)));
+        assert(!eeB.nWrites && eeA.nCopies == 1);
+
+        TEST_SUCCESS();
+    }
+
+    static void test_noDevs()
+    {
+        OneWireNg::Id id;
+        setId(id, DS2431::FAMILY_CODE, 4);
+
+        SimBus bus;
+        DS2431 ds(bus, id);
+        uint8_t data[2] = {};
+
+        assert(ds.write(0, data, sizeof(data)) == OneWireNg::EC_NO_DEVS);
+        assert(ds.read(0, data, sizeof(data)) == OneWireNg::EC_NO_DEVS);
+
+        TEST_SUCCESS();
+    }
+};
+
+int main(void)
+{
+    DS2431_Test::test_readWrite();
+    DS2431_Test::test_protection();
+    DS2431_Test::test_overdrive();
+    DS2431_Test::test_flushAll();
+    DS2431_Test::test_cachedFlush();
+    DS2431_Test::test_noDevs();
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_memdev.h"
+
+/* sink context: received memory image */
+struct Image
+{
+    uint8_t mem[8192];
+    size_t len;
+    int chunks;
+    int stopAfter;
+};
+
+static bool sink(unsigned addr, const uint8_t *data, size_t len, void *arg)
+{
+    Image *img = (Image*)arg;
+
+    /* chunks are contiguous and do not cross pages */
+    assert(addr == img->len && len <= MemDevice::MAX_PAGE_SIZE);
+    memcpy(&img->mem[addr], data, len);
+    img->len += len;
+
+    return (++img->chunks != img->stopAfter);
+}
+
+static void readImage(MemDevice& dev, unsigned addr, size_t len,
+    Image& img, OneWireNg::ErrorCode ecExp)
+{
+    memset(&img, 0, sizeof(img));
+    img.len = addr;
+    img.stopAfter = -1;
+    assert(dev.read(addr, len, sink, &img) == ecExp);
+}
+
+static void test_read()
+{
+    OneWireNg::Id id;
+    setId(id, 0x0c, 1);     /* DS1996 */
+
+    SimBus bus;
+    SimMemDevice sim(id);
+    bus.attach(&sim);
+
+    MemDevice dev(bus, id);
+    assert(dev.getGeometry() && dev.getGeometry()->size == 8192);
+    assert(!strcmp(MemDevice::getFamilyName(id), "DS1996"));
+
+    /* the whole memory streamed by a single command */
+    Image img;
+    unsigned long nResets = bus.nResets;
+    readImage(dev, 0, 8192, img, OneWireNg::EC_SUCCESS);
+    assert(bus.nResets == nResets + 1);
+    assert(img.len == 8192 && img.chunks == 8192 / 32);
+    assert(!memcmp(img.mem, sim.getMem(), 8192));
+
+    /* unaligned range */
+    readImage(dev, 100, 70, img, OneWireNg::EC_SUCCESS);
+    assert(img.len == 170 && img.chunks == 3);
+    assert(!memcmp(&img.mem[100], &sim.getMem()[100], 70));
+
+    /* stopped by the sink */
+    memset(&img, 0, sizeof(img));
+    img.stopAfter = 2;
+    assert(dev.read(0, 8192, sink, &img) == OneWireNg::EC_SUCCESS);
+    assert(img.len == 64);
+
+    readImage(dev, 8000, 200, img, OneWireNg::EC_UNSUPPORED);
+
+    TEST_SUCCESS();
+}
+
+static void test_readCrc()
+{
+    OneWireNg::Id id;
+    setId(id, 0x43, 2);     /* DS28EC20 */
+
+    SimBus bus;
+    SimMemDevice sim(id);
+    bus.attach(&sim);
+
+    MemDevice dev(bus, id);
+    Image img;
+
+    readImage(dev, 0, 2560, img, OneWireNg::EC_SUCCESS);
+    assert(img.len == 2560 && !memcmp(img.mem, sim.getMem(), 2560));
+    /* CRC-16 per page */
+    assert(sim.nBytes == 2560 + 2 * (2560 / 32));
+
+    /* unaligned start: 1st page CRC covers partial page */
+    readImage(dev, 45, 40, img, OneWireNg::EC_SUCCESS);
+    assert(img.len == 85 && !memcmp(&img.mem[45], &sim.getMem()[45], 40));
+
+    /* corrupted page: preceding pages passed to the sink */
+    sim.errPage = 3;
+    readImage(dev, 0, 2560, img, OneWireNg::EC_CRC_ERROR);
+    assert(img.len == 3 * 32);
+
+    TEST_SUCCESS();
+}
+
+static void test_readCrc8()
+{
+    OneWireNg::Id id;
+    setId(id, 0x0b, 4);     /* DS2505 */
+
+    SimBus bus;
+    SimMemDevice sim(id);
+    bus.attach(&sim);
+
+    MemDevice dev(bus, id);
+    Image img;
+
+    readImage(dev, 0, 2048, img, OneWireNg::EC_SUCCESS);
+    assert(img.len == 2048 && !memcmp(img.mem, sim.getMem(), 2048));
+    /* CRC-8 of the command and address, CRC-8 per page */
+    assert(sim.nBytes == 1 + 2048 + (2048 / 32));
+
+    /* unaligned start: 1st page CRC covers partial page */
+    readImage(dev, 45, 40, img, OneWireNg::EC_SUCCESS);
+    assert(img.len == 85 && !memcmp(&img.mem[45], &sim.getMem()[45], 40));
+
+    /* corrupted page: preceding pages passed to the sink */
+    sim.errPage = 5;
+    readImage(dev, 0, 2048, img, OneWireNg::EC_CRC_ERROR);
+    assert(img.len == 5 * 32);
+
+    TEST_SUCCESS();
+}
+
+static void test_unsupported()
+{
+    OneWireNg::Id id;
+    setId(id, 0x28, 3);     /* DS18B20 */
+
+    SimBus bus;
+    MemDevice dev(bus, id);
+    Image img;
+
+    assert(!dev.getGeometry() && !MemDevice::getFamilyName(id));
+    readImage(dev, 0, 1, img, OneWireNg::EC_UNSUPPORED);
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_read();
+    test_readCrc();
+    test_readCrc8();
+    test_unsupported();
+
+    return 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_ds28ea00.h"
+#include "sim_dstherm.h"
+
+#define CHAIN_LEN 6
+
+/* sensors serial numbers in the chain order */
+static const uint8_t CHAIN_SN[CHAIN_LEN] = { 0x35, 0x07, 0x81, 0x22, 0x10, 0x5c };
+
+static void test_chain()
+{
+    OneWireNg::Id id[CHAIN_LEN];
+    SimDS28EA00 *sens[CHAIN_LEN];
+
+    for (int i = 0; i < CHAIN_LEN; i++) {
+        setId(id[i], DS28EA00::FAMILY_CODE, CHAIN_SN[i]);
+        sens[i] = new SimDS28EA00(id[i], (i ? sens[i - 1] : NULL));
+    }
+
+    /* other device on the bus (not taking part in the chain) */
+    OneWireNg::Id thId;
+    setId(thId, DSTherm::DS18B20, 1);
+    SimDSTherm therm(thId);
+
+    SimBus bus;
+    bus.attach(&therm);
+    for (int i = CHAIN_LEN - 1; i >= 0; i--)
+        bus.attach(sens[i]);
+
+    DS28EA00 drv(bus);
+    OneWireNg::Id ids[CHAIN_LEN];
+    size_t n;
+
+    unsigned long nResets = bus.nResets;
+    assert(drv.discoverChain(ids, CHAIN_LEN, n) == OneWireNg::EC_SUCCESS);
+    assert(n == CHAIN_LEN);
+
+    /* physical order; single id read per sensor (plus chain on/off) */
+    for (int i = 0; i < CHAIN_LEN; i++)
+        assert(!memcmp(ids[i], id[i], sizeof(OneWireNg::Id)));
+    assert(bus.nResets == nResets + CHAIN_LEN + 3);
+
+    /* chain mode turned off */
+    for (int i = 0; i < CHAIN_LEN; i++)
+        assert(!sens[i]->chainActive() && !sens[i]->isDone());
+
+    /* output table too small */
+    assert(drv.discoverChain(ids, CHAIN_LEN - 2, n) == OneWireNg::EC_FULL);
+    assert(n == CHAIN_LEN - 2);
+    assert(!memcmp(ids[CHAIN_LEN - 3], id[CHAIN_LEN - 3],
+        sizeof(OneWireNg::Id)));
+
+    for (int i = 0; i < CHAIN_LEN; i++)
+        delete sens[i];
+
+    TEST_SUCCESS();
+}
+
+static void test_pio()
+{
+    OneWireNg::Id id;
+    setId(id, DS28EA00::FAMILY_CODE, 1);
+
+    SimBus bus;
+    SimDS28EA00 sens(id);
+    bus.attach(&sens);
+
+    DS28EA00 drv(bus);
+    uint8_t state;
+
+    assert(drv.readPio(id, state) == OneWireNg::EC_SUCCESS);
+    assert(state == (DS28EA00::PIOA | DS28EA00::PIOB));
+
+    assert(drv.writePio(id, DS28EA00::PIOB) == OneWireNg::EC_SUCCESS);
+    assert(drv.readPio(id, state) == OneWireNg::EC_SUCCESS);
+    assert(state == DS28EA00::PIOB);
+
+    /* PIO writes rejected in the chain mode */
+    assert(drv.chainOn() == OneWireNg::EC_SUCCESS);
+    assert(drv.writePio(id, 0) == OneWireNg::EC_BUS_ERROR);
+    assert(drv.chainOff() == OneWireNg::EC_SUCCESS);
+
+    bus.detachAll();
+    assert(drv.readPio(id, state) == OneWireNg::EC_NO_DEVS);
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_chain();
+    test_pio();
+
+    return 0;
+}
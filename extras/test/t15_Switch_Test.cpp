@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_switch.h"
+
+#define SAMPLES_NUM 100
+
+static void test_ds2408()
+{
+    OneWireNg::Id id;
+    setId(id, DS2408::FAMILY_CODE, 1);
+
+    SimBus bus;
+    SimDS2408 sim(id);
+    bus.attach(&sim);
+
+    DS2408 sw(bus, id);
+    uint8_t smpls[SAMPLES_NUM];
+
+    /* samples streamed after single addressing */
+    unsigned long nResets = bus.nResets;
+    assert(sw.readStream(smpls, SAMPLES_NUM) == OneWireNg::EC_SUCCESS);
+    assert(bus.nResets == nResets + 1);
+    for (unsigned long k = 0; k < SAMPLES_NUM; k++)
+        assert(smpls[k] == SimSwitch::input(k));
+
+    /* last block read up to its end to verify CRC */
+    assert(sim.nSamples == 4 * DS2408::CRC_BLOCK);
+
+    /* corrupted sample */
+    sim.nSamples = 0;
+    sim.errSample = 40;
+    memset(smpls, 0, sizeof(smpls));
+    assert(sw.readStream(smpls, SAMPLES_NUM) == OneWireNg::EC_CRC_ERROR);
+    assert(smpls[DS2408::CRC_BLOCK - 1] ==
+        SimSwitch::input(DS2408::CRC_BLOCK - 1));
+    sim.errSample = -1;
+
+    /* outputs streaming with pins state sampled after each write */
+    const uint8_t states[3] = { 0x0f, 0xf0, 0x3c };
+    uint8_t pins[3];
+    sim.nSamples = 0;
+    assert(sw.writeStream(states, 3, pins) == OneWireNg::EC_SUCCESS);
+    assert(sim.getLatch() == 0x3c);
+    for (unsigned long k = 0; k < 3; k++)
+        assert(pins[k] == (SimSwitch::input(k) & states[k]));
+
+    uint8_t state;
+    assert(sw.readPio(state) == OneWireNg::EC_SUCCESS);
+    assert(state == (SimSwitch::input(3) & 0x3c));
+    assert(sw.resetActivity() == OneWireNg::EC_SUCCESS);
+
+    bus.detachAll();
+    assert(sw.readPio(state) == OneWireNg::EC_NO_DEVS);
+
+    TEST_SUCCESS();
+}
+
+static void test_ds2413()
+{
+    OneWireNg::Id id;
+    setId(id, DS2413::FAMILY_CODE, 2);
+
+    SimBus bus;
+    SimDS2413 sim(id);
+    bus.attach(&sim);
+
+    DS2413 sw(bus, id);
+    uint8_t smpls[SAMPLES_NUM], latches[SAMPLES_NUM];
+
+    unsigned long nResets = bus.nResets;
+    assert(sw.readStream(smpls, SAMPLES_NUM, latches) ==
+        OneWireNg::EC_SUCCESS);
+    assert(bus.nResets == nResets + 1 && sim.nSamples == SAMPLES_NUM);
+    for (unsigned long k = 0; k < SAMPLES_NUM; k++) {
+        assert(smpls[k] == (SimSwitch::input(k) & 3));
+        assert(latches[k] == 3);
+    }
+
+    /* outputs */
+    const uint8_t states[2] = { DS2413::PIOB, DS2413::PIOA };
+    assert(sw.writeStream(states, 2) == OneWireNg::EC_SUCCESS);
+    assert((sim.getLatch() & 3) == DS2413::PIOA);
+
+    sim.nSamples = 0;
+    assert(sw.readStream(smpls, 1, latches) == OneWireNg::EC_SUCCESS);
+    assert(smpls[0] == (SimSwitch::input(0) & DS2413::PIOA));
+    assert(latches[0] == DS2413::PIOA);
+
+    /* corrupted sample */
+    sim.nSamples = 0;
+    sim.errSample = 10;
+    assert(sw.readStream(smpls, SAMPLES_NUM) == OneWireNg::EC_CRC_ERROR);
+    assert(sim.nSamples == 11);
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_ds2408();
+    test_ds2413();
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_ds2438.h"
+
+#define MONITORS_NUM 16
+
+static void test_single()
+{
+    OneWireNg::Id id;
+    setId(id, DS2438::FAMILY_CODE, 1);
+
+    SimBus bus;
+    SimDS2438 sim(id);
+    bus.attach(&sim);
+
+    DS2438 ds(bus);
+    DS2438::Status st;
+
+    /* 25.5 C, VAD: 1.23V, VDD: 4.56V */
+    sim.setInputs(25 * 256 + 128, 123, 456, -100);
+
+    assert(ds.convertTemp(id) == OneWireNg::EC_SUCCESS);
+    assert(ds.convertVoltage(id) == OneWireNg::EC_SUCCESS);
+    assert(ds.readStatus(id, st) == OneWireNg::EC_SUCCESS);
+    assert(!memcmp(st.getId(), id, sizeof(OneWireNg::Id)));
+    assert(st.getTemp() == 25500);
+    assert(st.getVoltage() == 1230);
+    assert(st.getCurrent() == -100);
+
+    /* switch voltage input to VDD, threshold preserved */
+    uint8_t page[DS2438::PAGE_SIZE];
+    sim.setInputs(-(10 * 256 + 128), 123, 456, 0);
+    assert(ds.setConfig(id, DS2438::CFG_AD | DS2438::CFG_IAD) ==
+        OneWireNg::EC_SUCCESS);
+    assert(sim.getPage(0)[0] == (DS2438::CFG_AD | DS2438::CFG_IAD));
+
+    assert(ds.convertTemp(id, 5) == OneWireNg::EC_SUCCESS);
+    assert(ds.convertVoltage(id, 0) == OneWireNg::EC_SUCCESS);
+    assert(ds.readPage(id, 0, page) == OneWireNg::EC_SUCCESS);
+    assert(!memcmp(page, sim.getPage(0), DS2438::PAGE_SIZE));
+
+    assert(ds.readStatus(id, st) == OneWireNg::EC_SUCCESS);
+    assert(st.getTemp() == -10500);
+    assert(st.getVoltage() == 4560);
+    assert(st.getConfig() == (DS2438::CFG_AD | DS2438::CFG_IAD));
+
+    sim.crcErr = true;
+    assert(ds.readStatus(id, st) == OneWireNg::EC_CRC_ERROR);
+
+    bus.detachAll();
+    assert(ds.readPage(id, 1, page) == OneWireNg::EC_NO_DEVS);
+
+    TEST_SUCCESS();
+}
+
+static void test_batch()
+{
+    OneWireNg::Id ids[MONITORS_NUM];
+    SimDS2438 *sims[MONITORS_NUM];
+
+    SimBus bus;
+    DS2438 ds(bus);
+    DS2438::Status st[MONITORS_NUM];
+    OneWireNg::ErrorCode ecs[MONITORS_NUM];
+
+    for (int i = 0; i < MONITORS_NUM; i++) {
+        setId(ids[i], DS2438::FAMILY_CODE, (uint8_t)(i + 1));
+        sims[i] = new SimDS2438(ids[i]);
+        sims[i]->busySlots = i;
+        sims[i]->setInputs((int16_t)(i * 256), (uint16_t)(100 + i), 0,
+            (int16_t)i);
+        bus.attach(sims[i]);
+    }
+
+    /* conversions and page 0 recall addressing all monitors at once */
+    unsigned long nResets = bus.nResets;
+    assert(ds.convertAll() == OneWireNg::EC_SUCCESS);
+    assert(ds.readStatusAll(ids, MONITORS_NUM, st, ecs) ==
+        OneWireNg::EC_SUCCESS);
+    assert(bus.nResets == nResets + 3 + MONITORS_NUM);
+
+    for (int i = 0; i < MONITORS_NUM; i++) {
+        assert(sims[i]->nConvT == 1 && sims[i]->nConvV == 1);
+        assert(sims[i]->nRecalls == 1);
+        assert(ecs[i] == OneWireNg::EC_SUCCESS);
+        assert(!memcmp(st[i].getId(), ids[i], sizeof(OneWireNg::Id)));
+        assert(st[i].getTemp() == i * 1000);
+        assert(st[i].getVoltage() == (unsigned)(100 + i) * 10);
+        assert(st[i].getCurrent() == i);
+    }
+
+    /* failed monitor doesn't stop the sweep */
+    sims[3]->crcErr = true;
+    assert(ds.readStatusAll(ids, MONITORS_NUM, st, ecs) ==
+        OneWireNg::EC_CRC_ERROR);
+    for (int i = 0; i < MONITORS_NUM; i++) {
+        assert(ecs[i] == (i == 3 ?
+            OneWireNg::EC_CRC_ERROR : OneWireNg::EC_SUCCESS));
+    }
+
+    bus.detachAll();
+    for (int i = 0; i < MONITORS_NUM; i++)
+        delete sims[i];
+
+    assert(ds.convertAll() == OneWireNg::EC_NO_DEVS);
+    assert(ds.readStatusAll(ids, MONITORS_NUM, st) == OneWireNg::EC_NO_DEVS);
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_single();
+    test_batch();
+
+    return 0;
+}
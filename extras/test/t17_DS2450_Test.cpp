@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_ds2450.h"
+
+#define DEVS_NUM 8
+#define SAMPLES_NUM 5
+
+static void test_single()
+{
+    OneWireNg::Id id;
+    setId(id, DS2450::FAMILY_CODE, 1);
+
+    SimBus bus;
+    SimDS2450 sim(id);
+    bus.attach(&sim);
+
+    DS2450 adc(bus);
+    uint16_t res[DS2450::CHANNELS_NUM] = { 1, 1, 1, 1 };
+
+    for (int ch = 0; ch < DS2450::CHANNELS_NUM; ch++)
+        sim.setInput(ch, (uint16_t)(0x1234 * (ch + 1)));
+
+    /* 16-bit channel A, 12-bit channel C at 5.12V range */
+    assert(adc.setChannel(id, 0, 16, DS2450::RANGE_2_56V) ==
+        OneWireNg::EC_SUCCESS);
+    assert(adc.setChannel(id, 2, 12, DS2450::RANGE_5_12V) ==
+        OneWireNg::EC_SUCCESS);
+    assert(sim.getMem()[DS2450::ADDR_CONTROL] == 0x00);
+    assert(sim.getMem()[DS2450::ADDR_CONTROL + 1] == 0x8c);
+    assert(sim.getMem()[DS2450::ADDR_CONTROL + 4] == 0x0c);
+    assert(sim.getMem()[DS2450::ADDR_CONTROL + 5] == 0x8d);
+    assert(adc.setChannel(id, 4, 8, DS2450::RANGE_2_56V) ==
+        OneWireNg::EC_UNSUPPORED);
+
+    /* channel B preset to ones */
+    assert(adc.convert(id, DS2450::CH_A | DS2450::CH_C,
+        DS2450::SCAN_BUS, 0x08) == OneWireNg::EC_SUCCESS);
+    assert(sim.nConv == 1);
+    assert(adc.readResults(id, DS2450::CH_ALL, res) == OneWireNg::EC_SUCCESS);
+    assert(res[0] == 0x1234);
+    assert(res[1] == 0xffff);
+    assert(res[2] == (0x1234 * 3 & 0xfff0));
+    assert(res[3] == 0);
+
+    /* partial read starting from channel C */
+    memset(res, 0, sizeof(res));
+    assert(adc.readResults(id, DS2450::CH_C, res) == OneWireNg::EC_SUCCESS);
+    assert(res[0] == 0 && res[1] == 0 && res[2] == (0x1234 * 3 & 0xfff0));
+
+    assert(DS2450::getVoltage(0x8000, DS2450::RANGE_5_12V) == 2560);
+    assert(DS2450::getVoltage(0xffff, DS2450::RANGE_2_56V) == 2559);
+    assert(DS2450::getConversionTime(DS2450::CH_ALL, 16) ==
+        DS2450::MAX_CONV_TIME);
+    assert(DS2450::getConversionTime(DS2450::CH_A, 8) == 1);
+
+    /* VCC powered mode */
+    uint8_t vcc = DS2450::VCC_POWERED;
+    assert(adc.writeMemory(id, DS2450::ADDR_VCC_CTRL, &vcc, 1) ==
+        OneWireNg::EC_SUCCESS);
+    assert(sim.getMem()[DS2450::ADDR_VCC_CTRL] == DS2450::VCC_POWERED);
+
+    /* results page is read only */
+    assert(adc.writeMemory(id, DS2450::ADDR_RESULTS, &vcc, 1) ==
+        OneWireNg::EC_BUS_ERROR);
+    uint8_t buf[4];
+    assert(adc.readMemory(id, 30, buf, sizeof(buf)) ==
+        OneWireNg::EC_UNSUPPORED);
+
+    sim.crcErr = true;
+    assert(adc.convert(id) == OneWireNg::EC_CRC_ERROR);
+    assert(adc.readResults(id, DS2450::CH_ALL, res) ==
+        OneWireNg::EC_CRC_ERROR);
+
+    bus.detachAll();
+    assert(adc.convert(id) == OneWireNg::EC_NO_DEVS);
+
+    TEST_SUCCESS();
+}
+
+typedef struct {
+    unsigned long n;
+    uint16_t last[DEVS_NUM];
+    unsigned long stopAt;
+} SinkCtx;
+
+static bool sink(size_t dev, const uint16_t *results, void *arg)
+{
+    SinkCtx *ctx = (SinkCtx*)arg;
+    assert(dev < DEVS_NUM);
+    ctx->last[dev] = results[1];
+    return (++ctx->n != ctx->stopAt);
+}
+
+static void test_stream()
+{
+    OneWireNg::Id ids[DEVS_NUM];
+    SimDS2450 *sims[DEVS_NUM];
+
+    SimBus bus;
+    DS2450 adc(bus);
+
+    for (int i = 0; i < DEVS_NUM; i++) {
+        setId(ids[i], DS2450::FAMILY_CODE, (uint8_t)(i + 1));
+        sims[i] = new SimDS2450(ids[i]);
+        sims[i]->busySlots = i;
+        sims[i]->setInput(1, (uint16_t)(i << 8));
+        bus.attach(sims[i]);
+    }
+
+    /* single conversion for all devices per sample */
+    SinkCtx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    unsigned long nResets = bus.nResets;
+    assert(adc.sampleStream(ids, DEVS_NUM, DS2450::CH_B | DS2450::CH_D,
+        SAMPLES_NUM, sink, &ctx) == OneWireNg::EC_SUCCESS);
+    assert(ctx.n == SAMPLES_NUM * DEVS_NUM);
+    assert(bus.nResets == nResets + SAMPLES_NUM * (1 + DEVS_NUM));
+
+    for (int i = 0; i < DEVS_NUM; i++) {
+        assert(sims[i]->nConv == SAMPLES_NUM);
+        assert(ctx.last[i] == (uint16_t)(i << 8));
+    }
+
+    /* stopped by the sink */
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.stopAt = DEVS_NUM + 2;
+    assert(adc.sampleStream(ids, DEVS_NUM, DS2450::CH_B,
+        SAMPLES_NUM, sink, &ctx) == OneWireNg::EC_SUCCESS);
+    assert(ctx.n == DEVS_NUM + 2);
+    assert(sims[0]->nConv == SAMPLES_NUM + 2);
+
+    /* stopped by an error */
+    memset(&ctx, 0, sizeof(ctx));
+    sims[2]->crcErr = true;
+    assert(adc.sampleStream(ids, DEVS_NUM, DS2450::CH_B,
+        SAMPLES_NUM, sink, &ctx) == OneWireNg::EC_CRC_ERROR);
+
+    bus.detachAll();
+    for (int i = 0; i < DEVS_NUM; i++)
+        delete sims[i];
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_single();
+    test_stream();
+
+    return 0;
+}
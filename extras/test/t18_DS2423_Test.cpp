@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_ds2423.h"
+#include "sim_ds2438.h"
+
+#define DEVS_NUM 6
+
+static void test_read()
+{
+    OneWireNg::Id id;
+    setId(id, DS2423::FAMILY_CODE, 1);
+
+    SimBus bus;
+    SimDS2423 sim(id);
+    bus.attach(&sim);
+
+    DS2423 ds(bus);
+    uint8_t page[DS2423::PAGE_SIZE];
+    uint32_t cnt;
+
+    sim.setCounter(DS2423::PAGE_COUNTER_A, 123456);
+    sim.setCounter(DS2423::PAGE_COUNTER_B, 0x89abcdef);
+
+    /* full page with counter */
+    assert(ds.readPage(id, DS2423::PAGE_COUNTER_A, page, &cnt) ==
+        OneWireNg::EC_SUCCESS);
+    assert(cnt == 123456);
+    assert(!memcmp(page,
+        sim.getPage(DS2423::PAGE_COUNTER_A), DS2423::PAGE_SIZE));
+
+    assert(ds.readPage(id, 0, page, &cnt) == OneWireNg::EC_SUCCESS);
+    assert(cnt == 0xffffffff);
+    assert(!memcmp(page, sim.getPage(0), DS2423::PAGE_SIZE));
+
+    /* counter only; page data not clocked */
+    unsigned long nBits = bus.nBits;
+    assert(ds.readCounter(id, DS2423::PAGE_COUNTER_B, cnt) ==
+        OneWireNg::EC_SUCCESS);
+    assert(cnt == 0x89abcdef);
+    /* Match ROM, command, last page byte, counter, zeros, CRC */
+    assert(bus.nBits - nBits == 8 * (1 + 8 + 3 + 1 + 4 + 4 + 2));
+
+    assert(ds.readCounter(id, 0, cnt) == OneWireNg::EC_UNSUPPORED);
+    assert(ds.readPage(id, DS2423::PAGES_NUM, page) ==
+        OneWireNg::EC_UNSUPPORED);
+
+    sim.crcErr = true;
+    assert(ds.readCounter(id, DS2423::PAGE_COUNTER_A, cnt) ==
+        OneWireNg::EC_CRC_ERROR);
+    assert(ds.readPage(id, 1, page) == OneWireNg::EC_CRC_ERROR);
+
+    bus.detachAll();
+    assert(ds.readCounter(id, DS2423::PAGE_COUNTER_A, cnt) ==
+        OneWireNg::EC_NO_DEVS);
+
+    TEST_SUCCESS();
+}
+
+static void test_snapshot()
+{
+    OneWireNg::Id ids[DEVS_NUM], other;
+    SimDS2423 *sims[DEVS_NUM];
+    DS2423::Counters cnts[DEVS_NUM];
+    size_t n;
+
+    SimBus bus;
+    DS2423 ds(bus);
+
+    for (int i = 0; i < DEVS_NUM; i++) {
+        setId(ids[i], DS2423::FAMILY_CODE, (uint8_t)(i + 1));
+        sims[i] = new SimDS2423(ids[i]);
+        sims[i]->setCounter(DS2423::PAGE_COUNTER_A, 1000 + i);
+        sims[i]->setCounter(DS2423::PAGE_COUNTER_B, 2000 + i);
+        bus.attach(sims[i]);
+    }
+
+    /* not a counter */
+    setId(other, DS2438::FAMILY_CODE, 1);
+    SimDS2438 simOther(other);
+    bus.attach(&simOther);
+
+    /* less than half of bits needed for full counter pages reads */
+    unsigned long nBits = bus.nBits;
+    assert(ds.snapshot(ids, DEVS_NUM, cnts) == OneWireNg::EC_SUCCESS);
+    nBits = bus.nBits - nBits;
+    assert(nBits < DEVS_NUM * 2 * 8 * (1 + 8 + 3 + 32 + 4 + 4 + 2) / 2);
+
+    for (int i = 0; i < DEVS_NUM; i++) {
+        assert(!memcmp(cnts[i].id, ids[i], sizeof(OneWireNg::Id)));
+        assert(cnts[i].a == (uint32_t)(1000 + i));
+        assert(cnts[i].b == (uint32_t)(2000 + i));
+        assert(cnts[i].status == OneWireNg::EC_SUCCESS);
+    }
+
+    /* failed device doesn't stop the sweep */
+    sims[1]->crcErr = true;
+    assert(ds.snapshot(ids, DEVS_NUM, cnts) == OneWireNg::EC_CRC_ERROR);
+    for (int i = 0; i < DEVS_NUM; i++) {
+        assert(cnts[i].status == (i == 1 ?
+            OneWireNg::EC_CRC_ERROR : OneWireNg::EC_SUCCESS));
+    }
+    sims[1]->crcErr = false;
+
+    /* devices detected by search */
+    memset(cnts, 0, sizeof(cnts));
+    assert(ds.snapshotAll(cnts, DEVS_NUM, n) == OneWireNg::EC_SUCCESS);
+    assert(n == DEVS_NUM);
+    for (size_t i = 0; i < n; i++) {
+        assert(cnts[i].id[0] == DS2423::FAMILY_CODE);
+        assert(cnts[i].a + 1000 == cnts[i].b);
+        assert(cnts[i].status == OneWireNg::EC_SUCCESS);
+    }
+
+    assert(ds.snapshotAll(cnts, DEVS_NUM - 1, n) == OneWireNg::EC_FULL);
+    assert(n == DEVS_NUM - 1);
+
+    bus.detachAll();
+    for (int i = 0; i < DEVS_NUM; i++)
+        delete sims[i];
+
+    assert(ds.snapshotAll(cnts, DEVS_NUM, n) == OneWireNg::EC_SUCCESS);
+    assert(n == 0);
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_read();
+    test_snapshot();
+
+    return 0;
+}
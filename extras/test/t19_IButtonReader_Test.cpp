@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_bus.h"
+#include "utils/IButtonReader.h"
+
+#define DS1990_FAMILY 0x01
+
+/**
+ * Emulated iButton (no function commands).
+ */
+class SimIButton: public SimSlave
+{
+public:
+    SimIButton(const OneWireNg::Id& id, bool od): SimSlave(id), od(od) {}
+
+    void onByte(uint8_t byte) {
+        (void)byte;
+    }
+
+    /** Overdrive supported */
+    bool od;
+};
+
+/**
+ * Touch probe with an iButton put in contact by @ref touch(). iButton in
+ * the standard speed doesn't respond to the overdrive reset.
+ */
+class TouchProbe: public SimBus
+{
+public:
+    TouchProbe(): odResets(0), _btn(NULL), _devOd(false), _cmdBits(8) {}
+
+    void touch(SimIButton *btn)
+    {
+        if (btn != _btn) {
+            detachAll();
+            if (btn) attach(btn);
+            _btn = btn;
+            /* iButton powers up in the standard speed */
+            _devOd = false;
+        }
+    }
+
+    ErrorCode reset()
+    {
+        _cmd = 0;
+        _cmdBits = 0;
+
+        if (isOverdrive()) {
+            odResets++;
+            if (!_devOd) {
+                nResets++;
+                return EC_NO_DEVS;
+            }
+        } else
+            _devOd = false;
+
+        return SimBus::reset();
+    }
+
+    int touchBit(int bit, bool power)
+    {
+        /* detect Skip ROM Overdrive */
+        if (_cmdBits < 8) {
+            if (bit) _cmd |= (uint8_t)(1 << _cmdBits);
+            if (++_cmdBits == 8 && _cmd == CMD_SKIP_ROM_OVERDRIVE)
+                _devOd = (_btn && _btn->od);
+        }
+        return SimBus::touchBit(bit, power);
+    }
+
+    unsigned long odResets;
+
+private:
+    SimIButton *_btn;
+    bool _devOd;
+    uint8_t _cmd;
+    int _cmdBits;
+};
+
+/* iButton contact period */
+typedef struct {
+    unsigned long from;
+    unsigned long to;
+    SimIButton *btn;
+} Contact;
+
+static unsigned long g_now;
+static unsigned long g_touches;
+static unsigned long g_touchTime;
+static OneWireNg::Id g_id;
+
+static void touched(const OneWireNg::Id& id, void *arg)
+{
+    (void)arg;
+    g_touches++;
+    g_touchTime = g_now;
+    memcpy(g_id, id, sizeof(OneWireNg::Id));
+}
+
+/* run the reader on simulated time (1 ms resolution) */
+static void simulate(IButtonReader& reader, TouchProbe& probe,
+    const Contact *cont, size_t n, unsigned long from, unsigned long to)
+{
+    unsigned long next = from;
+
+    for (g_now = from; g_now < to; g_now++)
+    {
+        SimIButton *btn = NULL;
+        for (size_t i = 0; i < n; i++) {
+            if (g_now >= cont[i].from && g_now < cont[i].to)
+                btn = cont[i].btn;
+        }
+        probe.touch(btn);
+
+        if (g_now >= next)
+            next = g_now + reader.poll(g_now);
+    }
+}
+
+static void test_touch()
+{
+    OneWireNg::Id id;
+    setId(id, DS1990_FAMILY, 1);
+    SimIButton btn(id, false);
+
+    TouchProbe probe;
+    IButtonReader reader(probe, touched);
+
+    /* bouncing contact */
+    const Contact cont[] = {
+        { 1000, 1002, &btn },
+        { 1003, 1004, &btn },
+        { 1006, 3000, &btn }
+    };
+
+    g_touches = 0;
+    simulate(reader, probe, cont, 0, 0, 1000);
+    const IButtonReader::Stats& st = reader.getStats();
+
+    /* backoff while idle */
+    assert(st.resets < 30 && !st.reads);
+
+    simulate(reader, probe, cont, TAB_SZ(cont), 1000, 4000);
+    assert(g_touches == 1 && st.touches == 1);
+    assert(!memcmp(g_id, id, sizeof(OneWireNg::Id)));
+    assert(!memcmp(reader.getId(), id, sizeof(OneWireNg::Id)));
+
+    /* detected within the max idle interval + debouncing */
+    assert(g_touchTime - 1000 <= IButtonReader::MAX_INTERVAL +
+        IButtonReader::DEBOUNCE * IButtonReader::MIN_INTERVAL);
+    assert(st.confirmLatency <= st.maxConfirmLatency);
+    assert(st.maxConfirmLatency <=
+        (IButtonReader::DEBOUNCE - 1) * IButtonReader::MIN_INTERVAL);
+
+    /* removal detected */
+    assert(!reader.isPresent());
+
+    /* ~1 reset per poll, bus time far below a reset/read loop */
+    assert(st.resets <= st.polls + 1);
+    assert(st.estBusTime < 4000UL * 1000 / 20);
+
+    TEST_SUCCESS();
+}
+
+static void test_duplicates()
+{
+    OneWireNg::Id id1, id2;
+    setId(id1, DS1990_FAMILY, 1);
+    setId(id2, DS1990_FAMILY, 2);
+    SimIButton btn1(id1, false), btn2(id2, false);
+
+    TouchProbe probe;
+    IButtonReader reader(probe, touched);
+
+    const Contact cont[] = {
+        { 100, 1000, &btn1 },
+        /* the same iButton within the suppression window */
+        { 1300, 2000, &btn1 },
+        /* other iButton */
+        { 2100, 2500, &btn2 },
+        /* the 1st iButton again, out of the window */
+        { 4000, 4500, &btn1 },
+    };
+
+    g_touches = 0;
+    simulate(reader, probe, cont, TAB_SZ(cont), 0, 5000);
+    assert(g_touches == 3);
+    assert(reader.getStats().touches == 3);
+    assert(reader.getStats().duplicates == 1);
+    assert(!memcmp(g_id, id1, sizeof(OneWireNg::Id)));
+
+    /* suppression disabled */
+    reader.setDupWindow(0);
+    g_touches = 0;
+    simulate(reader, probe, cont, TAB_SZ(cont), 0, 5000);
+    assert(g_touches == 4);
+
+    TEST_SUCCESS();
+}
+
+static void test_overdrive()
+{
+    OneWireNg::Id id;
+    setId(id, DS1990_FAMILY, 1);
+    SimIButton btnOd(id, true), btn(id, false);
+
+    const Contact contOd[] = { { 100, 10000, &btnOd } };
+    const Contact cont[] = { { 100, 10000, &btn } };
+
+    /* overdrive supported */
+    TouchProbe probe;
+    IButtonReader reader(probe, touched);
+    reader.setOverdrive(true);
+
+    g_touches = 0;
+    simulate(reader, probe, contOd, 1, 0, 10000);
+    assert(g_touches == 1 && reader.isPresent());
+    assert(probe.isOverdrive() && probe.odResets > 0);
+    unsigned long odTime = reader.getStats().estBusTime;
+
+    simulate(reader, probe, contOd, 1, 10000, 11000);
+    assert(!reader.isPresent() && !probe.isOverdrive());
+
+    /* overdrive not supported */
+    TouchProbe probe2;
+    IButtonReader reader2(probe2, touched);
+    reader2.setOverdrive(true);
+
+    g_touches = 0;
+    simulate(reader2, probe2, cont, 1, 0, 10000);
+    assert(g_touches == 1 && reader2.isPresent());
+    assert(!probe2.isOverdrive());
+    assert(reader2.getStats().estBusTime > odTime);
+
+    simulate(reader2, probe2, cont, 1, 10000, 11000);
+    assert(!reader2.isPresent());
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_touch();
+    test_duplicates();
+    test_overdrive();
+
+    return 0;
+}
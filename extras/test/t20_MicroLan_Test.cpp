@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "common.h"
+#include "sim_ds2409.h"
+#include "sim_dstherm.h"
+#include "utils/MicroLan.h"
+#include "platform/Platform_Delay.h"
+
+#define THERMS_NUM 6
+#define DEVS_NUM (2 + THERMS_NUM + 1)
+#define CONV_TIME 60
+
+/**
+ * Emulated device with no function commands.
+ */
+class SimPlain: public SimSlave
+{
+public:
+    SimPlain(const OneWireNg::Id& id): SimSlave(id) {}
+
+    void onByte(uint8_t byte) {
+        (void)byte;
+    }
+};
+
+/**
+ * Bus topology:
+ * - trunk: couplers c1, c2, thermometer t0,
+ * - c1 main: t1, t2,
+ * - c1 aux: t3, plain device,
+ * - c2 main: t4, t5,
+ * - c2 aux: no devices.
+ */
+class Topology
+{
+public:
+    Topology()
+    {
+        OneWireNg::Id id;
+
+        setId(id, DS2409::FAMILY_CODE, 1);
+        c1 = new SimDS2409(id);
+        setId(id, DS2409::FAMILY_CODE, 2);
+        c2 = new SimDS2409(id);
+        setId(id, 0x01, 1);
+        plain = new SimPlain(id);
+
+        for (int i = 0; i < THERMS_NUM; i++) {
+            setId(id, DSTherm::DS18B20, (uint8_t)(10 + i));
+            therms[i] = new SimDSTherm(id, 16 * (20 + i));
+        }
+
+        bus.attachCoupler(c1);
+        bus.attachCoupler(c2);
+        bus.attachTrunk(therms[0]);
+        c1->attachBranch(DS2409::BRANCH_MAIN, therms[1]);
+        c1->attachBranch(DS2409::BRANCH_MAIN, therms[2]);
+        c1->attachBranch(DS2409::BRANCH_AUX, therms[3]);
+        c1->attachBranch(DS2409::BRANCH_AUX, plain);
+        c2->attachBranch(DS2409::BRANCH_MAIN, therms[4]);
+        c2->attachBranch(DS2409::BRANCH_MAIN, therms[5]);
+    }
+
+    ~Topology()
+    {
+        delete c1;
+        delete c2;
+        delete plain;
+        for (int i = 0; i < THERMS_NUM; i++)
+            delete therms[i];
+    }
+
+    SimMicroLan bus;
+    SimDS2409 *c1, *c2;
+    SimPlain *plain;
+    SimDSTherm *therms[THERMS_NUM];
+};
+
+/**
+ * Readings sink with a limited capacity.
+ */
+class Readings: public DSTherm::ReadingSink
+{
+public:
+    Readings(size_t max): n(0), _max(max) {}
+
+    bool put(const DSTherm::Reading& rd)
+    {
+        if (n >= _max)
+            return false;
+        rds[n++] = rd;
+        return true;
+    }
+
+    DSTherm::Reading rds[DEVS_NUM];
+    size_t n;
+
+private:
+    size_t _max;
+};
+
+static void checkEntry(const MicroLan& lan,
+    const SimSlave *dev, const SimDS2409 *coupler, int branch)
+{
+    int i = lan.find(dev->getId());
+    assert(i >= 0);
+
+    const MicroLan::Entry& e = lan.getEntry(i);
+    if (!coupler) {
+        assert(e.coupler == MicroLan::TRUNK);
+    } else {
+        assert(e.coupler == lan.find(coupler->getId()));
+        assert(e.branch == branch);
+    }
+}
+
+static void test_discover()
+{
+    Topology top;
+    MicroLan::Entry entries[DEVS_NUM];
+    MicroLan lan(top.bus, entries, DEVS_NUM);
+
+    assert(lan.discover() == OneWireNg::EC_SUCCESS);
+    assert(lan.size() == DEVS_NUM);
+
+    checkEntry(lan, top.c1, NULL, 0);
+    checkEntry(lan, top.c2, NULL, 0);
+    checkEntry(lan, top.therms[0], NULL, 0);
+    checkEntry(lan, top.therms[1], top.c1, DS2409::BRANCH_MAIN);
+    checkEntry(lan, top.therms[2], top.c1, DS2409::BRANCH_MAIN);
+    checkEntry(lan, top.therms[3], top.c1, DS2409::BRANCH_AUX);
+    checkEntry(lan, top.plain, top.c1, DS2409::BRANCH_AUX);
+    checkEntry(lan, top.therms[4], top.c2, DS2409::BRANCH_MAIN);
+    checkEntry(lan, top.therms[5], top.c2, DS2409::BRANCH_MAIN);
+
+    /* branches left disconnected */
+    assert(top.c1->active < 0 && top.c2->active < 0);
+
+    /* no space */
+    MicroLan lan2(top.bus, entries, DEVS_NUM - 1);
+    assert(lan2.discover() == OneWireNg::EC_FULL);
+    assert(lan2.size() == DEVS_NUM - 1);
+
+    /* known topology */
+    MicroLan lan3(top.bus, entries, DEVS_NUM);
+    assert(lan3.add(top.c1->getId()) == OneWireNg::EC_SUCCESS);
+    assert(lan3.add(top.therms[3]->getId(), 0, DS2409::BRANCH_AUX) ==
+        OneWireNg::EC_SUCCESS);
+    assert(lan3.add(top.therms[4]->getId(), 1) == OneWireNg::EC_UNSUPPORED);
+    /* nested coupler (behind a branch) may not be a parent */
+    assert(lan3.add(top.c2->getId(), 0, DS2409::BRANCH_MAIN) ==
+        OneWireNg::EC_SUCCESS);
+    assert(lan3.add(top.therms[4]->getId(), 2) == OneWireNg::EC_UNSUPPORED);
+    assert(lan3.select(1) == OneWireNg::EC_SUCCESS);
+    assert(top.bus.verify(top.therms[3]->getId()) == OneWireNg::EC_SUCCESS);
+
+    TEST_SUCCESS();
+}
+
+static bool visit(OneWireNg& ow, const MicroLan::Entry& entry, void *arg)
+{
+    /* the device is reachable */
+    assert(ow.verify(entry.id) == OneWireNg::EC_SUCCESS);
+    (*(int*)arg)++;
+    return true;
+}
+
+static bool visitOne(OneWireNg& ow, const MicroLan::Entry& entry, void *arg)
+{
+    (void)ow;
+    (void)entry;
+    (*(int*)arg)++;
+    return false;
+}
+
+static void test_forEach()
+{
+    Topology top;
+    MicroLan::Entry entries[DEVS_NUM];
+    MicroLan lan(top.bus, entries, DEVS_NUM);
+    int cnt;
+
+    assert(lan.discover() == OneWireNg::EC_SUCCESS);
+    lan.resetStats();
+
+    /* each branch with devices connected once */
+    cnt = 0;
+    assert(lan.forEach(visit, &cnt) == OneWireNg::EC_SUCCESS);
+    assert(cnt == DEVS_NUM);
+    assert(lan.getStats().switches == 3);
+    assert(lan.getStats().linesOff == 1);
+    /* last visited branch left connected */
+    assert((top.c1->active >= 0) != (top.c2->active >= 0));
+
+    /* connected branch visited first */
+    lan.resetStats();
+    cnt = 0;
+    assert(lan.forEach(visit, &cnt, DSTherm::DS18B20) ==
+        OneWireNg::EC_SUCCESS);
+    assert(cnt == THERMS_NUM);
+    assert(lan.getStats().switches == 2);
+
+    /* no switching for a device on the connected branch or trunk */
+    int i = lan.find(top.therms[3]->getId());
+    assert(lan.select(i) == OneWireNg::EC_SUCCESS);
+    lan.resetStats();
+    assert(lan.select(i) == OneWireNg::EC_SUCCESS);
+    assert(lan.select(lan.find(top.therms[0]->getId())) ==
+        OneWireNg::EC_SUCCESS);
+    assert(lan.getStats().switches == 0);
+
+    /* stop visiting */
+    cnt = 0;
+    assert(lan.forEach(visitOne, &cnt) == OneWireNg::EC_SUCCESS);
+    assert(cnt == 1);
+
+    TEST_SUCCESS();
+}
+
+static void checkReadings(const Topology& top, const Readings& rds)
+{
+    for (size_t i = 0; i < rds.n; i++)
+    {
+        const DSTherm::Reading& rd = rds.rds[i];
+        assert(rd.status == OneWireNg::EC_SUCCESS);
+
+        int k = rd.id[1] - 10;
+        assert(k >= 0 && k < THERMS_NUM);
+        assert(rd.temp == 16 * (20 + k));
+        assert(top.therms[k]->nConv > 0);
+    }
+}
+
+static void test_readTemp()
+{
+    Topology top;
+    MicroLan::Entry entries[DEVS_NUM];
+    MicroLan lan(top.bus, entries, DEVS_NUM);
+    DSTherm dsth(top.bus);
+    size_t n;
+
+    assert(lan.discover() == OneWireNg::EC_SUCCESS);
+
+    /* conversions on the branches overlap */
+    Readings rds(DEVS_NUM);
+    lan.resetStats();
+    unsigned long start = timeMs();
+    assert(lan.readTempAll(dsth, rds, CONV_TIME, false, &n) ==
+        OneWireNg::EC_SUCCESS);
+    unsigned long time = timeMs() - start;
+
+    assert(n == THERMS_NUM && rds.n == THERMS_NUM);
+    checkReadings(top, rds);
+    assert(time >= CONV_TIME && time < 2 * CONV_TIME);
+    assert(lan.getStats().switches <= 2 * 3);
+
+    /* parasitic powering; branches converted one by one */
+    Readings rds2(DEVS_NUM);
+    start = timeMs();
+    assert(lan.readTempAll(dsth, rds2, CONV_TIME, true, &n) ==
+        OneWireNg::EC_SUCCESS);
+    time = timeMs() - start;
+
+    assert(n == THERMS_NUM && rds2.n == THERMS_NUM);
+    checkReadings(top, rds2);
+    assert(time >= 3 * CONV_TIME);
+
+    /* sink full */
+    Readings rds3(THERMS_NUM - 2);
+    assert(lan.readTempAll(dsth, rds3, CONV_TIME, false, &n) ==
+        OneWireNg::EC_FULL);
+    assert(n == THERMS_NUM - 2);
+
+    TEST_SUCCESS();
+}
+
+int main(void)
+{
+    test_discover();
+    test_forEach();
+    test_readTemp();
+
+    return 0;
+}
@@ -7,9 +7,18 @@
 #define CONFIG_CRC16_ALGO CRC16_TAB_32
 #define CONFIG_ITERATION_RETRIES 1
 #define CONFIG_BITBANG_TIMING TIMING_NULL
+#define CONFIG_DSTHERM_CACHE
 
 #if defined(T03)
 # define CONFIG_MAX_SEARCH_FILTERS 5
 #else
 # define CONFIG_MAX_SEARCH_FILTERS 10
 #endif
+
+#if defined(T01)
+# define CONFIG_EXT_VIRTUAL_INTF
+#endif
+
+#if defined(T11)
+# define CONFIG_DS18S20_EXT_RES
+#endif
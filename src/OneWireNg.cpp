@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2024 Piotr Stolarz
+ * Copyright (c) 2019-2024,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -145,8 +145,11 @@ inline void OneWireNg::searchFilterSelectAll()
  * - bit 1: 0 present for this bit position (master reads, slave writes),
  * - bit 2: 1 present for this bit position (master reads, slave writes),
  * - bit 3: select slave with a given bit value (master writes, slave reads).
- *     This bit may not be transmitted in case it has no sense (no slave
- *     devices on the bus or bus error).
+ *
+ * The triplet is touched by @ref touchTriplet() with the search direction
+ * (taken in case of discrepancy) established in advance, therefore the
+ * selecting bit is always transmitted (even if it has no sense due to no
+ * slave devices on the bus or bus error).
  *
  * If selected bit value is 1 then the corresponding n-th bit in @c id is set
  * (the @id must be initialized with 0).
@@ -171,8 +174,23 @@ inline OneWireNg::ErrorCode
     uint8_t n_bt = (n >> 3);
 
     int selBit;             /* selected bit value */
-    int v0 = touchBit(1);   /* 0-presence */
-    int v1 = touchBit(1);   /* 1-presence */
+    int dir;                /* search direction in case of discrepancy */
+
+# if (CONFIG_MAX_SEARCH_FILTERS > 0)
+    int fltBit = (!n_bt ? searchFilterApply(n_bm) : 2);
+    if (fltBit != 2) {
+        dir = fltBit;
+    } else
+# endif
+    if (n < _lzero) {
+        dir = ((_lsrch[n_bt] & n_bm) != 0);
+    } else {
+        dir = (n == _lzero);
+    }
+
+    int trpl = touchTriplet(dir);
+    int v0 = trpl & 1;          /* 0-presence */
+    int v1 = (trpl >> 1) & 1;   /* 1-presence */
 
     if (v1 && v0)
     {
@@ -189,22 +207,15 @@ inline OneWireNg::ErrorCode
         if (n_bt >= (int)(sizeof(Id) - 1)) {
             /* no discrepancy is expected for CRC part of the id - bus error */
             return EC_BUS_ERROR;
-        } else {
+        }
+
+        selBit = dir;
 # if (CONFIG_MAX_SEARCH_FILTERS > 0)
-            if (n_bt || (selBit = searchFilterApply(n_bm)) == 2)
+        if (fltBit == 2)
 # endif
-            {
-                if (n < _lzero) {
-                    selBit = ((_lsrch[n_bt] & n_bm) != 0);
-                } else if (n == _lzero) {
-                    selBit = 1;
-                } else {
-                    selBit = 0;
-                }
-
-                if (!selBit)
-                    lzero = n;
-            }
+        {
+            if (!selBit)
+                lzero = n;
         }
     } else
     {
@@ -213,17 +224,12 @@ inline OneWireNg::ErrorCode
          */
         selBit = !v1;
 # if (CONFIG_MAX_SEARCH_FILTERS > 0)
-        if (!n_bt)
-        {
-            /* check if code matches filtering criteria */
-            int fltBit = searchFilterApply(n_bm);
-            if (fltBit != 2 && fltBit != selBit)
-                return EC_NO_DEVS;
-        }
+        /* check if code matches filtering criteria */
+        if (fltBit != 2 && fltBit != selBit)
+            return EC_NO_DEVS;
 # endif
     }
 
-    touchBit(selBit);
 # if (CONFIG_MAX_SEARCH_FILTERS > 0)
     /*
      * There is at least one matching family code among connected devices
@@ -279,6 +285,14 @@ restart:
                 goto restart;
         } else
 # endif
+        if (ec == EC_BUS_ERROR && alarm && !n) {
+            /*
+             * No devices with alarm state set responded (while some
+             * devices reported presence). This is normal condition for
+             * the conditional search, not a bus error.
+             */
+            return EC_NO_DEVS;
+        } else
         if (ec != EC_SUCCESS)
             return ec;
     }
@@ -292,6 +306,30 @@ restart:
 }
 
 # undef __UPDATE_DISCREPANCY
+
+OneWireNg::ErrorCode OneWireNg::verify(const Id& id, bool alarm)
+{
+    ErrorCode ec = reset();
+    if (ec != EC_SUCCESS)
+        return ec;
+
+    touchByte(alarm ? CMD_SEARCH_ROM_COND : CMD_SEARCH_ROM);
+
+    for (int n = 0; n < (int)(8 * sizeof(Id)); n++)
+    {
+        int bit = ((id[n >> 3] >> (n & 7)) & 1);
+
+        /*
+         * The device writes the id bit in the 1st read slot and its
+         * complement in the 2nd one. Therefore the 1st read (for 0 bit)
+         * or the 2nd read (for 1 bit) must result in 0 if the device is
+         * present. The triplet selects the device path on the bus.
+         */
+        if (touchTriplet(bit) & (bit ? 2 : 1))
+            return EC_NO_DEVS;
+    }
+    return EC_SUCCESS;
+}
 #endif /* CONFIG_SEARCH_ENABLED */
 
 uint8_t OneWireNg::crc8(const void *in, size_t len, uint8_t crc_in)
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2023,2025 Piotr Stolarz
+ * Copyright (c) 2019-2023,2025,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -79,7 +79,9 @@ public:
         /** Service is not supported by the platform */
         EC_UNSUPPORED,
         /** No space (e.g. filters table is full) */
-        EC_FULL
+        EC_FULL,
+        /** Operation timed out (e.g. request deadline passed) */
+        EC_TIMEOUT
     } ErrorCode;
 
     /**
@@ -160,6 +162,29 @@ public:
             bytes[i] = touchByte(bytes[i], power && (i + 1 >= len));
     }
 
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Search triplet touch: two read slots (bit of the searched id and its
+     * complement) followed by a write slot selecting slave devices with
+     * the written bit value. The written bit is the read id bit if the read
+     * bits differ, @c dir otherwise.
+     *
+     * @param dir Search direction (bit to write) in case of discrepancy.
+     *
+     * @return Read bits: bit 0 - the id bit, bit 1 - its complement.
+     *
+     * @note This method is part of the extended virtual interface.
+     */
+    EXT_VIRTUAL_INTF int touchTriplet(int dir)
+    {
+        int v0 = (touchBit(1) != 0);
+        int v1 = (touchBit(1) != 0);
+
+        touchBit(v0 != v1 ? v0 : dir);
+        return (v0 | (v1 << 1));
+    }
+#endif
+
     /**
      * Bit write.
      *
@@ -188,8 +213,12 @@ public:
      * @param bytes Array of bytes to be written on the bus.
      * @param len Length of the array.
      * @param power Same as for @ref writeBit().
+     *
+     * @note This method is part of the extended virtual interface. Contrary
+     *     to @ref touchBytes() the read bytes are dropped, so a driver may
+     *     implement the write with no receive buffer.
      */
-    void writeBytes(
+    EXT_VIRTUAL_INTF void writeBytes(
         const uint8_t *bytes, size_t len, bool power = false)
     {
         for (size_t i = 0; i < len; i++)
@@ -219,8 +248,12 @@ public:
      *
      * @param bytes Array of bytes to store the reading result.
      * @param len Number of bytes to read (length of the array).
+     *
+     * @note This method is part of the extended virtual interface. Contrary
+     *     to @ref touchBytes() there is no need to fill the array with 0xff
+     *     bytes before the read, a driver may send them by itself.
      */
-    void readBytes(uint8_t *bytes, size_t len) {
+    EXT_VIRTUAL_INTF void readBytes(uint8_t *bytes, size_t len) {
         for (size_t i = 0; i < len; i++)
             bytes[i] = touchByte(0xff);
     }
@@ -242,7 +275,8 @@ public:
      *     - @c EC_MORE (aka @c EC_SUCCESS): More devices available by
      *         subsequent calls of this routine. @c id is written with slave id.
      *     - @c EC_NO_DEVS: No more slave devices (@c id not returned; passed
-     *         variable content may be changed).
+     *         variable content may be changed). In the alarm mode the code is
+     *         also returned if there are no devices with alarm state set.
      *     Failure error codes (@c id not returned; passed variable content may
      *     be changed):
      *     - @c EC_BUS_ERROR: Bus error.
@@ -267,6 +301,51 @@ public:
     void searchReset() {
         _lzero = -1;
     }
+
+    /**
+     * Verify presence of a slave device with a given id. The routine performs
+     * single search pass forced to follow the id's path. The verification
+     * succeeds only if all search triplets responses are consistent with the
+     * id, therefore (contrary to addressing the device and reading its data)
+     * a missing device is distinguished from a broken data transmission.
+     *
+     * @param id Id of the verified device.
+     * @param alarm If @c true - verify the device with alarm state set,
+     *     @c false - verify the device regardless of its alarm state.
+     *
+     * @return
+     *     - @c EC_SUCCESS: The device is present.
+     *     - @c EC_NO_DEVS: The device is not present (also returned if there
+     *         are no devices on the bus).
+     *     - @c EC_BUS_ERROR: Bus error.
+     *
+     * @note The routine doesn't modify the search-scan process state.
+     */
+    ErrorCode verify(const Id& id, bool alarm = false);
+
+    /**
+     * Verify presence of a number of slave devices.
+     *
+     * @param ids Ids of the verified devices.
+     * @param n Number of the ids.
+     * @param present If not @c NULL, the array is written with the verified
+     *     devices presence statuses.
+     * @param alarm Same as for @ref verify(const Id&, bool).
+     *
+     * @return Number of present devices.
+     */
+    size_t verify(
+        const Id *ids, size_t n, bool *present = NULL, bool alarm = false)
+    {
+        size_t np = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            bool p = (verify(ids[i], alarm) == EC_SUCCESS);
+            if (present) present[i] = p;
+            if (p) np++;
+        }
+        return np;
+    }
 #endif /* CONFIG_SEARCH_ENABLED */
 
 #if USE_SEARCH_RANGE_LOOP
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022 Piotr Stolarz
+ * Copyright (c) 2019-2022,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -11,78 +11,9 @@
  */
 
 #include "OneWireNg_BitBang.h"
+#include "OneWireNg_BitBangTiming.h"
 #include "platform/Platform_Delay.h"
 
-#define TIMING_STRICT   1
-#define TIMING_RELAXED  2
-#define TIMING_NULL     3
-
-#if (CONFIG_BITBANG_TIMING == TIMING_STRICT)
-# define TC_STRICT_ENTER() timeCriticalEnter()
-# define TC_STRICT_EXIT() timeCriticalExit()
-# define TC_RELAXED_ENTER() timeCriticalEnter()
-# define TC_RELAXED_EXIT() timeCriticalExit()
-# define TC_RELAXED_TO_STRICT()
-#elif (CONFIG_BITBANG_TIMING == TIMING_RELAXED)
-# define TC_STRICT_ENTER() timeCriticalEnter()
-# define TC_STRICT_EXIT() timeCriticalExit()
-# define TC_RELAXED_ENTER()
-# define TC_RELAXED_EXIT()
-# define TC_RELAXED_TO_STRICT() timeCriticalEnter()
-#elif (CONFIG_BITBANG_TIMING == TIMING_NULL)
-# define TC_STRICT_ENTER()
-# define TC_STRICT_EXIT()
-# define TC_RELAXED_ENTER()
-# define TC_RELAXED_EXIT()
-# define TC_RELAXED_TO_STRICT()
-#else
-# error "Invalid CONFIG_BITBANG_TIMING"
-#endif
-
-/*
- * Standard mode timings
- */
-/* min. 480 us */
-#define STD_RESET_LOW   480
-/* reset high; presence-detect sampling: 68-75 us (relaxed) */
-#define STD_RESET_SMPL  70
-/* reset trailing high */
-#define STD_RESET_END   410
-
-/* write-0 low: 60-120 us (relaxed) */
-#define STD_WRITE0_LOW  60
-/* write-0 trailing high: 5-15 us */
-#define STD_WRITE0_END  10
-
-/* write-1 low (strict) */
-#define STD_WRITE1_LOW  5
-/* write-1 high; sampling max 15 us (low + high; strict) */
-#define STD_WRITE1_SMPL 8
-/* write-1 trailing high */
-#define STD_WRITE1_END  56
-
-/*
- * Overdrive mode timings
- */
-/* reset low: 53-80 us (relaxed) */
-#define OD_RESET_LOW    68
-/* reset high; presence-detect sampling: 8-9 us (strict) */
-#define OD_RESET_SMPL   8
-/* reset high; trailing part */
-#define OD_RESET_END    40
-
-/* write-0 low: 8-13 us (strict) */
-#define OD_WRITE0_LOW   8
-/* write-0 trailing high: 1-2 us */
-#define OD_WRITE0_END   1
-
-/* write-1 low: 0-1 us (strict) */
-#define OD_WRITE1_LOW   0   /* <=0: no delay, >0: usec delay */
-/* write-1 high; sampling max 2 us (low + high; strict) */
-#define OD_WRITE1_SMPL  0   /* <=0: no delay, >0: usec delay */
-/* write-1 trailing high */
-#define OD_WRITE1_END   7
-
 TIME_CRITICAL OneWireNg::ErrorCode OneWireNg_BitBang::reset()
 {
     int presPulse;
@@ -120,6 +51,150 @@ TIME_CRITICAL OneWireNg::ErrorCode OneWireNg_BitBang::reset()
     return (presPulse ? EC_NO_DEVS : EC_SUCCESS);
 }
 
+/**
+ * Sample the bus (released after the reset pulse) with @c step usecs up to
+ * @c max usecs, or the presence pulse end. Returns elapsed time.
+ */
+TIME_CRITICAL unsigned OneWireNg_BitBang::measurePresence(
+    unsigned step, unsigned max, PresenceTiming& tm)
+{
+    unsigned t = 0;
+
+    tm.start = tm.length = 0;
+    while (t < max)
+    {
+        delayUs(step);
+        t += step;
+
+        if (!readDtaGpioIn()) {
+            if (!tm.start)
+                tm.start = (uint16_t)t;
+        } else
+        if (tm.start) {
+            tm.length = (uint16_t)(t - tm.start);
+            break;
+        }
+    }
+    return t;
+}
+
+TIME_CRITICAL OneWireNg::ErrorCode
+    OneWireNg_BitBang::reset(PresenceTiming& tm)
+{
+    unsigned t, end;
+
+    if (_pwre) powerBus(false);
+
+#if CONFIG_OVERDRIVE_ENABLED
+    if (_overdrive)
+    {
+        /* Overdrive mode
+         */
+        TC_RELAXED_ENTER();
+        setBus(0);
+        delayUs(OD_RESET_LOW);
+        TC_RELAXED_TO_STRICT();
+        setBus(1);
+        t = measurePresence(OD_PRES_STEP, OD_PRES_MAX, tm);
+        TC_STRICT_EXIT();
+        end = OD_RESET_SMPL + OD_RESET_END;
+    } else
+#endif
+    {
+        /* Standard mode
+         */
+        setBus(0);
+        delayUs(STD_RESET_LOW);
+        TC_RELAXED_ENTER();
+        setBus(1);
+        t = measurePresence(STD_PRES_STEP, STD_PRES_MAX, tm);
+        TC_RELAXED_EXIT();
+        end = STD_RESET_SMPL + STD_RESET_END;
+    }
+    if (t < end) delayUs(end - t);
+
+    if (!tm.start)
+        return EC_NO_DEVS;
+    return (tm.length ? EC_SUCCESS : EC_BUS_ERROR);
+}
+
+TIME_CRITICAL void OneWireNg_BitBang::resetAll(
+    OneWireNg_BitBang * const *buses, PresenceTiming *tms,
+    ErrorCode *ecs, size_t n)
+{
+    unsigned long t = 0, t0;
+    size_t i, nPend = 0;
+
+    for (i = 0; i < n; i++) {
+        if (!isResetStd(buses[i]))
+            continue;
+        if (buses[i]->_pwre) buses[i]->powerBus(false);
+        tms[i].start = tms[i].length = 0;
+        /* pending bus; reported as shorted if the sampling doesn't end */
+        ecs[i] = EC_BUS_ERROR;
+        nPend++;
+    }
+
+    if (nPend > 0)
+    {
+        for (i = 0; i < n; i++) {
+            if (isResetStd(buses[i]))
+                buses[i]->setBus(0);
+        }
+        delayUs(STD_RESET_LOW);
+
+        TC_RELAXED_ENTER();
+        for (i = 0; i < n; i++) {
+            if (isResetStd(buses[i]))
+                buses[i]->setBus(1);
+        }
+        t0 = timeUs();
+
+        /*
+         * Sample the buses up to the end of all presence pulses. The time
+         * is measured (not counted in steps), since a single sampling round
+         * lasts longer with the number of buses.
+         */
+        while (nPend > 0 && t < STD_PRES_MAX)
+        {
+            delayUs(STD_PRES_STEP);
+            t = timeUs() - t0;
+
+            for (i = 0; i < n; i++)
+            {
+                if (!isResetStd(buses[i]) || ecs[i] != EC_BUS_ERROR)
+                    continue;
+
+                if (!buses[i]->readDtaGpioIn()) {
+                    if (!tms[i].start)
+                        tms[i].start = (uint16_t)t;
+                } else
+                if (tms[i].start) {
+                    tms[i].length = (uint16_t)(t - tms[i].start);
+                    ecs[i] = EC_SUCCESS;
+                    nPend--;
+                } else
+                if (t > STD_RESET_SMPL) {
+                    /* no presence pulse in the presence-detect window */
+                    ecs[i] = EC_NO_DEVS;
+                    nPend--;
+                }
+            }
+        }
+        TC_RELAXED_EXIT();
+
+        t = timeUs() - t0;
+        if (t < STD_RESET_SMPL + STD_RESET_END)
+            delayUs(STD_RESET_SMPL + STD_RESET_END - t);
+    }
+
+    /* overdrive buses */
+    for (i = 0; i < n; i++) {
+        if (buses[i] && !isResetStd(buses[i]))
+            ecs[i] = buses[i]->reset(tms[i]);
+    }
+}
+
 TIME_CRITICAL int OneWireNg_BitBang::touchBit(int bit, bool power)
 {
     int smpl = 0;
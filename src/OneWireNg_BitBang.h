@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2022 Piotr Stolarz
+ * Copyright (c) 2019-2022,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -32,9 +32,68 @@
 class OneWireNg_BitBang: public OneWireNg
 {
 public:
+    /**
+     * Presence pulse timing (usecs), measured from the reset pulse end.
+     */
+    typedef struct
+    {
+        uint16_t start;     /** presence pulse start (0: not detected) */
+        uint16_t length;    /** presence pulse length (0: not finished) */
+    } PresenceTiming;
+
     ErrorCode reset();
     int touchBit(int bit, bool power);
 
+    /**
+     * Reset with presence pulse timing measurement. The bus is sampled with
+     * a fixed step (2 usecs in standard, 1 usec in overdrive mode) from the
+     * reset pulse end up to the maximum presence pulse end time, therefore
+     * the measured timing is approximate (the GPIO reading overhead is not
+     * taken into account).
+     *
+     * @param tm Measured presence pulse timing.
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Presence pulse detected.
+     *     - @c EC_NO_DEVS: No presence pulse detected.
+     *     - @c EC_BUS_ERROR: The bus held low during the whole sampling
+     *         window (e.g. shorted to the ground).
+     *
+     * @note The bus is sampled inside time critical section, which lasts
+     *     longer than the one of the ordinary reset (up to 300 usecs in
+     *     the standard mode).
+     */
+    ErrorCode reset(PresenceTiming& tm);
+
+    /**
+     * Reset with presence pulse timing measurement (see @ref
+     * reset(PresenceTiming&)) performed on a number of buses at once. Reset
+     * pulses of the buses overlap (the buses are driven low one after
+     * another and released in the same order after the reset pulse time)
+     * and the buses are sampled in a single presence detection window,
+     * therefore the routine lasts about the time of a single reset.
+     *
+     * The buses are sampled inside time critical section, which ends with
+     * the last presence pulse (buses with no presence pulse detected in
+     * the presence-detect window are not sampled further), but lasts up to
+     * 300 usecs in the standard mode if any of the buses is shorted. The
+     * sampling time is measured by a timer, so the section's length doesn't
+     * depend on the number of buses, but a single sampling round of all the
+     * buses lasts longer with their number, thus the presence pulse timing
+     * resolution degrades accordingly (the number of buses passed in a
+     * single call shall be kept small on slow platforms).
+     *
+     * @param buses Buses to reset (@c NULL entries are skipped).
+     * @param tms Measured presence pulse timing of each bus.
+     * @param ecs Reset result of each bus (as returned by @ref
+     *     reset(PresenceTiming&)).
+     * @param n Number of buses.
+     *
+     * @note Buses in the overdrive mode are reset one by one after the
+     *     overlapped reset of the standard mode buses.
+     */
+    static void resetAll(OneWireNg_BitBang * const *buses,
+        PresenceTiming *tms, ErrorCode *ecs, size_t n);
+
     /**
      * Enable/disable direct voltage source provisioning on the 1-wire data bus.
      * Function always successes.
@@ -186,6 +245,18 @@ protected:
 #endif
 
 private:
+    unsigned measurePresence(unsigned step, unsigned max, PresenceTiming& tm);
+
+    /* check if the bus takes part in the overlapped reset (standard mode) */
+    static bool isResetStd(const OneWireNg_BitBang *bus)
+    {
+#if CONFIG_OVERDRIVE_ENABLED
+        return (bus && !bus->_overdrive);
+#else
+        return (bus != NULL);
+#endif
+    }
+
 #if CONFIG_PWR_CTRL_ENABLED
     void writeDtaGpioOut(int state) { writeGpioOut(state, GPIO_DTA); }
     void setDtaGpioAsOutput(int state) { setGpioAsOutput(state, GPIO_DTA); }
@@ -194,6 +265,7 @@ private:
     void setDtaGpioAsOutput(int state) { setGpioAsOutput(state); }
 #endif
 
+friend class OneWireNg_BitBangAsync;
 #ifdef OWNG_TEST
 friend class OneWireNg_BitBang_Test;
 #endif
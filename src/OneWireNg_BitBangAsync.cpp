@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "OneWireNg_BitBangAsync.h"
+#include "OneWireNg_BitBangTiming.h"
+#include "platform/Platform_Delay.h"
+
+OneWireNg::ErrorCode OneWireNg_BitBangAsync::submit(Request& req)
+{
+    if (req._queued)
+        return OneWireNg::EC_FULL;
+
+    req._next = NULL;
+    req._done = false;
+    req._queued = true;
+
+    timeCriticalEnter();
+    if (_tail) {
+        _tail->_next = &req;
+    } else {
+        _head = &req;
+    }
+    _tail = &req;
+
+    /* no timer armed - the engine needs to be kicked off (by this caller) */
+    bool kick = (_state == ST_IDLE);
+    if (kick) _state = ST_START;
+    timeCriticalExit();
+
+    if (kick) onTimer();
+    return OneWireNg::EC_SUCCESS;
+}
+
+TIME_CRITICAL void OneWireNg_BitBangAsync::onTimer()
+{
+    unsigned us = step();
+    if (us > 0)
+        _timer.start(us);
+}
+
+TIME_CRITICAL unsigned OneWireNg_BitBangAsync::step()
+{
+    switch (_state)
+    {
+    case ST_IDLE:
+    case ST_START:
+        timeCriticalEnter();
+        if (!(_req = _head))
+            _state = ST_IDLE;
+        timeCriticalExit();
+
+        if (!_req)
+            return 0;
+
+        _pos = 0;
+        _bit = 0;
+        _rx = 0;
+
+        if (_bb._pwre) _bb.powerBus(false);
+
+        if (_req->_reset) {
+            _bb.setBus(0);
+            _state = ST_RESET_RELEASE;
+            return STD_RESET_LOW;
+        }
+        return startBit();
+
+    case ST_RESET_RELEASE:
+        _bb.setBus(1);
+        _state = ST_RESET_SAMPLE;
+        return STD_RESET_SMPL;
+
+    case ST_RESET_SAMPLE:
+        _presence = !_bb.readDtaGpioIn();
+        _state = ST_RESET_END;
+        return STD_RESET_END;
+
+    case ST_RESET_END:
+        if (!_presence)
+            return complete(OneWireNg::EC_NO_DEVS);
+        return startBit();
+
+    case ST_BIT:
+        return startBit();
+
+    case ST_WRITE0_RELEASE:
+        _bb.setBus(1);
+        if (_req->_power && lastBit()) _bb.powerBus(true);
+        nextBit(0);
+        _state = ST_BIT;
+        return STD_WRITE0_END;
+
+    default:
+        return 0;
+    }
+}
+
+TIME_CRITICAL void OneWireNg_BitBangAsync::nextBit(int smpl)
+{
+    if (smpl)
+        _rx |= (uint8_t)(1 << _bit);
+
+    if (++_bit >= 8) {
+        _req->_bytes[_pos++] = _rx;
+        _rx = 0;
+        _bit = 0;
+    }
+}
+
+TIME_CRITICAL unsigned OneWireNg_BitBangAsync::startBit()
+{
+    if (_pos >= _req->_len)
+        return complete(OneWireNg::EC_SUCCESS);
+
+    bool power = (_req->_power && lastBit());
+
+    if ((_req->_bytes[_pos] >> _bit) & 1)
+    {
+        /* write-1 with sampling (alias read); short enough to busy-wait */
+        TC_STRICT_ENTER();
+        _bb.setBus(0);
+        delayUs(STD_WRITE1_LOW);
+        _bb.setBus(1);
+        delayUs(STD_WRITE1_SMPL);
+        int smpl = _bb.readDtaGpioIn();
+        if (power) _bb.powerBus(true);
+        TC_STRICT_EXIT();
+
+        nextBit(smpl);
+        _state = ST_BIT;
+        return STD_WRITE1_END;
+    } else
+    {
+        /* write-0; bus released on the next step */
+        _bb.setBus(0);
+        _state = ST_WRITE0_RELEASE;
+        return STD_WRITE0_LOW;
+    }
+}
+
+TIME_CRITICAL unsigned OneWireNg_BitBangAsync::complete(OneWireNg::ErrorCode ec)
+{
+    Request *req = _req;
+
+    /* dequeue (performed in the timer context) */
+    _head = req->_next;
+    if (!_head) _tail = NULL;
+    _req = NULL;
+    /* not idle, requests submitted by the callback are not kicked off */
+    _state = ST_START;
+
+    req->_ec = ec;
+    req->_queued = false;
+    req->_done = true;
+
+    if (req->_cb)
+        req->_cb(*req, req->_arg);
+
+    /* proceed with the next request (if any) */
+    return step();
+}
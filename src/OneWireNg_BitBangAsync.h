@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_BITBANG_ASYNC__
+#define __OWNG_BITBANG_ASYNC__
+
+#include "OneWireNg_BitBang.h"
+
+/**
+ * Timer driven, asynchronous bit-banging engine.
+ *
+ * The engine performs 1-wire bus activities via GPIO interface of a given
+ * bit-banging driver (@ref OneWireNg_BitBang), but instead of busy-waiting
+ * slots timings, each slot is split into steps advanced by a platform timer.
+ * The timer's callback shall call @ref onTimer(), which performs the current
+ * step and re-arms the timer for the next one. The CPU is busy-waiting only
+ * for the short, strict parts of read slots (write-1 low and sampling time),
+ * reset and write-0 slots are entirely timer driven.
+ *
+ * Bus activities are requested by queuing @ref Request objects, each of them
+ * describing a transaction: an optional reset followed by bytes touched on
+ * the bus. Requests are processed in the FIFO order, a request's callback
+ * is called (in the timer's callback context) on the request completion.
+ *
+ * @note The engine supports standard (non-overdrive) speed only.
+ * @note The platform timer is required to provide accuracy of few usecs to
+ *     fulfill presence pulse sampling timing (68-75 usecs after the reset
+ *     pulse release).
+ * @note The bit-banging driver shall not be used directly while the engine
+ *     is processing requests.
+ */
+class OneWireNg_BitBangAsync
+{
+public:
+    /**
+     * Platform timer interface.
+     */
+    class Timer
+    {
+    public:
+        virtual ~Timer() {}
+
+        /**
+         * Start single-shot timer, which shall call
+         * @ref OneWireNg_BitBangAsync::onTimer() after @c us microseconds.
+         */
+        virtual void start(unsigned us) = 0;
+    };
+
+    /**
+     * Bus transaction request.
+     */
+    class Request
+    {
+    public:
+        /**
+         * Request completion callback.
+         */
+        typedef void (*Callback)(Request& req, void *arg);
+
+        Request(): _next(NULL), _queued(false), _done(true),
+            _ec(OneWireNg::EC_SUCCESS) {}
+
+        /**
+         * Set the request.
+         *
+         * @param bytes Bytes to be touched on the bus. Result is passed back
+         *     in the same buffer (the buffer must be valid until the request
+         *     completes).
+         * @param len Number of bytes to touch (may be 0 for reset only).
+         * @param reset If @c true, reset is transmitted before the bytes.
+         * @param power If @c true, the bus is powered after the last byte.
+         *     See @ref OneWireNg::powerBus() for details.
+         * @param cb Completion callback (may be @c NULL).
+         * @param arg Callback's argument.
+         */
+        void set(uint8_t *bytes, size_t len, bool reset = false,
+            bool power = false, Callback cb = NULL, void *arg = NULL)
+        {
+            _bytes = bytes;
+            _len = len;
+            _reset = reset;
+            _power = power;
+            _cb = cb;
+            _arg = arg;
+        }
+
+        /**
+         * Check if the request has been completed.
+         */
+        bool isDone() const {
+            return _done;
+        }
+
+        /**
+         * Get completed request status:
+         * - @c EC_SUCCESS: Request finished with success.
+         * - @c EC_NO_DEVS: No devices detected on the reset (touch bytes not
+         *   performed).
+         */
+        OneWireNg::ErrorCode getStatus() const {
+            return _ec;
+        }
+
+    private:
+        uint8_t *_bytes;
+        size_t _len;
+        bool _reset;
+        bool _power;
+        Callback _cb;
+        void *_arg;
+
+        Request *_next;
+        volatile bool _queued;
+        volatile bool _done;
+        OneWireNg::ErrorCode _ec;
+
+    friend class OneWireNg_BitBangAsync;
+    };
+
+    /**
+     * Engine constructor.
+     *
+     * @param bb Bit-banging driver providing GPIO interface.
+     * @param timer Platform timer.
+     */
+    OneWireNg_BitBangAsync(OneWireNg_BitBang& bb, Timer& timer):
+        _bb(bb), _timer(timer), _head(NULL), _tail(NULL), _state(ST_IDLE) {}
+
+    /**
+     * Queue a request.
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Request queued.
+     *     - @c EC_FULL: The request is already queued.
+     */
+    OneWireNg::ErrorCode submit(Request& req);
+
+    /**
+     * Check if the engine is idle (no requests processed).
+     */
+    bool isIdle() const {
+        return (_state == ST_IDLE && !_head);
+    }
+
+    /**
+     * Timer callback. Performs the current step and re-arms the timer
+     * for the next one.
+     */
+    void onTimer();
+
+    /**
+     * Perform single step of the engine's state machine.
+     *
+     * @return Time (in microseconds) to the next step. 0 if there are
+     *     no more requests to process.
+     *
+     * @note The routine is exposed as a platform agnostic interface of the
+     *     engine. Normally @ref onTimer() shall be used.
+     */
+    unsigned step();
+
+private:
+    typedef enum {
+        ST_IDLE = 0,        /** no timer armed */
+        ST_START,           /** next request start pending */
+        ST_RESET_RELEASE,
+        ST_RESET_SAMPLE,
+        ST_RESET_END,
+        ST_BIT,
+        ST_WRITE0_RELEASE
+    } State;
+
+    bool lastBit() const {
+        return (_pos + 1 >= _req->_len && _bit >= 7);
+    }
+
+    void nextBit(int smpl);
+    unsigned startBit();
+    unsigned complete(OneWireNg::ErrorCode ec);
+
+    OneWireNg_BitBang& _bb;
+    Timer& _timer;
+
+    Request *_head;     /** requests queue */
+    Request *_tail;
+
+    Request *_req;      /** currently processed request */
+    volatile uint8_t _state;
+    size_t _pos;        /** processed byte */
+    int _bit;           /** processed bit of the byte */
+    uint8_t _rx;        /** received bits of the byte */
+    bool _presence;     /** presence pulse detected on reset */
+};
+
+#endif /* __OWNG_BITBANG_ASYNC__ */
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "OneWireNg_BitBangMulti.h"
+#include "OneWireNg_BitBangTiming.h"
+#include "platform/Platform_Delay.h"
+
+TIME_CRITICAL uint32_t OneWireNg_BitBangMulti::reset(uint32_t mask)
+{
+    uint32_t presPulse;
+
+    if (_pwre & mask) powerBus(mask, false);
+
+    setPortAsOutput(mask, 0);
+    delayUs(STD_RESET_LOW);
+    TC_RELAXED_ENTER();
+    setPortAsInput(mask);
+    delayUs(STD_RESET_SMPL);
+    presPulse = readPortIn();
+    TC_RELAXED_EXIT();
+    delayUs(STD_RESET_END);
+
+    return (~presPulse & mask);
+}
+
+TIME_CRITICAL uint32_t OneWireNg_BitBangMulti::touchBits(
+    uint32_t mask, uint32_t bits, bool power)
+{
+    uint32_t smpl;
+    uint32_t w1 = (mask & bits);
+    uint32_t w0 = (mask & ~bits);
+
+    if (_pwre & mask) powerBus(mask, false);
+
+    /*
+     * All the buses start the slot at the same time. Buses touched with 1
+     * are released and sampled as for write-1 (strict timing), while the
+     * rest stay low till the end of write-0 low time (relaxed timing).
+     */
+    TC_STRICT_ENTER();
+    setPortAsOutput(mask, 0);
+    delayUs(STD_WRITE1_LOW);
+    if (w1) setPortAsInput(w1);
+    delayUs(STD_WRITE1_SMPL);
+    smpl = readPortIn();
+    TC_STRICT_TO_RELAXED();
+    delayUs(STD_WRITE0_LOW - STD_WRITE1_LOW - STD_WRITE1_SMPL);
+    if (w0) setPortAsInput(w0);
+    if (power) powerBus(mask, true);
+    TC_RELAXED_EXIT();
+    delayUs(STD_WRITE0_END);
+
+    return (smpl & mask);
+}
+
+void OneWireNg_BitBangMulti::touchBytes(
+    uint32_t mask, uint8_t *bytes, size_t len, bool power)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        for (int b = 0; b < 8; b++)
+        {
+            uint32_t bits = 0;
+            uint32_t m;
+            uint8_t *p;
+
+            for (m = mask, p = &bytes[i]; m; m &= m - 1, p += len) {
+                if ((*p >> b) & 1)
+                    bits |= (m & (~m + 1));
+            }
+
+            bits = touchBits(mask, bits, (power && i + 1 >= len && b >= 7));
+
+            for (m = mask, p = &bytes[i]; m; m &= m - 1, p += len) {
+                if (bits & m & (~m + 1)) {
+                    *p |= (uint8_t)(1 << b);
+                } else {
+                    *p &= (uint8_t)~(1 << b);
+                }
+            }
+        }
+    }
+}
+
+void OneWireNg_BitBangMulti::writeBytes(
+    uint32_t mask, const uint8_t *bytes, size_t len, bool power)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        for (int b = 0; b < 8; b++) {
+            touchBits(mask, ((bytes[i] >> b) & 1 ? mask : 0),
+                (power && i + 1 >= len && b >= 7));
+        }
+    }
+}
+
+void OneWireNg_BitBangMulti::powerBus(uint32_t mask, bool on)
+{
+    if (on) {
+        setPortAsOutput(mask, 1);
+        _pwre |= mask;
+    } else {
+        setPortAsInput(mask);
+        _pwre &= ~mask;
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_BITBANG_MULTI__
+#define __OWNG_BITBANG_MULTI__
+
+#include <string.h>  /* memset */
+#include "OneWireNg.h"
+
+/**
+ * Lockstep, multi-bus GPIO bit-banged implementation of 1-wire bus activities.
+ *
+ * The class drives up to 32 1-wire buses connected to GPIOs sharing the same
+ * GPIO port (registers). Bus activities (reset, write and read slots) are
+ * performed simultaneously on a set of buses with single port registers
+ * writes, and the buses are sampled with a single port register read. As
+ * a result the buses are served in the bus time of a single one, e.g.
+ * temperature conversion followed by scratchpad reading on 8 buses (each of
+ * them with a single sensor) costs the same as on a single bus.
+ *
+ * A bus is identified by its GPIO bit mask on the port, set of buses is
+ * identified by bit mask being a sum of the buses masks. If there is a need
+ * to pass a separate data for each bus (e.g. @ref touchBytes()) the data is
+ * passed in the buffer where the buses data are placed one after another in
+ * the order of the buses bits positions in the mask (starting from the least
+ * significant bit).
+ *
+ * The class relies on virtual functions provided by derivative class to
+ * perform platform specific GPIO port operations. The platform specific class
+ * shall provide:
+ * - @ref readPortIn(): read operation.
+ * - @ref setPortAsInput(), @ref setPortAsOutput(): set GPIOs working mode.
+ *
+ * @note The class supports standard (non-overdrive) speed only.
+ * @note Bus powering is supported via switching the buses GPIOs to the high
+ *     state only (no power-control-GPIO).
+ */
+class OneWireNg_BitBangMulti
+{
+public:
+    /**
+     * Reset a set of buses.
+     *
+     * @param mask Buses mask.
+     * @return Mask of buses with presence pulse detected.
+     */
+    uint32_t reset(uint32_t mask);
+
+    /**
+     * Touch a bit simultaneously on a set of buses.
+     *
+     * @param mask Buses mask.
+     * @param bits Bits to touch on the buses (bit value for a bus is taken
+     *     from the bus bit position in @c bits).
+     * @param power If @c true enable power provisioning on the buses after
+     *     the touch. See @ref powerBus() for details.
+     * @return Sampled bits (bit value for a bus is returned on the bus bit
+     *     position).
+     */
+    uint32_t touchBits(uint32_t mask, uint32_t bits, bool power = false);
+
+    /**
+     * Touch a number of bytes on a set of buses. Separate bytes are touched
+     * for each bus.
+     *
+     * @param mask Buses mask.
+     * @param bytes Buses bytes buffer: @c len bytes for each of buses in
+     *     the mask, one after another starting from the bus on the least
+     *     significant bit of the mask. Result is passed back in the same
+     *     buffer.
+     * @param len Number of bytes to touch on each bus.
+     * @param power If @c true enable power provisioning on the buses after
+     *     the last touched bit.
+     */
+    void touchBytes(uint32_t mask, uint8_t *bytes, size_t len,
+        bool power = false);
+
+    /**
+     * Write the same bytes simultaneously on a set of buses.
+     *
+     * @param mask Buses mask.
+     * @param bytes Bytes to write.
+     * @param len Number of bytes to write.
+     * @param power If @c true enable power provisioning on the buses after
+     *     the last written bit.
+     */
+    void writeBytes(uint32_t mask, const uint8_t *bytes, size_t len,
+        bool power = false);
+
+    /**
+     * Read a number of bytes simultaneously from a set of buses.
+     *
+     * @param mask Buses mask.
+     * @param bytes Buffer for the read bytes (organized as described in
+     *     @ref touchBytes()).
+     * @param len Number of bytes to read from each bus.
+     */
+    void readBytes(uint32_t mask, uint8_t *bytes, size_t len)
+    {
+        memset(bytes, 0xff, busesNum(mask) * len);
+        touchBytes(mask, bytes, len);
+    }
+
+    /**
+     * Enable/disable direct voltage source provisioning on a set of buses.
+     */
+    void powerBus(uint32_t mask, bool on);
+
+    /**
+     * Get mask of all buses handled by the object.
+     */
+    uint32_t getBusesMask() const {
+        return _buses;
+    }
+
+    /**
+     * Get number of buses in the mask.
+     */
+    static size_t busesNum(uint32_t mask)
+    {
+        size_t n = 0;
+        for (; mask; mask &= mask - 1) n++;
+        return n;
+    }
+
+protected:
+    /**
+     * This class is intended to be inherited by specialized classes.
+     */
+    OneWireNg_BitBangMulti(): _buses(0), _pwre(0) {}
+
+    virtual ~OneWireNg_BitBangMulti() {}
+
+    /**
+     * Utility routine. Shall be called from inheriting class to initialize
+     * GPIOs of the handled buses.
+     */
+    void setupBuses(uint32_t mask)
+    {
+        _buses = mask;
+        setPortAsInput(mask);
+    }
+
+    /**
+     * Read GPIO port and return its state.
+     */
+    virtual uint32_t readPortIn() = 0;
+
+    /**
+     * Set port's GPIOs given by @c mask in the input-mode.
+     */
+    virtual void setPortAsInput(uint32_t mask) = 0;
+
+    /**
+     * Set port's GPIOs given by @c mask in the output-mode with an initial
+     * @c state (0: low, 1: high).
+     *
+     * @note The function should guarantee no intermediate "blink" state
+     *     between switching the GPIOs into the output mode and setting
+     *     the initial value on the pins.
+     */
+    virtual void setPortAsOutput(uint32_t mask, int state) = 0;
+
+    uint32_t _buses;    /** handled buses mask */
+    uint32_t _pwre;     /** powered buses mask */
+
+#ifdef OWNG_TEST
+friend class OneWireNg_BitBangMulti_Test;
+#endif
+};
+
+#endif /* __OWNG_BITBANG_MULTI__ */
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2019-2022,2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+/*
+ * Bit-banging timings and time critical sections definitions shared by
+ * bit-banging drivers implementation. Internal header.
+ */
+
+#ifndef __OWNG_BITBANG_TIMING__
+#define __OWNG_BITBANG_TIMING__
+
+#include "platform/Platform_TimeCritical.h"
+
+#define TIMING_STRICT   1
+#define TIMING_RELAXED  2
+#define TIMING_NULL     3
+
+#if (CONFIG_BITBANG_TIMING == TIMING_STRICT)
+# define TC_STRICT_ENTER() timeCriticalEnter()
+# define TC_STRICT_EXIT() timeCriticalExit()
+# define TC_RELAXED_ENTER() timeCriticalEnter()
+# define TC_RELAXED_EXIT() timeCriticalExit()
+# define TC_RELAXED_TO_STRICT()
+# define TC_STRICT_TO_RELAXED()
+#elif (CONFIG_BITBANG_TIMING == TIMING_RELAXED)
+# define TC_STRICT_ENTER() timeCriticalEnter()
+# define TC_STRICT_EXIT() timeCriticalExit()
+# define TC_RELAXED_ENTER()
+# define TC_RELAXED_EXIT()
+# define TC_RELAXED_TO_STRICT() timeCriticalEnter()
+# define TC_STRICT_TO_RELAXED() timeCriticalExit()
+#elif (CONFIG_BITBANG_TIMING == TIMING_NULL)
+# define TC_STRICT_ENTER()
+# define TC_STRICT_EXIT()
+# define TC_RELAXED_ENTER()
+# define TC_RELAXED_EXIT()
+# define TC_RELAXED_TO_STRICT()
+# define TC_STRICT_TO_RELAXED()
+#else
+# error "Invalid CONFIG_BITBANG_TIMING"
+#endif
+
+/*
+ * Standard mode timings
+ */
+/* min. 480 us */
+#define STD_RESET_LOW   480
+/* reset high; presence-detect sampling: 68-75 us (relaxed) */
+#define STD_RESET_SMPL  70
+/* reset trailing high */
+#define STD_RESET_END   410
+/* presence pulse timing measurement: sampling step and window (relaxed) */
+#define STD_PRES_STEP   2
+#define STD_PRES_MAX    300
+
+/* write-0 low: 60-120 us (relaxed) */
+#define STD_WRITE0_LOW  60
+/* write-0 trailing high: 5-15 us */
+#define STD_WRITE0_END  10
+
+/* write-1 low (strict) */
+#define STD_WRITE1_LOW  5
+/* write-1 high; sampling max 15 us (low + high; strict) */
+#define STD_WRITE1_SMPL 8
+/* write-1 trailing high */
+#define STD_WRITE1_END  56
+
+/*
+ * Overdrive mode timings
+ */
+/* reset low: 53-80 us (relaxed) */
+#define OD_RESET_LOW    68
+/* reset high; presence-detect sampling: 8-9 us (strict) */
+#define OD_RESET_SMPL   8
+/* reset high; trailing part */
+#define OD_RESET_END    40
+/* presence pulse timing measurement: sampling step and window (strict) */
+#define OD_PRES_STEP    1
+#define OD_PRES_MAX     32
+
+/* write-0 low: 8-13 us (strict) */
+#define OD_WRITE0_LOW   8
+/* write-0 trailing high: 1-2 us */
+#define OD_WRITE0_END   1
+
+/* write-1 low: 0-1 us (strict) */
+#define OD_WRITE1_LOW   0   /* <=0: no delay, >0: usec delay */
+/* write-1 high; sampling max 2 us (low + high; strict) */
+#define OD_WRITE1_SMPL  0   /* <=0: no delay, >0: usec delay */
+/* write-1 trailing high */
+#define OD_WRITE1_END   7
+
+#endif /* __OWNG_BITBANG_TIMING__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2025 Piotr Stolarz
+ * Copyright (c) 2019-2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -307,6 +307,18 @@
 #  define CONFIG_DS18S20_EXT_RES 0
 # endif
 
+/**
+ * Dallas thermometers specific.
+ *
+ * Configuring this boolean parameter enables @c DSTherm::Cache support.
+ * The cache keeps sensors parameters learned from scratchpads read or written
+ * by the driver, which are next used to shorten temperature conversion waits.
+ * Optionally, the cache may serve recently read scratchpads.
+ */
+# ifndef CONFIG_DSTHERM_CACHE
+#  define CONFIG_DSTHERM_CACHE 0
+# endif
+
 /**
  * For ESP8266 platform there were reported problems when no extra time
  * has been given after the 1-wire service creation. This parameter specifies
@@ -354,6 +366,15 @@
 # define CONFIG_RP2040_PIOSM_NUM_USED 1
 #endif
 
+/**
+ * For RP2040 platform and @ref OneWireNg_PicoRP2040PIO driver, configuring
+ * the boolean parameter enables DMA transfers for bytes touched by the PIO
+ * bytes touch program. The driver claims 2 DMA channels in this case.
+ */
+#ifndef CONFIG_RP2040_PIO_DMA
+# define CONFIG_RP2040_PIO_DMA 0
+#endif
+
 #endif
 
 /*
@@ -440,6 +461,13 @@
 # endif
 #endif
 
+#ifdef CONFIG_DSTHERM_CACHE
+# if (__EXT1(CONFIG_DSTHERM_CACHE) == 1)
+#  undef CONFIG_DSTHERM_CACHE
+#  define CONFIG_DSTHERM_CACHE 1
+# endif
+#endif
+
 #ifdef CONFIG_RP2040_PIO_DRIVER
 # if (__EXT1(CONFIG_RP2040_PIO_DRIVER) == 1)
 #  undef CONFIG_RP2040_PIO_DRIVER
@@ -447,6 +475,13 @@
 # endif
 #endif
 
+#ifdef CONFIG_RP2040_PIO_DMA
+# if (__EXT1(CONFIG_RP2040_PIO_DMA) == 1)
+#  undef CONFIG_RP2040_PIO_DMA
+#  define CONFIG_RP2040_PIO_DMA 1
+# endif
+#endif
+
 #undef __EXT1
 #undef __XEXT1
 
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/DS2408.h"
+
+#if CONFIG_CRC16_ENABLED
+
+/* command confirmation */
+#define CONFIRM 0xaa
+
+OneWireNg::ErrorCode DS2408::readStream(uint8_t *samples, size_t n)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(_id);
+    if (ec != OneWireNg::EC_SUCCESS || !n)
+        return ec;
+
+    uint8_t cmd = CMD_CHANNEL_READ;
+    _ow.writeByte(cmd);
+
+    /* CRC of the 1st block covers the command */
+    uint16_t crc16 = OneWireNg::crc16(&cmd, 1);
+
+    /* block samples followed by inverted CRC-16 */
+    uint8_t buf[CRC_BLOCK + 2];
+
+    while (n > 0)
+    {
+        size_t len = (n < CRC_BLOCK ? n : CRC_BLOCK);
+
+        /* full blocks are read directly into the output table */
+        uint8_t *blk = (len == CRC_BLOCK ? samples : buf);
+        _ow.readBytes(blk, CRC_BLOCK);
+        _ow.readBytes(&buf[CRC_BLOCK], 2);
+
+        crc16 = OneWireNg::crc16(blk, CRC_BLOCK, crc16);
+        if ((uint16_t)(crc16 ^ ~OneWireNg::getLSB_u16(&buf[CRC_BLOCK])))
+            return OneWireNg::EC_CRC_ERROR;
+        crc16 = 0;
+
+        if (blk != samples)
+            memcpy(samples, blk, len);
+
+        samples += len;
+        n -= len;
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2408::writeStream(
+    const uint8_t *states, size_t n, uint8_t *pins)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(_id);
+    if (ec != OneWireNg::EC_SUCCESS || !n)
+        return ec;
+
+    _ow.writeByte(CMD_CHANNEL_WRITE);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        /* state, its complement, then confirmation and pins state */
+        uint8_t cmd[4] = {
+            states[i], (uint8_t)~states[i], 0xff, 0xff
+        };
+
+        _ow.touchBytes(cmd, sizeof(cmd));
+        if (cmd[2] != CONFIRM)
+            return OneWireNg::EC_BUS_ERROR;
+        if (pins)
+            pins[i] = cmd[3];
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2408::resetActivity()
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(_id);
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        uint8_t cmd[2] = { CMD_RESET_ACTIVITY, 0xff };
+
+        _ow.touchBytes(cmd, sizeof(cmd));
+        if (cmd[1] != CONFIRM)
+            ec = OneWireNg::EC_BUS_ERROR;
+    }
+    return ec;
+}
+
+#endif /* CONFIG_CRC16_ENABLED */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS2408__
+#define __OWNG_DS2408__
+
+#include <string.h>  /* memcpy */
+#include "OneWireNg.h"
+
+#if CONFIG_CRC16_ENABLED
+
+/**
+ * DS2408 8-channel addressable switch driver.
+ *
+ * Channel access commands are used in the streaming mode: the device is
+ * addressed once and then any number of PIO samples is read (or output
+ * states written) with no further resets nor addressing. Read samples are
+ * verified by CRC-16 sent by the device after each 32 samples, each write
+ * is confirmed by the device.
+ *
+ * @note Requires @c CONFIG_CRC16_ENABLED.
+ */
+class DS2408
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x29;
+
+    /** Function commands */
+    const static uint8_t CMD_CHANNEL_READ   = 0xf5;
+    const static uint8_t CMD_CHANNEL_WRITE  = 0x5a;
+    const static uint8_t CMD_RESET_ACTIVITY = 0xc3;
+
+    /** Number of samples covered by a single CRC-16 in a read stream */
+    const static size_t CRC_BLOCK = 32;
+
+    DS2408(OneWireNg& ow, const OneWireNg::Id& id): _ow(ow) {
+        memcpy(&_id, &id, sizeof(OneWireNg::Id));
+    }
+
+    const OneWireNg::Id& getId() const {
+        return _id;
+    }
+
+    /**
+     * Read PIO pins state (single sample).
+     *
+     * @return Same as for @ref readStream().
+     */
+    OneWireNg::ErrorCode readPio(uint8_t& state) {
+        return readStream(&state, 1);
+    }
+
+    /**
+     * Read a stream of PIO pins state samples by a single "Channel-Access
+     * Read" command.
+     *
+     * @param samples Output table of samples.
+     * @param n Number of samples to read.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error. Samples preceding the erroneous
+     *         block of @ref CRC_BLOCK samples are valid.
+     *
+     * @note Samples are verified in blocks of @ref CRC_BLOCK, therefore
+     *     up to @ref CRC_BLOCK - 1 samples exceeding @c n may be read from
+     *     the device to verify the last block.
+     */
+    OneWireNg::ErrorCode readStream(uint8_t *samples, size_t n);
+
+    /**
+     * Write PIO output latches.
+     *
+     * @param state Output state (bit set turns the output transistor off).
+     * @param pins If not @c NULL PIO pins state sampled after the write is
+     *     written there.
+     *
+     * @return Same as for @ref writeStream().
+     */
+    OneWireNg::ErrorCode writePio(uint8_t state, uint8_t *pins = NULL) {
+        return writeStream(&state, 1, pins);
+    }
+
+    /**
+     * Write a stream of PIO output states by a single "Channel-Access Write"
+     * command.
+     *
+     * @param states Output states to write.
+     * @param n Number of states.
+     * @param pins If not @c NULL PIO pins states sampled after each write
+     *     are written there (table of @c n elements).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_BUS_ERROR: Write not confirmed by the device (the stream
+     *         is stopped).
+     */
+    OneWireNg::ErrorCode writeStream(
+        const uint8_t *states, size_t n, uint8_t *pins = NULL);
+
+    /**
+     * Reset activity latches.
+     *
+     * @return Same as for @ref writeStream().
+     */
+    OneWireNg::ErrorCode resetActivity();
+
+protected:
+    OneWireNg& _ow;
+    OneWireNg::Id _id;
+};
+
+#endif /* CONFIG_CRC16_ENABLED */
+#endif /* __OWNG_DS2408__ */
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/DS2409.h"
+
+OneWireNg::ErrorCode DS2409::smartOn(
+    const OneWireNg::Id& id, Branch branch)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(id);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    uint8_t cmd = (branch == BRANCH_AUX ? CMD_SMART_ON_AUX : CMD_SMART_ON_MAIN);
+    _ow.writeByte(cmd);
+
+    /* reset stimulus; the coupler resets the branch */
+    _ow.writeByte(0xff);
+
+    /* presence detect byte, confirmation byte */
+    uint8_t buf[2];
+    _ow.readBytes(buf, sizeof(buf));
+
+    if (buf[1] != cmd)
+        return OneWireNg::EC_BUS_ERROR;
+    return (buf[0] != 0xff ? OneWireNg::EC_SUCCESS : OneWireNg::EC_NO_DEVS);
+}
+
+OneWireNg::ErrorCode DS2409::command(const OneWireNg::Id *id, uint8_t cmd)
+{
+    OneWireNg::ErrorCode ec =
+        (id ? _ow.addressSingle(*id) : _ow.addressAll());
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        _ow.writeByte(cmd);
+        if (_ow.readByte() != cmd)
+            ec = OneWireNg::EC_BUS_ERROR;
+    }
+    return ec;
+}
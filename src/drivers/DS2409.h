@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS2409__
+#define __OWNG_DS2409__
+
+#include "OneWireNg.h"
+
+/**
+ * DS2409 MicroLAN coupler driver.
+ *
+ * The coupler connects its main or auxiliary branch to the trunk 1-wire
+ * bus (at most one of them at a time). Devices on an activated branch are
+ * accessed as any other device on the trunk, that is they are addressed
+ * by reset and a ROM command issued on the trunk. All coupler's commands
+ * are confirmed by the coupler sending back the command code.
+ *
+ * @see MicroLan for a topology aware roster of devices behind couplers.
+ */
+class DS2409
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x1f;
+
+    /** Function commands */
+    const static uint8_t CMD_ALL_LINES_OFF = 0x66;
+    const static uint8_t CMD_DISCHARGE_LINES = 0x99;
+    const static uint8_t CMD_DIRECT_ON_MAIN = 0xa5;
+    const static uint8_t CMD_SMART_ON_MAIN = 0xcc;
+    const static uint8_t CMD_SMART_ON_AUX = 0x33;
+
+    /** Coupler branch */
+    enum Branch {
+        BRANCH_MAIN = 0,
+        BRANCH_AUX
+    };
+
+    DS2409(OneWireNg& ow): _ow(ow) {}
+
+    /**
+     * Disconnect both branches of an addressed coupler.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_BUS_ERROR: Command not confirmed by the coupler.
+     */
+    OneWireNg::ErrorCode allLinesOff(const OneWireNg::Id& id) {
+        return command(&id, CMD_ALL_LINES_OFF);
+    }
+
+    /**
+     * Disconnect branches of all couplers on the bus.
+     *
+     * @see allLinesOff()
+     */
+    OneWireNg::ErrorCode allLinesOffAll() {
+        return command(NULL, CMD_ALL_LINES_OFF);
+    }
+
+    /**
+     * Discharge both branches of an addressed coupler (the branches are
+     * disconnected afterwards). May be used to reset devices on the
+     * branches to their power-on state.
+     *
+     * @see allLinesOff()
+     */
+    OneWireNg::ErrorCode dischargeLines(const OneWireNg::Id& id) {
+        return command(&id, CMD_DISCHARGE_LINES);
+    }
+
+    /**
+     * Connect main branch of an addressed coupler with no reset generated
+     * on the branch.
+     *
+     * @see allLinesOff()
+     */
+    OneWireNg::ErrorCode directOnMain(const OneWireNg::Id& id) {
+        return command(&id, CMD_DIRECT_ON_MAIN);
+    }
+
+    /**
+     * Connect a branch of an addressed coupler. The coupler generates reset
+     * on the branch and reports presence of devices there. The other branch
+     * of the coupler is disconnected.
+     *
+     * @param id Coupler id.
+     * @param branch Branch to connect.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus or no presence detected on
+     *         the branch (the branch is connected anyway in the latter case).
+     *     - @c EC_BUS_ERROR: Command not confirmed by the coupler.
+     */
+    OneWireNg::ErrorCode smartOn(const OneWireNg::Id& id, Branch branch);
+
+protected:
+    OneWireNg::ErrorCode command(const OneWireNg::Id *id, uint8_t cmd);
+
+    OneWireNg& _ow;
+
+#ifdef OWNG_TEST
+    friend class DS2409_Test;
+#endif
+};
+
+#endif /* __OWNG_DS2409__ */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/DS2413.h"
+
+/* command confirmation */
+#define CONFIRM 0xaa
+
+OneWireNg::ErrorCode DS2413::readStream(
+    uint8_t *samples, size_t n, uint8_t *latches)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(_id);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    _ow.writeByte(CMD_PIO_READ);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        /*
+         * Status: PIOA pin, PIOA latch, PIOB pin, PIOB latch; upper nibble
+         * is the complement of the lower one.
+         */
+        uint8_t st = _ow.readByte();
+        if (((st ^ (st >> 4)) & 0x0f) != 0x0f)
+            return OneWireNg::EC_CRC_ERROR;
+
+        samples[i] = (uint8_t)((st & 0x01) | ((st >> 1) & 0x02));
+        if (latches)
+            latches[i] = (uint8_t)(((st >> 1) & 0x01) | ((st >> 2) & 0x02));
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2413::writeStream(const uint8_t *states, size_t n)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(_id);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    _ow.writeByte(CMD_PIO_WRITE);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        /* unused bits need to be set */
+        uint8_t out = (uint8_t)(states[i] | ~(PIOA | PIOB));
+
+        /* state, its complement, then confirmation and PIO status */
+        uint8_t cmd[4] = { out, (uint8_t)~out, 0xff, 0xff };
+
+        _ow.touchBytes(cmd, sizeof(cmd));
+        if (cmd[2] != CONFIRM)
+            return OneWireNg::EC_BUS_ERROR;
+    }
+    return ec;
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS2413__
+#define __OWNG_DS2413__
+
+#include <string.h>  /* memcpy */
+#include "OneWireNg.h"
+
+/**
+ * DS2413 dual channel addressable switch driver.
+ *
+ * PIO access commands are used in the streaming mode: the device is
+ * addressed once and then any number of PIO status samples is read (or
+ * output states written) with no further resets nor addressing. Each read
+ * sample is verified by its complemented copy, each write is confirmed by
+ * the device.
+ */
+class DS2413
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x3a;
+
+    /** Function commands */
+    const static uint8_t CMD_PIO_READ  = 0xf5;
+    const static uint8_t CMD_PIO_WRITE = 0x5a;
+
+    /** PIO state bits */
+    const static uint8_t PIOA = 0x01;
+    const static uint8_t PIOB = 0x02;
+
+    DS2413(OneWireNg& ow, const OneWireNg::Id& id): _ow(ow) {
+        memcpy(&_id, &id, sizeof(OneWireNg::Id));
+    }
+
+    const OneWireNg::Id& getId() const {
+        return _id;
+    }
+
+    /**
+     * Read PIO pins state (single sample).
+     *
+     * @param state Pins state (@ref PIOA, @ref PIOB bits).
+     *
+     * @return Same as for @ref readStream().
+     */
+    OneWireNg::ErrorCode readPio(uint8_t& state) {
+        return readStream(&state, 1);
+    }
+
+    /**
+     * Read a stream of PIO pins state samples by a single "PIO Access Read"
+     * command.
+     *
+     * @param samples Output table of samples (@ref PIOA, @ref PIOB bits).
+     * @param n Number of samples to read.
+     * @param latches If not @c NULL output latches state of each sample is
+     *     written there (table of @c n elements).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: Sample integrity check failed (samples
+     *         preceding the erroneous one are valid).
+     */
+    OneWireNg::ErrorCode readStream(
+        uint8_t *samples, size_t n, uint8_t *latches = NULL);
+
+    /**
+     * Write PIO output latches.
+     *
+     * @param state Output state (@ref PIOA, @ref PIOB bits; bit set turns
+     *     the output transistor off).
+     *
+     * @return Same as for @ref writeStream().
+     */
+    OneWireNg::ErrorCode writePio(uint8_t state) {
+        return writeStream(&state, 1);
+    }
+
+    /**
+     * Write a stream of PIO output states by a single "PIO Access Write"
+     * command.
+     *
+     * @param states Output states to write (@ref PIOA, @ref PIOB bits).
+     * @param n Number of states.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_BUS_ERROR: Write not confirmed by the device (the stream
+     *         is stopped).
+     */
+    OneWireNg::ErrorCode writeStream(const uint8_t *states, size_t n);
+
+protected:
+    OneWireNg& _ow;
+    OneWireNg::Id _id;
+};
+
+#endif /* __OWNG_DS2413__ */
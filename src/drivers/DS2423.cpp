@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/DS2423.h"
+
+#if CONFIG_CRC16_ENABLED
+
+OneWireNg::ErrorCode DS2423::readCounter(
+    const OneWireNg::Id& id, int page, uint32_t& counter)
+{
+    if (page < PAGE_FIRST_COUNTER || page >= PAGES_NUM)
+        return OneWireNg::EC_UNSUPPORED;
+
+    /* start at the last byte of the page */
+    uint8_t last;
+    return _readMemCounter(id, (page + 1) * PAGE_SIZE - 1, &last, &counter);
+}
+
+OneWireNg::ErrorCode DS2423::readPage(const OneWireNg::Id& id,
+    int page, uint8_t *data, uint32_t *counter)
+{
+    if (page < 0 || page >= PAGES_NUM)
+        return OneWireNg::EC_UNSUPPORED;
+
+    return _readMemCounter(id, page * PAGE_SIZE, data, counter);
+}
+
+OneWireNg::ErrorCode DS2423::snapshot(
+    const OneWireNg::Id *ids, size_t n, Counters *counters)
+{
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+
+    for (size_t i = 0; i < n; i++) {
+        readCounters(ids[i], counters[i]);
+        if (counters[i].status != OneWireNg::EC_SUCCESS)
+            ec = (OneWireNg::ErrorCode)counters[i].status;
+    }
+    return ec;
+}
+
+#if CONFIG_SEARCH_ENABLED
+OneWireNg::ErrorCode DS2423::snapshotAll(
+    Counters *counters, size_t max, size_t& n)
+{
+    OneWireNg::ErrorCode ec;
+    OneWireNg::Id id;
+
+    n = 0;
+    _ow.searchReset();
+
+    while ((ec = _ow.search(id)) == OneWireNg::EC_MORE)
+    {
+        if (id[0] != FAMILY_CODE)
+            continue;
+
+        if (n >= max) {
+            ec = OneWireNg::EC_FULL;
+            break;
+        }
+        readCounters(id, counters[n++]);
+    }
+    return (ec == OneWireNg::EC_NO_DEVS ? OneWireNg::EC_SUCCESS : ec);
+}
+#endif
+
+void DS2423::readCounters(const OneWireNg::Id& id, Counters& counters)
+{
+    memcpy(counters.id, id, sizeof(OneWireNg::Id));
+
+    OneWireNg::ErrorCode ec = readCounter(id, PAGE_COUNTER_A, counters.a);
+    if (ec == OneWireNg::EC_SUCCESS)
+        ec = readCounter(id, PAGE_COUNTER_B, counters.b);
+
+    counters.status = (uint8_t)ec;
+}
+
+OneWireNg::ErrorCode DS2423::_readMemCounter(const OneWireNg::Id& id,
+    unsigned addr, uint8_t *data, uint32_t *counter)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(id);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    uint8_t cmd[3] = {
+        CMD_READ_MEMORY_COUNTER,
+        (uint8_t)(addr & 0xff),  /* TA1 */
+        (uint8_t)(addr >> 8)     /* TA2 */
+    };
+    uint16_t crc16 = OneWireNg::crc16(cmd, sizeof(cmd));
+    _ow.writeBytes(cmd, sizeof(cmd));
+
+    /* data up to the page end */
+    size_t len = PAGE_SIZE - (addr % PAGE_SIZE);
+    _ow.readBytes(data, len);
+    crc16 = OneWireNg::crc16(data, len, crc16);
+
+    /* counter, 4 zero bytes and inverted CRC-16 */
+    uint8_t buf[4 + 4 + 2];
+    _ow.readBytes(buf, sizeof(buf));
+    crc16 = OneWireNg::crc16(buf, 8, crc16);
+
+    if ((uint16_t)(crc16 ^ ~OneWireNg::getLSB_u16(&buf[8])))
+        return OneWireNg::EC_CRC_ERROR;
+
+    if (counter)
+        *counter = OneWireNg::getLSB_u32(buf);
+    return ec;
+}
+
+#endif /* CONFIG_CRC16_ENABLED */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS2423__
+#define __OWNG_DS2423__
+
+#include <string.h>  /* memcpy */
+#include "OneWireNg.h"
+
+#if CONFIG_CRC16_ENABLED
+
+/**
+ * DS2423 counter driver.
+ *
+ * Counters are read by "Read Memory + Counter" command, which returns
+ * the counter of a memory page after the page data, followed by CRC-16.
+ * To read a counter only, the command is started at the last byte of the
+ * page, so there is no need to clock the whole page data.
+ *
+ * @note Requires @c CONFIG_CRC16_ENABLED.
+ */
+class DS2423
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x1d;
+
+    /** Function commands */
+    const static uint8_t CMD_READ_MEMORY_COUNTER = 0xa5;
+
+    /** Memory geometry */
+    const static size_t PAGE_SIZE = 32;
+    const static int PAGES_NUM = 16;
+
+    /** Pages with counters; pages 14, 15 count pulses on inputs A, B */
+    const static int PAGE_FIRST_COUNTER = 12;
+    const static int PAGE_COUNTER_A = 14;
+    const static int PAGE_COUNTER_B = 15;
+
+    /**
+     * Counters snapshot of a device.
+     */
+    typedef struct
+    {
+        /** Device id */
+        OneWireNg::Id id;
+        /** Counter A (input A, page 14) */
+        uint32_t a;
+        /** Counter B (input B, page 15) */
+        uint32_t b;
+        /** Counters read status (@c OneWireNg::ErrorCode) */
+        uint8_t status;
+    } Counters;
+
+    DS2423(OneWireNg& ow): _ow(ow) {}
+
+    /**
+     * Read counter of a memory page (the page data is not read).
+     *
+     * @param id Device id.
+     * @param page Page number (@ref PAGE_FIRST_COUNTER - @ref PAGES_NUM - 1).
+     * @param counter Read counter.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error.
+     *     - @c EC_UNSUPPORED: No counter associated with the page.
+     */
+    OneWireNg::ErrorCode readCounter(
+        const OneWireNg::Id& id, int page, uint32_t& counter);
+
+    /**
+     * Read memory page with its counter.
+     *
+     * @param id Device id.
+     * @param page Page number (0 - @ref PAGES_NUM - 1).
+     * @param data Output buffer for the page data (@ref PAGE_SIZE bytes).
+     * @param counter If not @c NULL, the page counter is written there
+     *     (0xffffffff for pages with no counter).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error.
+     *     - @c EC_UNSUPPORED: Invalid page.
+     */
+    OneWireNg::ErrorCode readPage(const OneWireNg::Id& id,
+        int page, uint8_t *data, uint32_t *counter = NULL);
+
+    /**
+     * Read counters A and B of a number of devices.
+     *
+     * @param ids Devices ids.
+     * @param n Number of devices.
+     * @param counters Output table of counters (@c n elements). Read status
+     *     of each device is provided by @c Counters::status.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Counters of all devices read with success.
+     *     - Otherwise error of the last device failed to read (counters
+     *       of remaining devices are read anyway).
+     */
+    OneWireNg::ErrorCode snapshot(
+        const OneWireNg::Id *ids, size_t n, Counters *counters);
+
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Read counters A and B of all DS2423 devices on the bus. The devices
+     * are detected by the search process.
+     *
+     * @param counters Output table of counters.
+     * @param max Size of @c counters table.
+     * @param n Number of read devices.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success (also if no DS2423 has been found).
+     *     - @c EC_FULL: More devices than @c max on the bus (first @c max
+     *         of them are read).
+     *     - Search process error.
+     *
+     * @note Read status of each device is provided by @c Counters::status.
+     */
+    OneWireNg::ErrorCode snapshotAll(
+        Counters *counters, size_t max, size_t& n);
+#endif
+
+protected:
+    OneWireNg::ErrorCode _readMemCounter(const OneWireNg::Id& id,
+        unsigned addr, uint8_t *data, uint32_t *counter);
+
+    void readCounters(const OneWireNg::Id& id, Counters& counters);
+
+    OneWireNg& _ow;
+
+#ifdef OWNG_TEST
+    friend class DS2423_Test;
+#endif
+};
+
+#endif /* CONFIG_CRC16_ENABLED */
+#endif /* __OWNG_DS2423__ */
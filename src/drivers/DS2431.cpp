@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/DS2431.h"
+
+#if CONFIG_CRC16_ENABLED
+
+#include "platform/Platform_Delay.h"
+
+/* scratchpad E/S byte flags */
+#define ES_AA 0x80
+#define ES_PF 0x20
+#define ES_E_MASK 0x07
+
+/* copy scratchpad completion pattern */
+#define COPY_DONE 0xaa
+
+/* writable rows: data memory and control bytes */
+#define WRITABLE_ROWS (ROWS_NUM - 1)
+#define CTRL_ROW (DATA_SIZE / ROW_SIZE)
+
+OneWireNg::ErrorCode DS2431::address()
+{
+#if CONFIG_OVERDRIVE_ENABLED
+    if (_od)
+        return _ow.overdriveSingle(_id);
+#endif
+    return _ow.addressSingle(_id);
+}
+
+void DS2431::done()
+{
+#if CONFIG_OVERDRIVE_ENABLED
+    if (_od)
+        _ow.setOverdrive(false);
+#endif
+}
+
+OneWireNg::ErrorCode DS2431::readMem(
+    bool resume, unsigned addr, uint8_t *buf, size_t len)
+{
+    OneWireNg::ErrorCode ec = (resume ? _ow.resume() : address());
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        uint8_t cmd[3] = {
+            CMD_READ_MEMORY,
+            (uint8_t)(addr & 0xff),  /* TA1 */
+            (uint8_t)(addr >> 8)     /* TA2 */
+        };
+
+        _ow.writeBytes(cmd, sizeof(cmd));
+        _ow.readBytes(buf, len);
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::read(unsigned addr, void *buf, size_t len)
+{
+    if (addr + len > MEM_SIZE)
+        return OneWireNg::EC_UNSUPPORED;
+    if (!len)
+        return OneWireNg::EC_SUCCESS;
+
+    uint8_t *out = (uint8_t*)buf;
+    OneWireNg::ErrorCode ec = readMem(false, addr, out, len);
+    done();
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        /* update cache for fully covered, not dirty rows */
+        for (unsigned row = (addr + ROW_SIZE - 1) / ROW_SIZE;
+            (row + 1) * ROW_SIZE <= addr + len; row++)
+        {
+            if (!(_dirty & rowBit(row))) {
+                memcpy(&_mem[row * ROW_SIZE],
+                    &out[row * ROW_SIZE - addr], ROW_SIZE);
+                _valid |= rowBit(row);
+            }
+        }
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::loadRow(unsigned row)
+{
+    if ((_valid | _dirty) & rowBit(row))
+        return OneWireNg::EC_SUCCESS;
+
+    uint8_t buf[ROW_SIZE];
+    return read(row * ROW_SIZE, buf, ROW_SIZE);
+}
+
+OneWireNg::ErrorCode DS2431::write(
+    unsigned addr, const void *data, size_t len)
+{
+    if (addr + len > WRITABLE_ROWS * ROW_SIZE)
+        return OneWireNg::EC_UNSUPPORED;
+    if (!len)
+        return OneWireNg::EC_SUCCESS;
+
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+    const uint8_t *in = (const uint8_t*)data;
+    unsigned end = addr + len;
+
+    unsigned first = addr / ROW_SIZE;
+    unsigned last = (end - 1) / ROW_SIZE;
+
+    /* load partially covered rows with unknown content */
+    if ((addr % ROW_SIZE) || (first == last && (end % ROW_SIZE))) {
+        if ((ec = loadRow(first)) != OneWireNg::EC_SUCCESS)
+            return ec;
+    }
+    if (first != last && (end % ROW_SIZE)) {
+        if ((ec = loadRow(last)) != OneWireNg::EC_SUCCESS)
+            return ec;
+    }
+
+    for (unsigned row = first; row <= last; row++)
+    {
+        unsigned from = (row == first ? addr : row * ROW_SIZE);
+        unsigned to = (row == last ? end : (row + 1) * ROW_SIZE);
+
+        if ((_valid & ~_dirty & rowBit(row)) &&
+            !memcmp(&_mem[from], &in[from - addr], to - from))
+        {
+            /* row content unchanged */
+            continue;
+        }
+        memcpy(&_mem[from], &in[from - addr], to - from);
+        _dirty |= rowBit(row);
+    }
+    return ec;
+}
+
+uint8_t DS2431::rowProtection(unsigned row, const uint8_t *ctrl) const
+{
+    /* control bytes row is protected by the copy protection byte */
+    uint8_t prot = (row < CTRL_ROW ?
+        ctrl[row / (PAGE_SIZE / ROW_SIZE)] :
+        ctrl[ADDR_COPY_PROT - ADDR_PAGE_PROT]);
+
+    if (row == CTRL_ROW && prot == PROT_EPROM)
+        prot = PROT_WRITE;
+
+    return (prot == PROT_WRITE || prot == PROT_EPROM ? prot : PROT_NONE);
+}
+
+OneWireNg::ErrorCode DS2431::readScratchpad(bool resume, uint8_t *scrpd)
+{
+    OneWireNg::ErrorCode ec = (resume ? _ow.resume() : address());
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        /* TA1, TA2, E/S, data, inverted CRC-16 */
+        scrpd[0] = CMD_READ_SCRATCHPAD;
+        memset(&scrpd[1], 0xff, 3 + ROW_SIZE + 2);
+
+        _ow.touchBytes(scrpd, 4 + ROW_SIZE + 2);
+        ec = OneWireNg::checkInvCrc16(scrpd, 4 + ROW_SIZE,
+            OneWireNg::getLSB_u16(&scrpd[4 + ROW_SIZE]));
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::loadScratchpad(bool resume, unsigned row)
+{
+    OneWireNg::ErrorCode ec = (resume ? _ow.resume() : address());
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    const uint8_t *data = &_mem[row * ROW_SIZE];
+    uint8_t ta1 = (uint8_t)(row * ROW_SIZE);
+    uint8_t ta2 = 0;
+
+    /* write scratchpad; the device returns inverted CRC-16 */
+    uint8_t cmd[4 + ROW_SIZE + 2];
+
+    cmd[0] = CMD_WRITE_SCRATCHPAD;
+    cmd[1] = ta1;
+    cmd[2] = ta2;
+    memcpy(&cmd[3], data, ROW_SIZE);
+    cmd[3 + ROW_SIZE] = cmd[4 + ROW_SIZE] = 0xff;
+
+    _ow.touchBytes(cmd, 3 + ROW_SIZE + 2);
+    if ((ec = OneWireNg::checkInvCrc16(cmd, 3 + ROW_SIZE,
+        OneWireNg::getLSB_u16(&cmd[3 + ROW_SIZE]))) != OneWireNg::EC_SUCCESS)
+    {
+        return ec;
+    }
+
+    /* read back and verify */
+    if ((ec = readScratchpad(true, cmd)) != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    uint8_t es = cmd[3];
+    if (cmd[1] != ta1 || cmd[2] != ta2 ||
+        (es & (ES_AA | ES_PF)) || (es & ES_E_MASK) != ROW_SIZE - 1)
+    {
+        return OneWireNg::EC_BUS_ERROR;
+    }
+
+    /* protected row data is substituted by the device */
+    if (!(_eprom & rowBit(row)) && memcmp(&cmd[4], data, ROW_SIZE))
+        return OneWireNg::EC_UNSUPPORED;
+
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::copyScratchpad(
+    OneWireNg& ow, unsigned row, bool power)
+{
+    /* authorization: TA1, TA2, E/S of a fully loaded scratchpad */
+    uint8_t cmd[4] = {
+        CMD_COPY_SCRATCHPAD, (uint8_t)(row * ROW_SIZE), 0, ROW_SIZE - 1
+    };
+
+    ow.writeBytes(cmd, sizeof(cmd), power);
+    delayMs(PROG_TIME);
+    if (power)
+        ow.powerBus(false);
+
+    return (ow.readByte() == COPY_DONE ?
+        OneWireNg::EC_SUCCESS : OneWireNg::EC_BUS_ERROR);
+}
+
+void DS2431::rowStored(unsigned row)
+{
+    _dirty &= ~rowBit(row);
+
+    /* EPROM row content is AND-ed with the written data */
+    if (_eprom & rowBit(row))
+        _valid &= ~rowBit(row);
+    else
+        _valid |= rowBit(row);
+}
+
+OneWireNg::ErrorCode DS2431::prepare(bool *addressed)
+{
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+
+    if (addressed) *addressed = false;
+
+    /* device control bytes */
+    uint8_t ctrl[ROW_SIZE];
+
+    /*
+     * Dirty rows with unknown device content and the control bytes (if not
+     * cached) are read by a single read up to the control bytes row.
+     */
+    RowsMask rd = _dirty & ~_valid;
+    if (!(_valid & ~_dirty & rowBit(CTRL_ROW)))
+        rd |= rowBit(CTRL_ROW);
+
+    if (rd) {
+        uint8_t buf[WRITABLE_ROWS * ROW_SIZE];
+
+        unsigned first = 0;
+        while (!(rd & rowBit(first))) first++;
+
+        if ((ec = readMem(false, first * ROW_SIZE, buf,
+            (CTRL_ROW + 1 - first) * ROW_SIZE)) != OneWireNg::EC_SUCCESS)
+        {
+            return ec;
+        }
+        if (addressed) *addressed = true;
+
+        for (unsigned row = first; row <= CTRL_ROW; row++)
+        {
+            const uint8_t *dev = &buf[(row - first) * ROW_SIZE];
+            uint8_t *mem = &_mem[row * ROW_SIZE];
+
+            if (!(_dirty & rowBit(row))) {
+                memcpy(mem, dev, ROW_SIZE);
+                _valid |= rowBit(row);
+            } else if (!(_valid & rowBit(row)) &&
+                !memcmp(mem, dev, ROW_SIZE))
+            {
+                /* row content unchanged */
+                _dirty &= ~rowBit(row);
+                _valid |= rowBit(row);
+            }
+        }
+        memcpy(ctrl, &buf[(CTRL_ROW - first) * ROW_SIZE], ROW_SIZE);
+    } else {
+        memcpy(ctrl, &_mem[CTRL_ROW * ROW_SIZE], ROW_SIZE);
+    }
+
+    _eprom = 0;
+    for (unsigned row = 0; row < WRITABLE_ROWS; row++)
+    {
+        if (!(_dirty & rowBit(row)))
+            continue;
+
+        uint8_t prot = rowProtection(row, ctrl);
+        if (prot == PROT_WRITE)
+            return OneWireNg::EC_UNSUPPORED;
+        if (prot == PROT_EPROM)
+            _eprom |= rowBit(row);
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::flush()
+{
+    if (!_dirty)
+        return OneWireNg::EC_SUCCESS;
+
+    /*
+     * The device is addressed once, then resumed. If all needed rows are
+     * cached, the device is addressed by the first scratchpad load, since
+     * other device may have been accessed last.
+     */
+    bool resume;
+    OneWireNg::ErrorCode ec = prepare(&resume);
+
+    for (unsigned row = 0;
+        ec == OneWireNg::EC_SUCCESS && row < WRITABLE_ROWS; row++)
+    {
+        if (!(_dirty & rowBit(row)))
+            continue;
+
+        if ((ec = loadScratchpad(resume, row)) == OneWireNg::EC_SUCCESS &&
+            (ec = _ow.resume()) == OneWireNg::EC_SUCCESS &&
+            (ec = copyScratchpad(_ow, row, false)) == OneWireNg::EC_SUCCESS)
+        {
+            rowStored(row);
+        }
+        resume = true;
+    }
+
+    done();
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::flushAll(
+    DS2431 *const devs[], size_t n, bool power)
+{
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+
+    if (!n)
+        return ec;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if (devs[i]->_dirty) {
+            ec = devs[i]->prepare();
+            devs[i]->done();
+            if (ec != OneWireNg::EC_SUCCESS)
+                return ec;
+        }
+    }
+
+    OneWireNg& ow = devs[0]->_ow;
+
+    for (unsigned row = 0; row < WRITABLE_ROWS; row++)
+    {
+        bool copy = false;
+
+        /* load scratchpads of all devices with the row dirty */
+        for (size_t i = 0; i < n; i++)
+        {
+            if (devs[i]->_dirty & rowBit(row)) {
+                ec = devs[i]->loadScratchpad(false, row);
+                devs[i]->done();
+                if (ec != OneWireNg::EC_SUCCESS)
+                    return ec;
+                copy = true;
+            }
+        }
+        if (!copy)
+            continue;
+
+        /*
+         * Copy scratchpads of all devices at once. Devices with not
+         * matching authorization pattern (TA1, TA2, E/S) ignore the command.
+         */
+        if ((ec = ow.addressAll()) != OneWireNg::EC_SUCCESS ||
+            (ec = copyScratchpad(ow, row, power)) != OneWireNg::EC_SUCCESS)
+        {
+            return ec;
+        }
+
+        /* the copy status of each device is checked by its AA flag */
+        for (size_t i = 0; i < n; i++)
+        {
+            if (devs[i]->_dirty & rowBit(row)) {
+                uint8_t scrpd[4 + ROW_SIZE + 2];
+
+                ec = devs[i]->readScratchpad(false, scrpd);
+                devs[i]->done();
+                if (ec != OneWireNg::EC_SUCCESS)
+                    return ec;
+                if (scrpd[1] != (uint8_t)(row * ROW_SIZE) ||
+                    !(scrpd[3] & ES_AA))
+                {
+                    return OneWireNg::EC_BUS_ERROR;
+                }
+                devs[i]->rowStored(row);
+            }
+        }
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::getProtection(unsigned page, Protection& prot)
+{
+    if (page >= DATA_SIZE / PAGE_SIZE)
+        return OneWireNg::EC_UNSUPPORED;
+
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+    uint8_t val;
+
+    if (_valid & ~_dirty & rowBit(CTRL_ROW)) {
+        val = _mem[ADDR_PAGE_PROT + page];
+    } else {
+        ec = read(ADDR_PAGE_PROT + page, &val, 1);
+    }
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        prot = (val == PROT_WRITE || val == PROT_EPROM ?
+            (Protection)val : PROT_NONE);
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2431::setProtection(unsigned page, Protection prot)
+{
+    if (page >= DATA_SIZE / PAGE_SIZE)
+        return OneWireNg::EC_UNSUPPORED;
+
+    uint8_t val = (uint8_t)prot;
+    OneWireNg::ErrorCode ec = write(ADDR_PAGE_PROT + page, &val, 1);
+
+    if (ec == OneWireNg::EC_SUCCESS)
+        ec = flush();
+    return ec;
+}
+
+#endif /* CONFIG_CRC16_ENABLED */
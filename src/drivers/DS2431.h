@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS2431__
+#define __OWNG_DS2431__
+
+#include <string.h>  /* memcpy */
+#include "OneWireNg.h"
+
+#if CONFIG_CRC16_ENABLED
+
+/**
+ * DS2431 1024-bit EEPROM driver.
+ *
+ * The driver keeps a cache of the device memory (data pages and control
+ * bytes). Writes are performed on the cache only and are stored into the
+ * device by @ref flush(). The flush writes dirty rows only (rows with
+ * content not changed comparing to the device are skipped), each of them
+ * verified by the CRC-16 and scratchpad read-back before copying to the
+ * EEPROM. Communication with the device for contiguous rows is continued
+ * via "Resume" command. Reads are performed via single, streamed "Read
+ * Memory" command of arbitrary length.
+ *
+ * @note Requires @c CONFIG_CRC16_ENABLED.
+ */
+class DS2431
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x2d;
+
+    /** Memory function commands */
+    const static uint8_t CMD_WRITE_SCRATCHPAD = 0x0f;
+    const static uint8_t CMD_READ_SCRATCHPAD  = 0xaa;
+    const static uint8_t CMD_COPY_SCRATCHPAD  = 0x55;
+    const static uint8_t CMD_READ_MEMORY      = 0xf0;
+
+    /** EEPROM row size (scratchpad size) */
+    const static size_t ROW_SIZE = 8;
+    /** EEPROM page size */
+    const static size_t PAGE_SIZE = 4 * ROW_SIZE;
+    /** Data memory size (4 pages) */
+    const static size_t DATA_SIZE = 4 * PAGE_SIZE;
+    /** Memory size (data pages, control bytes and reserved row) */
+    const static size_t MEM_SIZE = DATA_SIZE + 2 * ROW_SIZE;
+
+    /** Control bytes addresses */
+    const static uint8_t ADDR_PAGE_PROT = 0x80;  /** pages 0-3 protection */
+    const static uint8_t ADDR_COPY_PROT = 0x84;  /** copy protection */
+    const static uint8_t ADDR_FACTORY   = 0x85;  /** factory byte */
+    const static uint8_t ADDR_USER_ID   = 0x86;  /** user bytes (2) */
+
+    /** Programming time (ms) */
+    const static unsigned PROG_TIME = 10;
+
+    /**
+     * Page protection mode.
+     */
+    typedef enum
+    {
+        PROT_NONE = 0x00,       /** no protection (any other value) */
+        PROT_WRITE = 0x55,      /** write protected */
+        PROT_EPROM = 0xaa       /** EPROM mode (bits may be cleared only) */
+    } Protection;
+
+    /**
+     * Create driver for a DS2431 device.
+     *
+     * @param ow 1-wire service.
+     * @param id Device id.
+     * @param overdrive If @c true the device is communicated in the overdrive
+     *     mode (if @c CONFIG_OVERDRIVE_ENABLED is configured, ignored
+     *     otherwise). The bus is switched back to the standard mode at the
+     *     end of each driver's routine.
+     */
+    DS2431(OneWireNg& ow, const OneWireNg::Id& id, bool overdrive = false):
+        _ow(ow), _od(overdrive)
+    {
+        memcpy(&_id, &id, sizeof(OneWireNg::Id));
+        invalidate();
+    }
+
+    const OneWireNg::Id& getId() const {
+        return _id;
+    }
+
+    /**
+     * Read device memory.
+     *
+     * Data is read directly from the device by a single "Read Memory"
+     * command streaming @c len bytes. The cache is updated for all rows
+     * covered by the read, with exception of the dirty ones.
+     *
+     * @param addr Memory address to start reading from.
+     * @param buf Output buffer.
+     * @param len Number of bytes to read (@c addr + @c len may not exceed
+     *     @ref MEM_SIZE).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_UNSUPPORED: Read exceeding the memory size.
+     *
+     * @note "Read Memory" command is not CRC protected.
+     */
+    OneWireNg::ErrorCode read(unsigned addr, void *buf, size_t len);
+
+    /**
+     * Write data into the memory cache. Use @ref flush() to store the cache
+     * into the device.
+     *
+     * Rows partially covered by the write, with content not yet known, are
+     * read from the device first.
+     *
+     * @param addr Memory address to start writing at.
+     * @param data Data to write.
+     * @param len Number of bytes to write (writable area is the data memory
+     *     and control bytes, that is @c addr + @c len may not exceed
+     *     @ref MEM_SIZE - @ref ROW_SIZE).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_UNSUPPORED: Write outside of the writable area.
+     */
+    OneWireNg::ErrorCode write(unsigned addr, const void *data, size_t len);
+
+    /**
+     * Store dirty rows of the cache into the device.
+     *
+     * Dirty rows with content not known (wholly overwritten by @ref write())
+     * are read from the device (together with the control bytes) by a single
+     * read. Rows with content unchanged are skipped. Each of the remaining
+     * rows is written into the scratchpad, verified and copied into the
+     * EEPROM.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error.
+     *     - @c EC_BUS_ERROR: Scratchpad verification or copy error.
+     *     - @c EC_UNSUPPORED: Row write protected.
+     *
+     * @note On error, not yet stored rows are left dirty and the flush may
+     *     be repeated.
+     */
+    OneWireNg::ErrorCode flush();
+
+    /**
+     * Store dirty rows of multiple devices connected to the same bus.
+     *
+     * Contrary to @ref flush() called for each device separately, each row
+     * is copied into the EEPROM of all the devices at once: scratchpads of
+     * the devices with the row dirty are loaded (and verified) one by one,
+     * then all of them are copied by a single "Copy Scratchpad" command
+     * addressed to all devices on the bus ("Skip ROM"), therefore the
+     * programming time is spent once per row regardless of the number of
+     * the devices. Copy status is verified for each device afterwards.
+     *
+     * @param devs Drivers of the devices to flush.
+     * @param n Number of devices.
+     * @param power If @c true the bus is powered during programming (strong
+     *     pull-up), required if the pull-up resistor is not able to provide
+     *     programming current for all the devices at once.
+     *
+     * @return Same as for @ref flush().
+     *
+     * @note The routine is intended for programming jigs. Other DS2431
+     *     devices connected to the bus, with scratchpad loaded for the same
+     *     row, would be programmed as well.
+     */
+    static OneWireNg::ErrorCode flushAll(
+        DS2431 *const devs[], size_t n, bool power = false);
+
+    /**
+     * Invalidate the cache. Cached, dirty rows are discarded.
+     */
+    void invalidate()
+    {
+        _valid = 0;
+        _dirty = 0;
+        _eprom = 0;
+    }
+
+    /**
+     * Check if there are dirty rows in the cache.
+     */
+    bool isDirty() const {
+        return (_dirty != 0);
+    }
+
+    /**
+     * Get page protection mode.
+     *
+     * @param page Page number (0-3).
+     * @param prot Page protection mode.
+     *
+     * @return Same as for @ref read().
+     */
+    OneWireNg::ErrorCode getProtection(unsigned page, Protection& prot);
+
+    /**
+     * Set page protection mode and flush the cache.
+     *
+     * @param page Page number (0-3).
+     * @param prot Page protection mode.
+     *
+     * @return Same as for @ref flush().
+     *
+     * @note Protection set to @c PROT_WRITE or @c PROT_EPROM is irreversible.
+     */
+    OneWireNg::ErrorCode setProtection(unsigned page, Protection prot);
+
+protected:
+    const static unsigned ROWS_NUM = MEM_SIZE / ROW_SIZE;
+
+    /* rows mask */
+    typedef uint32_t RowsMask;
+
+    static RowsMask rowBit(unsigned row) {
+        return (RowsMask)1 << row;
+    }
+
+    /** Address the device (first command of a transaction) */
+    OneWireNg::ErrorCode address();
+
+    /** Read memory range with no cache update */
+    OneWireNg::ErrorCode readMem(bool resume, unsigned addr,
+        uint8_t *buf, size_t len);
+
+    /** Load row into the cache (if its content is not known) */
+    OneWireNg::ErrorCode loadRow(unsigned row);
+
+    /**
+     * Read dirty rows with unknown content and the control bytes from the
+     * device (if needed) and check dirty rows protection. If @c addressed
+     * is not @c NULL it's set to @c true if the device has been addressed
+     * (the read issued), so it may be resumed afterwards.
+     */
+    OneWireNg::ErrorCode prepare(bool *addressed = NULL);
+
+    /** Read scratchpad (TA1, TA2, E/S, data) with CRC-16 check */
+    OneWireNg::ErrorCode readScratchpad(bool resume, uint8_t *scrpd);
+
+    /** Load scratchpad with a row (as cached) and verify it */
+    OneWireNg::ErrorCode loadScratchpad(bool resume, unsigned row);
+
+    /** Copy scratchpad of already addressed device(s) into the EEPROM */
+    static OneWireNg::ErrorCode copyScratchpad(
+        OneWireNg& ow, unsigned row, bool power);
+
+    /** Update cache state for a row stored into the device */
+    void rowStored(unsigned row);
+
+    /** Get protection of a row as set by the control bytes */
+    uint8_t rowProtection(unsigned row, const uint8_t *ctrl) const;
+
+    /** Switch back to standard mode (if overdrive is used) */
+    void done();
+
+    OneWireNg& _ow;
+    OneWireNg::Id _id;
+    bool _od;
+
+    uint8_t _mem[MEM_SIZE];     /** memory cache */
+    RowsMask _valid;            /** rows with cached content known */
+    RowsMask _dirty;            /** rows to store into the device */
+    RowsMask _eprom;            /** dirty rows in EPROM mode pages */
+
+#ifdef OWNG_TEST
+friend class DS2431_Test;
+#endif
+};
+
+#endif /* CONFIG_CRC16_ENABLED */
+#endif /* __OWNG_DS2431__ */
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/DS2438.h"
+#include "platform/Platform_Delay.h"
+
+OneWireNg::ErrorCode DS2438::convertAll(int convTime)
+{
+    OneWireNg::ErrorCode ec = _convert(NULL, CMD_CONVERT_T, convTime);
+    if (ec == OneWireNg::EC_SUCCESS)
+        ec = _convert(NULL, CMD_CONVERT_V, convTime);
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2438::readPage(
+    const OneWireNg::Id& id, uint8_t page, uint8_t *data)
+{
+    OneWireNg::ErrorCode ec = _recallMemory(&id, page);
+    if (ec == OneWireNg::EC_SUCCESS)
+        ec = _readScratchpad(id, page, data);
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2438::readStatus(
+    const OneWireNg::Id& id, Status& status)
+{
+    memcpy(status._id, id, sizeof(OneWireNg::Id));
+    return readPage(id, 0, status._page);
+}
+
+OneWireNg::ErrorCode DS2438::readStatusAll(const OneWireNg::Id *ids,
+    size_t n, Status *status, OneWireNg::ErrorCode *ecs)
+{
+    /* recall page 0 on all monitors at once */
+    OneWireNg::ErrorCode ec = _recallMemory(NULL, 0);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        memcpy(status[i]._id, ids[i], sizeof(OneWireNg::Id));
+
+        OneWireNg::ErrorCode dec = _readScratchpad(ids[i], 0, status[i]._page);
+        if (ecs)
+            ecs[i] = dec;
+        if (dec != OneWireNg::EC_SUCCESS)
+            ec = dec;
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2438::setConfig(const OneWireNg::Id& id, uint8_t config)
+{
+    uint8_t page[PAGE_SIZE];
+
+    /* the scratchpad is filled with page 0 to preserve the threshold */
+    OneWireNg::ErrorCode ec = readPage(id, 0, page);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    ec = _ow.addressSingle(id);
+    if (ec == OneWireNg::EC_SUCCESS)
+    {
+        uint8_t cmd[3] = {
+            CMD_WRITE_SCRATCHPAD, 0,
+            (uint8_t)(config & (CFG_IAD | CFG_CA | CFG_EE | CFG_AD))
+        };
+        _ow.writeBytes(cmd, sizeof(cmd));
+
+        ec = _ow.addressSingle(id);
+        if (ec == OneWireNg::EC_SUCCESS) {
+            uint8_t copy[2] = { CMD_COPY_SCRATCHPAD, 0 };
+            _ow.writeBytes(copy, sizeof(copy));
+            delayMs(COPY_TIME);
+        }
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2438::_convert(
+    const OneWireNg::Id *id, uint8_t cmd, int convTime)
+{
+    OneWireNg::ErrorCode ec =
+        (id ? _ow.addressSingle(*id) : _ow.addressAll());
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        _ow.writeByte(cmd);
+        waitForCompletion(convTime);
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2438::_recallMemory(
+    const OneWireNg::Id *id, uint8_t page)
+{
+    OneWireNg::ErrorCode ec =
+        (id ? _ow.addressSingle(*id) : _ow.addressAll());
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        uint8_t cmd[2] = { CMD_RECALL_MEMORY, page };
+        _ow.writeBytes(cmd, sizeof(cmd));
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2438::_readScratchpad(
+    const OneWireNg::Id& id, uint8_t page, uint8_t *data)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(id);
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        uint8_t cmd[2 + PAGE_SIZE + 1] = {
+            CMD_READ_SCRATCHPAD, page,
+            /* the read page and its CRC will be placed here (9 bytes) */
+            0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+        };
+
+        _ow.touchBytes(cmd, sizeof(cmd));
+
+        if (OneWireNg::crc8(&cmd[2], PAGE_SIZE) == cmd[2 + PAGE_SIZE])
+            memcpy(data, &cmd[2], PAGE_SIZE);
+        else
+            ec = OneWireNg::EC_CRC_ERROR;
+    }
+    return ec;
+}
+
+void DS2438::waitForCompletion(int ms)
+{
+    if (ms > 0) {
+        delayMs(ms < MAX_CONV_TIME ? ms : MAX_CONV_TIME);
+    } else if (ms < 0) {
+        /* the monitor(s) hold the bus low while converting */
+        for (int i = 0; i < MAX_CONV_TIME; i++) {
+            if (_ow.readBit())
+                break;
+            else
+                delayMs(1);
+        }
+    }
+}
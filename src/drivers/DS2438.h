@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS2438__
+#define __OWNG_DS2438__
+
+#include <string.h>  /* memcpy */
+#include "OneWireNg.h"
+
+/**
+ * DS2438 smart battery monitor driver.
+ *
+ * Temperature and voltage (VAD or VDD input) conversions are started by
+ * dedicated commands, current is measured continuously by the monitor if
+ * enabled in its configuration. All the results are placed in the memory
+ * page 0 (see @ref Status).
+ *
+ * For a larger number of monitors @ref convertAll() and @ref readStatusAll()
+ * allow to start the conversions on all monitors at once and read their
+ * results in a single sweep over the bus.
+ */
+class DS2438
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x26;
+
+    /** Function commands */
+    const static uint8_t CMD_CONVERT_T        = 0x44;
+    const static uint8_t CMD_COPY_SCRATCHPAD  = 0x48;
+    const static uint8_t CMD_WRITE_SCRATCHPAD = 0x4e;
+    const static uint8_t CMD_CONVERT_V        = 0xb4;
+    const static uint8_t CMD_RECALL_MEMORY    = 0xb8;
+    const static uint8_t CMD_READ_SCRATCHPAD  = 0xbe;
+
+    /** Configuration bits (page 0, byte 0) */
+    const static uint8_t CFG_IAD = 0x01;  /**< current A/D enabled */
+    const static uint8_t CFG_CA  = 0x02;  /**< current accumulator enabled */
+    const static uint8_t CFG_EE  = 0x04;  /**< shadow accumulator to EEPROM */
+    const static uint8_t CFG_AD  = 0x08;  /**< voltage A/D input: VDD (set),
+                                               VAD (cleared) */
+    /** Status bits (page 0, byte 0; read only) */
+    const static uint8_t STAT_TB  = 0x10;  /**< temperature conversion busy */
+    const static uint8_t STAT_NVB = 0x20;  /**< EEPROM busy */
+    const static uint8_t STAT_ADB = 0x40;  /**< voltage conversion busy */
+
+    /** Memory page size and number of pages */
+    const static size_t PAGE_SIZE = 8;
+    const static uint8_t PAGES_NUM = 8;
+
+    /** Max conversion time (ms) of either temperature or voltage */
+    const static int MAX_CONV_TIME = 10;
+
+    /** Copy scratchpad (EEPROM programming) time (ms) */
+    const static int COPY_TIME = 10;
+
+    /** Scan the bus for conversion completion (see @ref convertTemp()) */
+    const static int SCAN_BUS = -1;
+
+    /**
+     * Monitor status (memory page 0).
+     *
+     * Object of this class is a placeholder for the raw page 0 bytes read
+     * from a monitor, associated with the monitor id.
+     */
+    class Status
+    {
+    public:
+        /**
+         * Get configuration and status bits (@c CFG_XXX, @c STAT_XXX).
+         */
+        uint8_t getConfig() const {
+            return _page[0];
+        }
+
+        /**
+         * Get temperature (1000 scaled).
+         *
+         * @return Temperature in Celsius degrees returned as fixed-point
+         *     integer with multiplier 1000 (0.03125 C resolution).
+         */
+        long getTemp() const
+        {
+            /* 13-bit value, left justified (1/256 C units) */
+            long temp = ((long)(int8_t)_page[2] << 8) | _page[1];
+            return temp * 125 / 32;
+        }
+
+        /**
+         * Get voltage of the input selected by @ref CFG_AD at the time
+         * of conversion.
+         *
+         * @return Voltage in millivolts (10 mV resolution).
+         */
+        unsigned getVoltage() const {
+            return ((((unsigned)_page[4] & 3) << 8) | _page[3]) * 10;
+        }
+
+        /**
+         * Get raw current A/D value.
+         *
+         * @return Signed A/D value. Current flowing through the sense
+         *     resistor Rsens is equal to: value / (4096 * Rsens).
+         */
+        int getCurrent() const {
+            return (int16_t)(((unsigned)_page[6] << 8) | _page[5]);
+        }
+
+        /**
+         * Get current A/D threshold.
+         */
+        uint8_t getThreshold() const {
+            return _page[7];
+        }
+
+        /**
+         * Get monitor id the status belongs to.
+         */
+        const OneWireNg::Id& getId() const {
+            return _id;
+        }
+
+        /**
+         * Get page 0 in a raw format (@ref PAGE_SIZE bytes long).
+         */
+        const uint8_t *getRaw() const {
+            return _page;
+        }
+
+    private:
+        OneWireNg::Id _id;
+        uint8_t _page[PAGE_SIZE];
+
+        friend class DS2438;
+    };
+
+    /**
+     * DS2438 driver constructor.
+     *
+     * @param ow 1-wire service.
+     */
+    DS2438(OneWireNg& ow): _ow(ow) {}
+
+    /**
+     * Start temperature conversion for an addressed monitor.
+     *
+     * @param id Monitor id.
+     * @param convTime Conversion time. The parameter has 3 variants:
+     * - @c convTime > 0: Time (in milliseconds) to wait for the conversion
+     *   completion (@ref MAX_CONV_TIME max).
+     * - @c convTime == 0: Don't wait for the conversion.
+     * - @c convTime < 0 (@ref SCAN_BUS): Scan the bus for the conversion
+     *   completion (@ref MAX_CONV_TIME max).
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     */
+    OneWireNg::ErrorCode convertTemp(
+        const OneWireNg::Id& id, int convTime = SCAN_BUS)
+    {
+        return _convert(&id, CMD_CONVERT_T, convTime);
+    }
+
+    /**
+     * Start voltage conversion for an addressed monitor. The converted
+     * input (VAD or VDD) depends on @ref CFG_AD configuration bit.
+     *
+     * @see convertTemp()
+     */
+    OneWireNg::ErrorCode convertVoltage(
+        const OneWireNg::Id& id, int convTime = SCAN_BUS)
+    {
+        return _convert(&id, CMD_CONVERT_V, convTime);
+    }
+
+    /**
+     * Perform temperature and voltage conversions for all monitors on the
+     * bus. The conversions are performed one after another (Convert T
+     * followed by Convert V), each started by a command addressing all
+     * monitors (SKIP ROM) and followed by its own wait, therefore two
+     * conversion waits are taken regardless of number of the monitors.
+     *
+     * @param convTime Conversion time of each conversion (see
+     *     @ref convertTemp()).
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *
+     * @note There shall be no other devices than DS2438 on the bus,
+     *     since the commands are sent to all of them.
+     */
+    OneWireNg::ErrorCode convertAll(int convTime = SCAN_BUS);
+
+    /**
+     * Read memory page with CRC check.
+     *
+     * The page is recalled from the monitor's memory into its scratchpad
+     * and then read from there.
+     *
+     * @param id Monitor id.
+     * @param page Page number (0 - @ref PAGES_NUM - 1).
+     * @param data Output buffer (@ref PAGE_SIZE bytes).
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error.
+     */
+    OneWireNg::ErrorCode readPage(
+        const OneWireNg::Id& id, uint8_t page, uint8_t *data);
+
+    /**
+     * Read monitor status (memory page 0).
+     *
+     * @param id Monitor id.
+     * @param status Read status.
+     *
+     * @return Same as for @ref readPage().
+     */
+    OneWireNg::ErrorCode readStatus(const OneWireNg::Id& id, Status& status);
+
+    /**
+     * Read status (memory page 0) of a number of monitors. Page 0 is
+     * recalled by a single command addressing all monitors (SKIP ROM)
+     * and then scratchpads of the monitors are read one by one.
+     *
+     * Typical usage:
+     *
+     * @code
+     * ds2438.convertAll();
+     * ds2438.readStatusAll(ids, n, statuses);
+     * @endcode
+     *
+     * @param ids Ids of monitors to read.
+     * @param n Number of monitors.
+     * @param status Output table of statuses (@c n elements).
+     * @param ecs If not @c NULL, read status of each monitor is written
+     *     there (table of @c n elements).
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Statuses of all monitors read with success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - Otherwise error of the last monitor failed to read (statuses
+     *       of remaining monitors are read anyway).
+     *
+     * @note There shall be no other devices than DS2438 on the bus.
+     */
+    OneWireNg::ErrorCode readStatusAll(const OneWireNg::Id *ids, size_t n,
+        Status *status, OneWireNg::ErrorCode *ecs = NULL);
+
+    /**
+     * Write configuration bits (@c CFG_XXX) of an addressed monitor.
+     *
+     * @param id Monitor id.
+     * @param config Configuration to write.
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error while reading page 0.
+     *
+     * @note Page 0 threshold byte is preserved.
+     */
+    OneWireNg::ErrorCode setConfig(const OneWireNg::Id& id, uint8_t config);
+
+protected:
+    OneWireNg::ErrorCode _convert(
+        const OneWireNg::Id *id, uint8_t cmd, int convTime);
+
+    OneWireNg::ErrorCode _recallMemory(const OneWireNg::Id *id, uint8_t page);
+
+    OneWireNg::ErrorCode _readScratchpad(
+        const OneWireNg::Id& id, uint8_t page, uint8_t *data);
+
+    void waitForCompletion(int ms);
+
+    OneWireNg& _ow;
+
+#ifdef OWNG_TEST
+    friend class DS2438_Test;
+#endif
+};
+
+#endif /* __OWNG_DS2438__ */
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/DS2450.h"
+#include "platform/Platform_Delay.h"
+
+#if CONFIG_CRC16_ENABLED
+
+OneWireNg::ErrorCode DS2450::setChannel(
+    const OneWireNg::Id& id, int ch, int bits, Range range)
+{
+    if (ch < 0 || ch >= CHANNELS_NUM || bits < 1 || bits > 16)
+        return OneWireNg::EC_UNSUPPORED;
+
+    unsigned addr = ADDR_CONTROL + 2 * ch;
+    uint8_t ctrl[2];
+
+    OneWireNg::ErrorCode ec = readMemory(id, addr, ctrl, sizeof(ctrl));
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    /* resolution (16 bits coded as 0) and input range */
+    ctrl[0] = (uint8_t)((ctrl[0] & 0xf0) | (bits & 0x0f));
+    ctrl[1] = (uint8_t)((ctrl[1] & 0xfe) | (range == RANGE_5_12V ? 1 : 0));
+
+    return writeMemory(id, addr, ctrl, sizeof(ctrl));
+}
+
+OneWireNg::ErrorCode DS2450::readResults(
+    const OneWireNg::Id& id, uint8_t mask, uint16_t *results)
+{
+    int ch = 0;
+    while (ch < CHANNELS_NUM - 1 && !(mask & (1 << ch)))
+        ch++;
+
+    uint8_t buf[2 * CHANNELS_NUM];
+    size_t len = 2 * (CHANNELS_NUM - ch);
+
+    OneWireNg::ErrorCode ec =
+        readMemory(id, ADDR_RESULTS + 2 * ch, buf, len);
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        for (size_t i = 0; i < len; i += 2, ch++)
+            results[ch] = OneWireNg::getLSB_u16(&buf[i]);
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2450::sampleStream(const OneWireNg::Id *ids,
+    size_t n, uint8_t mask, unsigned long samples, Sink sink, void *arg,
+    int convTime)
+{
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+    uint16_t results[CHANNELS_NUM];
+
+    memset(results, 0, sizeof(results));
+
+    for (unsigned long s = 0; s < samples; s++)
+    {
+        ec = convertAll(mask, convTime);
+        if (ec != OneWireNg::EC_SUCCESS)
+            break;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            ec = readResults(ids[i], mask, results);
+            if (ec != OneWireNg::EC_SUCCESS)
+                return ec;
+
+            if (!sink(i, results, arg))
+                return ec;
+        }
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2450::readMemory(
+    const OneWireNg::Id& id, unsigned addr, uint8_t *buf, size_t len)
+{
+    if (addr + len > MEM_SIZE)
+        return OneWireNg::EC_UNSUPPORED;
+
+    OneWireNg::ErrorCode ec = _ow.addressSingle(id);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    uint8_t cmd[3] = { CMD_READ_MEMORY, (uint8_t)addr, 0 };
+
+    /* CRC of the 1st page covers the command and address */
+    uint16_t crc16 = OneWireNg::crc16(cmd, sizeof(cmd));
+    _ow.writeBytes(cmd, sizeof(cmd));
+
+    /* page data followed by inverted CRC-16 */
+    uint8_t page[PAGE_SIZE + 2];
+
+    while (len > 0)
+    {
+        /* the whole page needs to be read to get its CRC */
+        size_t rem = PAGE_SIZE - (addr % PAGE_SIZE);
+        size_t n = (rem < len ? rem : len);
+
+        _ow.readBytes(page, rem + 2);
+
+        crc16 = OneWireNg::crc16(page, rem, crc16);
+        if ((uint16_t)(crc16 ^ ~OneWireNg::getLSB_u16(&page[rem])))
+            return OneWireNg::EC_CRC_ERROR;
+        crc16 = 0;
+
+        memcpy(buf, page, n);
+        buf += n;
+        addr += n;
+        len -= n;
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS2450::writeMemory(const OneWireNg::Id& id,
+    unsigned addr, const uint8_t *data, size_t len)
+{
+    if (addr + len > MEM_SIZE)
+        return OneWireNg::EC_UNSUPPORED;
+
+    OneWireNg::ErrorCode ec = _ow.addressSingle(id);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    uint8_t cmd[3] = { CMD_WRITE_MEMORY, (uint8_t)addr, 0 };
+    uint16_t crc16 = OneWireNg::crc16(cmd, sizeof(cmd));
+    _ow.writeBytes(cmd, sizeof(cmd));
+
+    for (size_t i = 0; i < len; i++)
+    {
+        /* data byte followed by inverted CRC-16 and the byte read back */
+        uint8_t buf[4] = { data[i], 0xff, 0xff, 0xff };
+
+        if (i > 0) {
+            /* CRC of subsequent bytes covers their address */
+            uint8_t ta[2] = { (uint8_t)(addr + i), 0 };
+            crc16 = OneWireNg::crc16(ta, sizeof(ta));
+        }
+
+        _ow.touchBytes(buf, sizeof(buf));
+
+        crc16 = OneWireNg::crc16(&buf[0], 1, crc16);
+        if ((uint16_t)(crc16 ^ ~OneWireNg::getLSB_u16(&buf[1])))
+            return OneWireNg::EC_CRC_ERROR;
+        if (buf[3] != data[i])
+            return OneWireNg::EC_BUS_ERROR;
+    }
+    return ec;
+}
+
+int DS2450::getConversionTime(uint8_t mask, int bits)
+{
+    int n = 0;
+    for (; mask; mask >>= 1) {
+        if (mask & 1)
+            n++;
+    }
+
+    /* 80us per bit of each channel plus 160us offset */
+    return (n * bits * 80 + 160 + 999) / 1000;
+}
+
+OneWireNg::ErrorCode DS2450::_convert(const OneWireNg::Id *id,
+    uint8_t mask, int convTime, uint8_t preset)
+{
+    OneWireNg::ErrorCode ec =
+        (id ? _ow.addressSingle(*id) : _ow.addressAll());
+
+    if (ec == OneWireNg::EC_SUCCESS)
+    {
+        uint8_t cmd[5] = {
+            CMD_CONVERT, (uint8_t)(mask & CH_ALL), preset,
+            /* inverted CRC-16 will be placed here */
+            0xff, 0xff
+        };
+
+        /* the conversion starts after the CRC is read */
+        _ow.touchBytes(cmd, sizeof(cmd));
+
+        if (OneWireNg::checkInvCrc16(
+            cmd, 3, OneWireNg::getLSB_u16(&cmd[3])) != OneWireNg::EC_SUCCESS)
+        {
+            return OneWireNg::EC_CRC_ERROR;
+        }
+
+        if (convTime > 0) {
+            delayMs(convTime);
+        } else if (convTime < 0) {
+            /* the device(s) hold the bus low while converting */
+            for (int i = 0; i < MAX_CONV_TIME; i++) {
+                if (_ow.readBit())
+                    break;
+                else
+                    delayMs(1);
+            }
+        }
+    }
+    return ec;
+}
+
+#endif /* CONFIG_CRC16_ENABLED */
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS2450__
+#define __OWNG_DS2450__
+
+#include <string.h>  /* memcpy, memset */
+#include "OneWireNg.h"
+
+#if CONFIG_CRC16_ENABLED
+
+/**
+ * DS2450 quad A/D converter driver.
+ *
+ * Conversion of any set of channels may be started for a single device or
+ * for all devices on the bus at once (SKIP ROM), in which case the
+ * conversion wait is taken once regardless of number of the devices.
+ * Conversion results, as all memory reads and writes, are verified by
+ * CRC-16 sent by the device.
+ *
+ * @note Requires @c CONFIG_CRC16_ENABLED.
+ */
+class DS2450
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x20;
+
+    /** Function commands */
+    const static uint8_t CMD_CONVERT      = 0x3c;
+    const static uint8_t CMD_WRITE_MEMORY = 0x55;
+    const static uint8_t CMD_READ_MEMORY  = 0xaa;
+
+    /** Memory map */
+    const static uint8_t ADDR_RESULTS  = 0x00;
+    const static uint8_t ADDR_CONTROL  = 0x08;
+    const static uint8_t ADDR_ALARMS   = 0x10;
+    const static uint8_t ADDR_VCC_CTRL = 0x1c;
+
+    /** Write to @ref ADDR_VCC_CTRL for VCC powered devices */
+    const static uint8_t VCC_POWERED = 0x40;
+
+    /** Memory page size and memory size */
+    const static size_t PAGE_SIZE = 8;
+    const static size_t MEM_SIZE = 32;
+
+    /** Channels masks */
+    const static int CHANNELS_NUM = 4;
+    const static uint8_t CH_A = 0x01;
+    const static uint8_t CH_B = 0x02;
+    const static uint8_t CH_C = 0x04;
+    const static uint8_t CH_D = 0x08;
+    const static uint8_t CH_ALL = 0x0f;
+
+    /** Max conversion time (ms) of all channels with 16-bit resolution */
+    const static int MAX_CONV_TIME = 6;
+
+    /** Scan the bus for conversion completion (see @ref convert()) */
+    const static int SCAN_BUS = -1;
+
+    /** Channel input range */
+    enum Range {
+        RANGE_2_56V = 0,
+        RANGE_5_12V
+    };
+
+    /**
+     * Conversion results sink for @ref sampleStream().
+     *
+     * @param dev Index of the device the results belong to.
+     * @param results Conversion results (raw) of all channels.
+     * @param arg User argument.
+     *
+     * @return @c false to stop the sampling.
+     */
+    typedef bool (*Sink)(size_t dev, const uint16_t *results, void *arg);
+
+    DS2450(OneWireNg& ow): _ow(ow) {}
+
+    /**
+     * Configure channel resolution and input range.
+     *
+     * @param id Device id.
+     * @param ch Channel number (0 - @ref CHANNELS_NUM - 1).
+     * @param bits Resolution (1-16 bits).
+     * @param range Input range.
+     *
+     * @return Same as for @ref writeMemory(); @c EC_UNSUPPORED is returned
+     *     for invalid channel or resolution.
+     */
+    OneWireNg::ErrorCode setChannel(
+        const OneWireNg::Id& id, int ch, int bits, Range range);
+
+    /**
+     * Start conversion for an addressed device.
+     *
+     * @param id Device id.
+     * @param mask Channels to convert (@c CH_XXX bits).
+     * @param convTime Conversion time. The parameter has 3 variants:
+     * - @c convTime > 0: Time (in milliseconds) to wait for the conversion
+     *   completion (see @ref getConversionTime()).
+     * - @c convTime == 0: Don't wait for the conversion.
+     * - @c convTime < 0 (@ref SCAN_BUS): Scan the bus for the conversion
+     *   completion (@ref MAX_CONV_TIME max).
+     * @param preset Read-out control byte: results of not converted
+     *     channels may be preset to zeros (01b) or ones (10b); 2 bits per
+     *     channel, channel A at the LSB.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: Command CRC error (conversion not started).
+     */
+    OneWireNg::ErrorCode convert(const OneWireNg::Id& id,
+        uint8_t mask = CH_ALL, int convTime = SCAN_BUS, uint8_t preset = 0)
+    {
+        return _convert(&id, mask, convTime, preset);
+    }
+
+    /**
+     * Start conversion for all devices on the bus.
+     *
+     * @see convert()
+     *
+     * @note There shall be no other devices than DS2450 on the bus,
+     *     since the command is sent to all of them.
+     */
+    OneWireNg::ErrorCode convertAll(
+        uint8_t mask = CH_ALL, int convTime = SCAN_BUS, uint8_t preset = 0)
+    {
+        return _convert(NULL, mask, convTime, preset);
+    }
+
+    /**
+     * Read conversion results.
+     *
+     * Only part of the results page starting from the 1st channel in
+     * @c mask is read.
+     *
+     * @param id Device id.
+     * @param mask Channels to read (@c CH_XXX bits).
+     * @param results Output table of raw results (@ref CHANNELS_NUM
+     *     elements, left justified 16-bit values). Results of channels
+     *     preceding the 1st one in @c mask are not updated.
+     *
+     * @return Same as for @ref readMemory().
+     */
+    OneWireNg::ErrorCode readResults(
+        const OneWireNg::Id& id, uint8_t mask, uint16_t *results);
+
+    /**
+     * Convert and read channels of a number of devices repeatedly.
+     *
+     * Each sample is taken by a single conversion of all devices on the
+     * bus (see @ref convertAll()) followed by reading results of devices
+     * one by one.
+     *
+     * @param ids Devices ids.
+     * @param n Number of devices.
+     * @param mask Channels to sample.
+     * @param samples Number of samples to take.
+     * @param sink Conversion results sink.
+     * @param arg User argument passed to the sink.
+     * @param convTime Conversion time (see @ref convert()).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success (also if sampling stopped by the sink).
+     *     - Otherwise error which stopped the sampling.
+     */
+    OneWireNg::ErrorCode sampleStream(const OneWireNg::Id *ids, size_t n,
+        uint8_t mask, unsigned long samples, Sink sink, void *arg = NULL,
+        int convTime = SCAN_BUS);
+
+    /**
+     * Read memory.
+     *
+     * @param id Device id.
+     * @param addr Memory address.
+     * @param buf Output buffer.
+     * @param len Number of bytes to read.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error.
+     *     - @c EC_UNSUPPORED: Read exceeding the memory size.
+     */
+    OneWireNg::ErrorCode readMemory(
+        const OneWireNg::Id& id, unsigned addr, uint8_t *buf, size_t len);
+
+    /**
+     * Write memory.
+     *
+     * @param id Device id.
+     * @param addr Memory address.
+     * @param data Data to write.
+     * @param len Number of bytes to write.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error (the write is stopped).
+     *     - @c EC_BUS_ERROR: Written byte read back by the device differs
+     *         (the write is stopped).
+     *     - @c EC_UNSUPPORED: Write exceeding the memory size.
+     */
+    OneWireNg::ErrorCode writeMemory(const OneWireNg::Id& id,
+        unsigned addr, const uint8_t *data, size_t len);
+
+    /**
+     * Get conversion time (in milliseconds) of channels given by @c mask
+     * with @c bits resolution.
+     */
+    static int getConversionTime(uint8_t mask, int bits);
+
+    /**
+     * Get voltage of a raw conversion result.
+     *
+     * @return Voltage in millivolts.
+     */
+    static unsigned getVoltage(uint16_t raw, Range range) {
+        return (unsigned)(((uint32_t)raw * (range == RANGE_5_12V ?
+            5120 : 2560)) >> 16);
+    }
+
+protected:
+    OneWireNg::ErrorCode _convert(const OneWireNg::Id *id,
+        uint8_t mask, int convTime, uint8_t preset);
+
+    OneWireNg& _ow;
+
+#ifdef OWNG_TEST
+    friend class DS2450_Test;
+#endif
+};
+
+#endif /* CONFIG_CRC16_ENABLED */
+#endif /* __OWNG_DS2450__ */
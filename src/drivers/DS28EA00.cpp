@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include <string.h>  /* memcpy */
+#include "drivers/DS28EA00.h"
+
+/* command confirmation */
+#define CONFIRM 0xaa
+
+OneWireNg::ErrorCode DS28EA00::chain(uint8_t ctrl)
+{
+    uint8_t cmd[4] = { CMD_CHAIN, ctrl, (uint8_t)~ctrl, 0xff };
+
+    _ow.touchBytes(cmd, sizeof(cmd));
+    return (cmd[3] == CONFIRM ?
+        OneWireNg::EC_SUCCESS : OneWireNg::EC_BUS_ERROR);
+}
+
+OneWireNg::ErrorCode DS28EA00::chainAll(uint8_t ctrl)
+{
+    OneWireNg::ErrorCode ec = _ow.addressAll();
+
+    if (ec == OneWireNg::EC_SUCCESS)
+        ec = chain(ctrl);
+    return ec;
+}
+
+OneWireNg::ErrorCode DS28EA00::chainNext(OneWireNg::Id& id)
+{
+    OneWireNg::ErrorCode ec = _ow.reset();
+
+    if (ec == OneWireNg::EC_SUCCESS)
+    {
+        _ow.writeByte(CMD_COND_READ_ROM);
+        _ow.readBytes(&id[0], sizeof(OneWireNg::Id));
+
+        /* no active sensor (id bits not driven) */
+        uint8_t all = 0xff;
+        for (size_t i = 0; i < sizeof(OneWireNg::Id); i++)
+            all &= id[i];
+        if (all == 0xff)
+            return OneWireNg::EC_NO_DEVS;
+
+        if ((ec = OneWireNg::checkCrcId(id)) == OneWireNg::EC_SUCCESS) {
+            /* the sensor is selected by the ROM command */
+            ec = chain(CHAIN_DONE);
+        }
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS28EA00::discoverChain(
+    OneWireNg::Id *ids, size_t max, size_t& n)
+{
+    n = 0;
+
+    OneWireNg::ErrorCode ec = chainOn();
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    OneWireNg::Id id;
+    while ((ec = chainNext(id)) == OneWireNg::EC_SUCCESS)
+    {
+        if (n >= max) {
+            ec = OneWireNg::EC_FULL;
+            break;
+        }
+        memcpy(&ids[n++], &id, sizeof(OneWireNg::Id));
+    }
+    if (ec == OneWireNg::EC_NO_DEVS)
+        ec = OneWireNg::EC_SUCCESS;
+
+    OneWireNg::ErrorCode ecOff = chainOff();
+    return (ec != OneWireNg::EC_SUCCESS ? ec : ecOff);
+}
+
+OneWireNg::ErrorCode DS28EA00::readPio(
+    const OneWireNg::Id& id, uint8_t& state)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(id);
+
+    if (ec == OneWireNg::EC_SUCCESS)
+    {
+        _ow.writeByte(CMD_PIO_READ);
+        uint8_t st = _ow.readByte();
+
+        /* upper nibble is the complement of the lower one */
+        if (((st ^ (st >> 4)) & 0x0f) != 0x0f)
+            return OneWireNg::EC_CRC_ERROR;
+
+        /* pins state: bit 0 (PIOA), bit 2 (PIOB) */
+        state = (uint8_t)((st & 0x01) | ((st >> 1) & 0x02));
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode DS28EA00::writePio(
+    const OneWireNg::Id& id, uint8_t state)
+{
+    OneWireNg::ErrorCode ec = _ow.addressSingle(id);
+
+    if (ec == OneWireNg::EC_SUCCESS) {
+        uint8_t out = (uint8_t)(state | ~(PIOA | PIOB));
+        uint8_t cmd[5] = { CMD_PIO_WRITE, out, (uint8_t)~out, 0xff, 0xff };
+
+        /* confirmation followed by the PIO status */
+        _ow.touchBytes(cmd, sizeof(cmd));
+        if (cmd[3] != CONFIRM)
+            ec = OneWireNg::EC_BUS_ERROR;
+    }
+    return ec;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DS28EA00__
+#define __OWNG_DS28EA00__
+
+#include "OneWireNg.h"
+
+/**
+ * DS28EA00 sequence detect (chain) and PIO driver.
+ *
+ * DS28EA00 sensors daisy chained via their PIOA (output) and PIOB (EN
+ * input) pins may be discovered in their physical order along the chain.
+ * In the chain mode only the sensor with EN input active responds to
+ * "Conditional Read ROM" command. After reading its id the sensor is
+ * transitioned to the DONE state, which activates the next sensor in the
+ * chain. Each sensor is therefore discovered by a single id read, with no
+ * search process involved.
+ *
+ * Temperature measurements are handled by @c DSTherm driver.
+ */
+class DS28EA00
+{
+public:
+    const static uint8_t FAMILY_CODE = 0x42;
+
+    /** Function commands */
+    const static uint8_t CMD_CHAIN     = 0x99;
+    const static uint8_t CMD_PIO_READ  = 0xf5;
+    const static uint8_t CMD_PIO_WRITE = 0xa5;
+
+    /** Conditional Read ROM (ROM command) */
+    const static uint8_t CMD_COND_READ_ROM = 0x0f;
+
+    /** Chain command control bytes */
+    const static uint8_t CHAIN_OFF  = 0x3c;
+    const static uint8_t CHAIN_ON   = 0x5a;
+    const static uint8_t CHAIN_DONE = 0x96;
+
+    /** PIO state bits */
+    const static uint8_t PIOA = 0x01;
+    const static uint8_t PIOB = 0x02;
+
+    DS28EA00(OneWireNg& ow): _ow(ow) {}
+
+    /**
+     * Discover chained sensors in their physical order.
+     *
+     * @param ids Output table of sensors ids (in the chain order).
+     * @param max Size of @c ids table.
+     * @param n Number of discovered sensors.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success, all chained sensors discovered.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: CRC error of read id.
+     *     - @c EC_BUS_ERROR: Chain command not confirmed.
+     *     - @c EC_FULL: More sensors than @c max in the chain (first @c max
+     *         of them are returned).
+     *
+     * @note The chain mode is turned off at the end of the routine.
+     */
+    OneWireNg::ErrorCode discoverChain(
+        OneWireNg::Id *ids, size_t max, size_t& n);
+
+    /**
+     * Turn on the chain mode on all sensors on the bus.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_BUS_ERROR: Chain command not confirmed.
+     */
+    OneWireNg::ErrorCode chainOn() {
+        return chainAll(CHAIN_ON);
+    }
+
+    /**
+     * Turn off the chain mode on all sensors on the bus.
+     *
+     * @return Same as for @ref chainOn().
+     */
+    OneWireNg::ErrorCode chainOff() {
+        return chainAll(CHAIN_OFF);
+    }
+
+    /**
+     * Read id of the next sensor in the chain and transition it to the
+     * DONE state (activating the next sensor). The chain mode needs to be
+     * turned on by @ref chainOn().
+     *
+     * @param id Id of the sensor.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No more sensors in the chain.
+     *     - @c EC_CRC_ERROR: CRC error of read id.
+     *     - @c EC_BUS_ERROR: Chain command not confirmed.
+     */
+    OneWireNg::ErrorCode chainNext(OneWireNg::Id& id);
+
+    /**
+     * Read PIO pins state.
+     *
+     * @param id Sensor id.
+     * @param state Pins state (@ref PIOA, @ref PIOB bits).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: State integrity check failed.
+     */
+    OneWireNg::ErrorCode readPio(const OneWireNg::Id& id, uint8_t& state);
+
+    /**
+     * Write PIO output latches.
+     *
+     * @param id Sensor id.
+     * @param state Output state (@ref PIOA, @ref PIOB bits; bit set turns
+     *     the output transistor off).
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_BUS_ERROR: Write not confirmed.
+     *
+     * @note PIO writes are not possible in the chain mode.
+     */
+    OneWireNg::ErrorCode writePio(const OneWireNg::Id& id, uint8_t state);
+
+protected:
+    /** Send chain command control byte to the addressed device(s) */
+    OneWireNg::ErrorCode chain(uint8_t ctrl);
+
+    OneWireNg::ErrorCode chainAll(uint8_t ctrl);
+
+    OneWireNg& _ow;
+};
+
+#endif /* __OWNG_DS28EA00__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021,2022,2024,2025 Piotr Stolarz
+ * Copyright (c) 2021,2022,2024,2025,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -12,6 +12,7 @@
 
 #include "drivers/DSTherm.h"
 #include "platform/Platform_Delay.h"
+#include "utils/Placeholder.h"
 
 #define STR(m) #m
 
@@ -45,6 +46,13 @@ OneWireNg::ErrorCode DSTherm::_readScratchpad(const OneWireNg::Id& id,
             cmd[Scratchpad::LENGTH])
         {
             new (scratchpad) Scratchpad(_ow, id, &cmd[1]);
+#if CONFIG_DSTHERM_CACHE
+            if (_cache) {
+                scratchpad->_cache = _cache;
+                _cache->update(id, &cmd[1]);
+                _cache->storeScratchpad(id, &cmd[1]);
+            }
+#endif
         } else
             ec = OneWireNg::EC_CRC_ERROR;
     }
@@ -54,6 +62,15 @@ OneWireNg::ErrorCode DSTherm::_readScratchpad(const OneWireNg::Id& id,
 OneWireNg::ErrorCode DSTherm::readScratchpad(
     const OneWireNg::Id& id, Scratchpad *scratchpad)
 {
+#if CONFIG_DSTHERM_CACHE
+    const uint8_t *cached = (_cache ? _cache->getScratchpad(id) : NULL);
+    if (cached) {
+        new (scratchpad) Scratchpad(_ow, id, cached);
+        scratchpad->_cache = _cache;
+        return OneWireNg::EC_SUCCESS;
+    }
+#endif
+
     OneWireNg::ErrorCode ec = _ow.addressSingle(id);
     if (ec == OneWireNg::EC_SUCCESS)
         ec = _readScratchpad(id, scratchpad);
@@ -89,6 +106,226 @@ OneWireNg::ErrorCode DSTherm::readScratchpadSingle(
     return ec;
 }
 
+OneWireNg::ErrorCode DSTherm::setAlarmWindow(Scratchpad& scratchpad, int hyst)
+{
+    /* Th == Tl would signal alarm state for any temperature */
+    if (hyst < 1)
+        return OneWireNg::EC_UNSUPPORED;
+
+    /* integer part of the temperature as compared by the sensor */
+    long temp = rsh(scratchpad.getTemp2(), 4);
+    long th = temp + hyst;
+    long tl = temp - hyst;
+
+    if (th > 127) th = 127;
+    if (tl < -128) tl = -128;
+
+    scratchpad.setThl((int8_t)th, (int8_t)tl);
+    return scratchpad.writeScratchpad();
+}
+
+#if CONFIG_SEARCH_ENABLED
+OneWireNg::ErrorCode DSTherm::readScratchpadAlarm(
+    Scratchpad *scratchpad, int hyst)
+{
+    OneWireNg::ErrorCode ec;
+    OneWireNg::Id id;
+
+    if (hyst < 1)
+        return OneWireNg::EC_UNSUPPORED;
+
+    while ((ec = _ow.search(id, true)) == OneWireNg::EC_MORE)
+    {
+        if (getFamilyName(id) == NULL)
+            continue;
+
+        /*
+         * Sensor's alarm flag is updated on temperature conversion only,
+         * therefore re-arming the window doesn't influence the search
+         * process in progress.
+         */
+        ec = readScratchpad(id, scratchpad);
+        if (ec == OneWireNg::EC_SUCCESS)
+            ec = setAlarmWindow(*scratchpad, hyst);
+        break;
+    }
+    return ec;
+}
+#endif
+
+#if CONFIG_SEARCH_ENABLED
+OneWireNg::ErrorCode DSTherm::_readTempAll(
+    ReadingSink& sink, bool alarm, size_t *n, uint8_t family)
+{
+    OneWireNg::ErrorCode ec;
+    OneWireNg::Id id;
+    Placeholder<Scratchpad> scrpd;
+    Reading rd;
+    bool dropped = false;
+
+    if (n) *n = 0;
+    _ow.searchReset();
+
+    while ((ec = _ow.search(id, alarm)) == OneWireNg::EC_MORE)
+    {
+        if (family ? id[0] != family : getFamilyName(id) == NULL)
+            continue;
+
+        ec = readScratchpad(id, scrpd);
+        if (ec == OneWireNg::EC_NO_DEVS)
+            continue;
+
+        memcpy(rd.id, id, sizeof(OneWireNg::Id));
+        if (ec != OneWireNg::EC_SUCCESS) {
+            rd.temp = 0;
+        } else if (family) {
+            rd.temp = (int16_t)(
+                ((unsigned)scrpd->getRaw()[1] << 8) | scrpd->getRaw()[0]);
+        } else {
+            rd.temp = (int16_t)scrpd->getTemp2();
+        }
+        rd.status = (uint8_t)ec;
+        rd.time = (uint32_t)timeMs();
+
+        if (sink.put(rd)) {
+            if (n) (*n)++;
+        } else {
+            dropped = true;
+        }
+    }
+
+    if (ec == OneWireNg::EC_NO_DEVS)
+        ec = (dropped ? OneWireNg::EC_FULL : OneWireNg::EC_SUCCESS);
+    return ec;
+}
+
+/*
+ * Check if scratchpad configuration differs from the requested one.
+ */
+static bool configDiffers(const DSTherm::Scratchpad& scrpd,
+    int8_t th, int8_t tl, uint8_t res)
+{
+    return (scrpd.getTh() != th || scrpd.getTl() != tl ||
+        (scrpd.getId()[0] != DSTherm::DS18S20 &&
+            scrpd.getResolution() != (DSTherm::Resolution)(res & 3)));
+}
+
+OneWireNg::ErrorCode DSTherm::syncConfig(int8_t th, int8_t tl,
+    uint8_t res, bool parasitic, size_t *updated)
+{
+    OneWireNg::ErrorCode ec;
+    OneWireNg::Id id;
+    Placeholder<Scratchpad> scrpd;
+    size_t n = 0, nDiff = 0;
+    bool allowAll = true;
+
+    if (updated) *updated = 0;
+
+    /* 1st pass: detect sensors needing update */
+    _ow.searchReset();
+    while ((ec = _ow.search(id)) == OneWireNg::EC_MORE)
+    {
+        /*
+         * Configuration for all sensors is not sent if other devices are
+         * present on the bus or DS1825 address would be overwritten.
+         */
+        if (getFamilyName(id) == NULL) {
+            allowAll = false;
+            continue;
+        } else
+        if (id[0] == DS1825)
+            allowAll = false;
+
+        /* scratchpad may not reflect EEPROM content if written before */
+        if ((ec = recallEeprom(id)) != OneWireNg::EC_SUCCESS ||
+            (ec = readScratchpad(id, scrpd)) != OneWireNg::EC_SUCCESS)
+        {
+            return ec;
+        }
+
+        n++;
+        if (configDiffers(*scrpd, th, tl, res))
+            nDiff++;
+    }
+
+    if (ec != OneWireNg::EC_NO_DEVS)
+        return ec;
+    ec = OneWireNg::EC_SUCCESS;
+
+    if (!nDiff)
+        return ec;
+
+    if (allowAll && n > 1 && nDiff == n) {
+        if ((ec = writeScratchpadAll(th, tl, res)) == OneWireNg::EC_SUCCESS &&
+            (ec = copyScratchpadAll(parasitic)) == OneWireNg::EC_SUCCESS)
+        {
+            if (updated) *updated = n;
+        }
+        return ec;
+    }
+
+    /* 2nd pass: update sensors with differing configuration */
+    _ow.searchReset();
+    while ((ec = _ow.search(id)) == OneWireNg::EC_MORE)
+    {
+        if (getFamilyName(id) == NULL)
+            continue;
+
+        ec = readScratchpad(id, scrpd);
+        if (ec != OneWireNg::EC_SUCCESS)
+            return ec;
+
+        if (!configDiffers(*scrpd, th, tl, res))
+            continue;
+
+        scrpd->setThl(th, tl);
+        scrpd->setResolution((Resolution)(res & 3));
+
+        if ((ec = scrpd->writeScratchpad()) != OneWireNg::EC_SUCCESS ||
+            (ec = copyScratchpad(id, parasitic)) != OneWireNg::EC_SUCCESS)
+        {
+            return ec;
+        }
+        if (updated) (*updated)++;
+    }
+
+    return (ec == OneWireNg::EC_NO_DEVS ? OneWireNg::EC_SUCCESS : ec);
+}
+#endif
+
+#if CONFIG_DSTHERM_CACHE && CONFIG_SEARCH_ENABLED
+OneWireNg::ErrorCode DSTherm::fillCache()
+{
+    if (!_cache)
+        return OneWireNg::EC_UNSUPPORED;
+
+    OneWireNg::ErrorCode ec;
+    OneWireNg::Id id;
+    Placeholder<Scratchpad> scrpd;
+    size_t n = 0;
+
+    _cache->clear();
+    _ow.searchReset();
+
+    while ((ec = _ow.search(id)) == OneWireNg::EC_MORE)
+    {
+        if (getFamilyName(id) == NULL)
+            continue;
+
+        ec = readScratchpad(id, scrpd);
+        if (ec != OneWireNg::EC_SUCCESS)
+            break;
+        n++;
+    }
+
+    if (ec == OneWireNg::EC_NO_DEVS) {
+        _cache->_complete = (n <= _cache->_size);
+        ec = OneWireNg::EC_SUCCESS;
+    }
+    return ec;
+}
+#endif
+
 #if (CONFIG_MAX_SEARCH_FILTERS > 0)
 OneWireNg::ErrorCode DSTherm::filterSupportedSlaves()
 {
@@ -129,7 +366,8 @@ const char *DSTherm::getFamilyName(const OneWireNg::Id& id)
     return NULL;
 }
 
-void DSTherm::waitForCompletion(int ms, bool parasitic, int scanTimeoutMs)
+int DSTherm::waitForCompletion(
+    int ms, bool parasitic, int scanTimeoutMs, int scanSleepMs)
 {
     if (ms > 0) {
         /* wait specified amount of time */
@@ -139,14 +377,24 @@ void DSTherm::waitForCompletion(int ms, bool parasitic, int scanTimeoutMs)
         } else
             delayMs(ms);
     } else if (ms < 0) {
+        int i = 0;
+
+        /* sleep before scanning (no bus activity) */
+        if (scanSleepMs > 0 && scanSleepMs < scanTimeoutMs) {
+            delayMs(scanSleepMs);
+            i = scanSleepMs;
+        }
+
         /* scan the bus for completion */
-        for (int i = 0; i < scanTimeoutMs; i++) {
+        for (; i < scanTimeoutMs; i++) {
             if (_ow.readBit())
                 break;
             else
                 delayMs(1);
         }
+        return i;
     }
+    return ms;
 }
 
 OneWireNg::ErrorCode DSTherm::_writeScratchpad(
@@ -173,6 +421,12 @@ OneWireNg::ErrorCode DSTherm::_writeScratchpad(
             (id && (*id)[0] == DS18S20 ? sizeof(cmd) - 1 : sizeof(cmd));
 
         _ow.writeBytes(cmd, cmd_len);
+#if CONFIG_DSTHERM_CACHE
+        if (_cache) {
+            _cache->updateRes(id, (uint8_t)((res - RES_9_BIT) & 3));
+            _cache->invalidate(id);
+        }
+#endif
     }
     return ec;
 }
@@ -196,8 +450,13 @@ OneWireNg::ErrorCode DSTherm::_recallEeprom(const OneWireNg::Id *id)
     OneWireNg::ErrorCode ec =
         (id ? _ow.addressSingle(*id) : _ow.addressAll());
 
-    if (ec == OneWireNg::EC_SUCCESS)
+    if (ec == OneWireNg::EC_SUCCESS) {
         _ow.writeByte(CMD_RECALL_E2);
+#if CONFIG_DSTHERM_CACHE
+        if (_cache)
+            _cache->invalidate(id);
+#endif
+    }
 
     return ec;
 }
@@ -226,6 +485,12 @@ OneWireNg::ErrorCode DSTherm::Scratchpad::writeScratchpad() const
         size_t len = (_id[0] == DS18S20 ? sizeof(cmd) - 1 : sizeof(cmd));
 
         _ow.writeBytes(cmd, len);
+#if CONFIG_DSTHERM_CACHE
+        if (_cache) {
+            _cache->update(_id, _scrpd);
+            _cache->invalidate(&_id);
+        }
+#endif
     }
     return ec;
 }
@@ -276,3 +541,166 @@ long DSTherm::Scratchpad::getTemp2() const
     }
     return temp;
 }
+
+#if CONFIG_DSTHERM_CACHE
+size_t DSTherm::Cache::size() const
+{
+    size_t n = 0;
+    for (size_t i = 0; i < _size; i++) {
+        if (_entries[i].id[0])
+            n++;
+    }
+    return n;
+}
+
+DSTherm::Cache::Entry *DSTherm::Cache::find(const OneWireNg::Id& id) const
+{
+    for (size_t i = 0; i < _size; i++) {
+        if (!memcmp(_entries[i].id, id, sizeof(OneWireNg::Id)))
+            return &_entries[i];
+    }
+    return NULL;
+}
+
+DSTherm::Cache::Entry *DSTherm::Cache::add(const OneWireNg::Id& id)
+{
+    Entry *entry = find(id);
+
+    if (!entry && _size > 0) {
+        entry = &_entries[_next];
+        _next = (_next + 1) % _size;
+
+        memset(entry, 0, sizeof(*entry));
+        memcpy(entry->id, id, sizeof(OneWireNg::Id));
+
+        /* new sensor appeared - the cache may not be complete anymore */
+        _complete = false;
+    }
+    return entry;
+}
+
+void DSTherm::Cache::setRes(Entry *entry, uint8_t res)
+{
+    if (entry->res != res) {
+        /* learned conversion times are no longer valid */
+        entry->convTime = 0;
+        _convTimeAll = 0;
+    }
+    entry->res = res;
+}
+
+void DSTherm::Cache::update(const OneWireNg::Id& id, const uint8_t *scratchpad)
+{
+    Entry *entry = add(id);
+    if (entry) {
+        setRes(entry, (id[0] != DS18S20 ?
+            (uint8_t)((scratchpad[4] >> 5) & 3) : (uint8_t)RES_12_BIT));
+    }
+}
+
+void DSTherm::Cache::updateRes(const OneWireNg::Id *id, uint8_t res)
+{
+    if (id) {
+        Entry *entry = add(*id);
+        if (entry && (*id)[0] != DS18S20)
+            setRes(entry, res);
+    } else {
+        /* all sensors on the bus addressed */
+        for (size_t i = 0; i < _size; i++) {
+            if (_entries[i].id[0] && _entries[i].id[0] != DS18S20)
+                setRes(&_entries[i], res);
+        }
+        _convTimeAll = 0;
+    }
+}
+
+int DSTherm::Cache::getConvTime(const OneWireNg::Id *id, int maxTime) const
+{
+    int res = -1;
+
+    if (id) {
+        const Entry *entry = find(*id);
+        if (entry)
+            res = entry->res;
+    } else if (_complete) {
+        /* max resolution of all sensors on the bus */
+        for (size_t i = 0; i < _size; i++) {
+            if (_entries[i].id[0] && _entries[i].res > res)
+                res = _entries[i].res;
+        }
+    }
+
+    if (res >= 0) {
+        int convTime = getConversionTime((Resolution)res);
+        if (convTime < maxTime)
+            return convTime;
+    }
+    return maxTime;
+}
+
+void DSTherm::Cache::invalidate(const OneWireNg::Id *id)
+{
+    if (id) {
+        Entry *entry = find(*id);
+        if (entry)
+            entry->scrpdValid = false;
+    } else {
+        for (size_t i = 0; i < _size; i++)
+            _entries[i].scrpdValid = false;
+    }
+}
+
+const uint8_t *DSTherm::Cache::getScratchpad(const OneWireNg::Id& id) const
+{
+    const Entry *entry = (_ttl ? find(id) : NULL);
+
+    if (entry && entry->scrpdValid &&
+        (unsigned long)(timeMs() - entry->scrpdTime) < _ttl)
+    {
+        return entry->scrpd;
+    }
+    return NULL;
+}
+
+void DSTherm::Cache::storeScratchpad(
+    const OneWireNg::Id& id, const uint8_t *scratchpad)
+{
+    Entry *entry = (_ttl ? find(id) : NULL);
+
+    if (entry) {
+        memcpy(entry->scrpd, scratchpad, Scratchpad::LENGTH);
+        entry->scrpdTime = timeMs();
+        entry->scrpdValid = true;
+    }
+}
+
+int DSTherm::Cache::getPredConvTime(const OneWireNg::Id *id) const
+{
+    uint16_t convTime = _convTimeAll;
+
+    if (id) {
+        const Entry *entry = find(*id);
+        convTime = (entry ? entry->convTime : 0);
+    }
+    return (convTime >> 4);
+}
+
+void DSTherm::Cache::learnConvTime(const OneWireNg::Id *id, int convTime)
+{
+    uint16_t *ema = &_convTimeAll;
+
+    if (id) {
+        Entry *entry = find(*id);
+        if (!entry)
+            return;
+        ema = &entry->convTime;
+    }
+
+    long obs = (long)convTime << 4;
+    if (*ema) {
+        /* exponential moving average */
+        *ema = (uint16_t)(*ema + rsh(obs - *ema, EMA_WEIGHT_SH));
+    } else
+        *ema = (uint16_t)obs;
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021,2022,2024,2025 Piotr Stolarz
+ * Copyright (c) 2021,2022,2024,2025,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -32,6 +32,10 @@ public:
         RES_12_BIT
     };
 
+#if CONFIG_DSTHERM_CACHE
+    class Cache;
+#endif
+
     /**
      * Sensor scratchpad.
      *
@@ -216,6 +220,9 @@ public:
         Scratchpad(OneWireNg& ow, const OneWireNg::Id& id,
             const uint8_t scratchpad[LENGTH]):
             _ow(ow)
+#if CONFIG_DSTHERM_CACHE
+            , _cache(NULL)
+#endif
         {
             memcpy(_id, id, sizeof(id));
             memcpy(_scrpd, scratchpad, LENGTH);
@@ -224,12 +231,199 @@ public:
         OneWireNg& _ow;
         OneWireNg::Id _id;
         uint8_t _scrpd[LENGTH];
+#if CONFIG_DSTHERM_CACHE
+        /* cache of the driver the scratchpad has been read by */
+        Cache *_cache;
+#endif
+
+    friend class DSTherm;
+#ifdef OWNG_TEST
+    friend class DSTherm_Test;
+    friend class DSThermBatch_Test;
+#endif
+    };
+
+#if CONFIG_DSTHERM_CACHE
+    /**
+     * Sensors parameters cache.
+     *
+     * The cache stores parameters of sensors learned from scratchpads read
+     * or written by the driver. The parameters are next used by the driver
+     * to shorten temperature conversion waits (see @ref convertTemp()).
+     *
+     * If configured with non-zero time-to-live (TTL), the cache additionally
+     * keeps the last read scratchpads. A scratchpad read within the TTL is
+     * served from the cache without the bus activity. Cached scratchpads are
+     * invalidated by temperature conversion, scratchpad write or EEPROM recall
+     * performed by the driver for a given sensor (or all sensors).
+     *
+     * Since @c DSTherm driver is a lightweight object, the cache is a separate
+     * object provided by a user and passed to the driver(s) handling the same
+     * 1-wire bus. Memory for the cache entries is also provided by a user:
+     *
+     * @code
+     * DSTherm::Cache::Entry entries[10];
+     * // scratchpads cached for 1 sec.
+     * DSTherm::Cache cache(entries, 10, 1000);
+     *
+     * // ow: 1-wire service
+     * DSTherm dsth(ow, &cache);
+     * @endcode
+     *
+     * If the cache is full, its entries are replaced in the round-robin manner.
+     */
+    class Cache
+    {
+    public:
+        /** Cache entry */
+        typedef struct {
+            /** Sensor id; zeroed family code for unused entry */
+            OneWireNg::Id id;
+            /**
+             * Resolution determining conversion time of the sensor
+             * (DS18S20 is always considered as 12-bits).
+             */
+            uint8_t res;
+            /**
+             * Exponential moving average of observed conversion time
+             * (16 scaled, in milliseconds); 0 if not learned yet.
+             */
+            uint16_t convTime;
+            /** Cached scratchpad is valid */
+            bool scrpdValid;
+            /** Cached scratchpad read time (milliseconds) */
+            unsigned long scrpdTime;
+            /** Cached scratchpad */
+            uint8_t scrpd[Scratchpad::LENGTH];
+        } Entry;
+
+        /**
+         * Cache constructor.
+         *
+         * @param entries Table of cache entries.
+         * @param size Size of the table.
+         * @param ttl Cached scratchpads time-to-live (milliseconds). If 0,
+         *     scratchpads are not cached.
+         */
+        Cache(Entry *entries, size_t size, unsigned long ttl = 0):
+            _entries(entries), _size(size), _ttl(ttl)
+        {
+            clear();
+        }
+
+        /**
+         * Set cached scratchpads time-to-live (milliseconds). If 0,
+         * scratchpads are not cached.
+         */
+        void setTtl(unsigned long ttl) {
+            _ttl = ttl;
+        }
+
+        /**
+         * Invalidate cached scratchpad of a given sensor or all sensors
+         * (if @c id is @c NULL).
+         */
+        void invalidate(const OneWireNg::Id *id = NULL);
+
+        /**
+         * Clear the cache.
+         */
+        void clear()
+        {
+            memset(_entries, 0, _size * sizeof(Entry));
+            _next = 0;
+            _complete = false;
+            _convTimeAll = 0;
+        }
+
+        /**
+         * Get number of sensors stored in the cache.
+         */
+        size_t size() const;
+
+        /**
+         * Check if the cache contains all sensors connected to the bus.
+         * The cache is complete after filled by @ref DSTherm::fillCache().
+         * The completeness is lost if a new sensor is learned by the cache
+         * afterwards.
+         */
+        bool isComplete() const {
+            return _complete;
+        }
+
+    protected:
+        Entry *find(const OneWireNg::Id& id) const;
+        Entry *add(const OneWireNg::Id& id);
+
+        void update(const OneWireNg::Id& id, const uint8_t *scratchpad);
+        void updateRes(const OneWireNg::Id *id, uint8_t res);
+
+        int getConvTime(const OneWireNg::Id *id, int maxTime) const;
+
+        int getPredConvTime(const OneWireNg::Id *id) const;
+        void learnConvTime(const OneWireNg::Id *id, int convTime);
+
+        void setRes(Entry *entry, uint8_t res);
+
+        const uint8_t *getScratchpad(const OneWireNg::Id& id) const;
+        void storeScratchpad(const OneWireNg::Id& id, const uint8_t *scratchpad);
+
+        /* EMA weight of a new observation, as power of 2 */
+        const static int EMA_WEIGHT_SH = 2;
+
+        Entry *_entries;
+        size_t _size;
+        size_t _next;       /* next entry to replace */
+        unsigned long _ttl;
+        bool _complete;
+        uint16_t _convTimeAll;  /* learned conversion time of all sensors */
 
     friend class DSTherm;
 #ifdef OWNG_TEST
     friend class DSTherm_Test;
 #endif
     };
+#endif
+
+    /**
+     * Compact temperature reading record (see @ref readTempAll()).
+     */
+    typedef struct {
+        /** Sensor id */
+        OneWireNg::Id id;
+        /**
+         * Temperature in Celsius degrees (16 scaled, as returned by
+         * @ref Scratchpad::getTemp2(), so DS18S20 extended resolution is
+         * taken into account if configured). Zero if the scratchpad has
+         * not been read with success.
+         *
+         * For MAX31850 thermocouples (see @c MAX31850::readTempAll()) it's
+         * the thermocouple temperature register: 16 scaled temperature in
+         * bits 2-15, fault status in bit 0.
+         */
+        int16_t temp;
+        /** Scratchpad read status (@c OneWireNg::ErrorCode) */
+        uint8_t status;
+        /** Scratchpad read time (milliseconds) */
+        uint32_t time;
+    } Reading;
+
+    /**
+     * Readings sink interface, @see ReadingsQueue.
+     */
+    class ReadingSink
+    {
+    public:
+        virtual ~ReadingSink() {}
+
+        /**
+         * Put a reading into the sink.
+         *
+         * @return @c true on success, @c false if the reading has been
+         *     dropped (no space in the sink).
+         */
+        virtual bool put(const Reading& rd) = 0;
+    };
 
     /**
      * DSTherm driver constructor.
@@ -242,7 +436,22 @@ public:
      *     used as automatic variables created and destroyed on the running
      *     stack without additional overhead.
      */
-    DSTherm(OneWireNg& ow): _ow(ow) {}
+    DSTherm(OneWireNg& ow): _ow(ow)
+#if CONFIG_DSTHERM_CACHE
+        , _cache(NULL)
+#endif
+    {}
+
+#if CONFIG_DSTHERM_CACHE
+    /**
+     * DSTherm driver constructor with sensors parameters cache.
+     *
+     * @param ow 1-wire service.
+     * @param cache Sensors parameters cache (may be @c NULL). The cache should
+     *     be shared by all drivers handling the same 1-wire bus.
+     */
+    DSTherm(OneWireNg& ow, Cache *cache): _ow(ow), _cache(cache) {}
+#endif
 
     /**
      * Start temperature conversion for an addressed sensor.
@@ -274,6 +483,12 @@ public:
      *   If @c parasitic is @c false (sensor is not parasitically powered)
      *   the routine scans 1-wire bus for conversion completion and returns if
      *   completed, otherwise waits @c MAX_CONV_TIME and returns.
+     *   If the driver is provided with @ref Cache, the conversion time is
+     *   taken from resolution cached for the sensor (or max conversion time
+     *   of all sensors for @ref convertTempAll() if the cache is complete),
+     *   instead of @c MAX_CONV_TIME. Moreover, while scanning the bus, the
+     *   cache learns actual conversion times. The routine sleeps until
+     *   shortly before the learned time and scans the bus from that point.
      * @param parasitic If @c true 1-wire bus is powered during the conversion
      *     time.
      *
@@ -349,6 +564,9 @@ public:
      *         @c scratchpad address.
      *     - @c EC_NO_DEVS: No devices on the bus.
      *     - @c EC_CRC_ERROR: Scratchpad read with CRC error.
+     *
+     * @note If the driver is provided with @ref Cache configured with
+     *     scratchpads TTL, the scratchpad may be served from the cache.
      */
     OneWireNg::ErrorCode readScratchpad(
         const OneWireNg::Id& id, Scratchpad *scratchpad);
@@ -515,6 +733,176 @@ public:
         return _readPowerSupply(NULL);
     }
 
+    /**
+     * Program Th and Tl alarm triggers of a sensor as a window around its
+     * last temperature reading contained in the passed scratchpad.
+     *
+     * Th is set to the reading's integer part increased by @c hyst, Tl -
+     * decreased by @c hyst (both clamped to the signed 1-byte range). Since
+     * a sensor signals alarm state if measured temperature integer part is
+     * greater or equal to Th or less or equal to Tl, the sensor will be in
+     * the alarm state after a conversion only if its temperature left the
+     * window. The alarm state may be detected by the conditional search (see
+     * @ref readScratchpadAlarm()).
+     *
+     * @param scratchpad Sensor scratchpad with the last temperature reading.
+     *     The scratchpad is updated with the set triggers.
+     * @param hyst Window half-width in Celsius degrees (must be >= 1).
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_UNSUPPORED: @c hyst less than 1 (the sensor would be in
+     *         the alarm state regardless of its temperature).
+     *
+     * @note Th and Tl are written into the sensor's scratchpad only, they are
+     *     not copied into EEPROM to avoid wearing it out.
+     */
+    OneWireNg::ErrorCode setAlarmWindow(Scratchpad& scratchpad, int hyst = 1);
+
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Read scratchpad of a next sensor with alarm state set and re-arm its
+     * alarm window around the read temperature.
+     *
+     * The routine supports "report on change" polling scheme. Initially the
+     * alarm windows are set for all sensors by @ref setAlarmWindow(). Next,
+     * for every polling cycle:
+     * - Temperature conversion is started for all sensors on the bus by
+     *   @ref convertTempAll().
+     * - The routine is called in a loop (preceded by
+     *   @ref OneWireNg::searchReset()) until @c EC_NO_DEVS is returned. Only
+     *   sensors which temperature left their alarm window respond to the
+     *   conditional search, therefore only scratchpads of these sensors are
+     *   read.
+     *
+     * @code
+     * ow.searchReset();
+     * while (dsth.readScratchpadAlarm(scrpd) == OneWireNg::EC_MORE) {
+     *     // temperature of the sensor changed
+     *     long temp = scrpd->getTemp();
+     *     // ...
+     * }
+     * @endcode
+     *
+     * @param scratchpad Points to memory region where the scratchpad object
+     *     of the read sensor will be created in-place (@see readScratchpad()).
+     * @param hyst Window half-width in Celsius degrees (@see setAlarmWindow()).
+     *
+     * @return Error codes:
+     *     - @c EC_MORE (aka @c EC_SUCCESS): Scratchpad of a sensor with alarm
+     *         state set successfully read and the sensor re-armed.
+     *     - @c EC_NO_DEVS: No more sensors with alarm state set.
+     *     - @c EC_BUS_ERROR: Bus error.
+     *     - @c EC_CRC_ERROR: CRC error (search or scratchpad read).
+     *     - @c EC_UNSUPPORED: @c hyst less than 1.
+     *
+     * @note Devices not supported by the driver responding to the conditional
+     *     search are skipped.
+     */
+    OneWireNg::ErrorCode readScratchpadAlarm(
+        Scratchpad *scratchpad, int hyst = 1);
+#endif
+
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Read temperatures of all supported sensors on the bus into a readings
+     * sink.
+     *
+     * The routine search-scans the bus and reads scratchpad of each detected
+     * sensor. A compact reading record (@ref Reading) is put into the sink
+     * for each of the sensors, including sensors which scratchpads have been
+     * read with CRC error (@c status of the reading is set appropriately).
+     * No scratchpad objects are passed to the caller, therefore a sink backed
+     * by a lock-free queue (@ref ReadingsQueue) allows to pass the readings
+     * from a task owning the bus to a consumer task with no locking.
+     *
+     * @code
+     * // bus task
+     * dsth.convertTempAll();
+     * dsth.readTempAll(queue);
+     *
+     * // consumer task
+     * DSTherm::Reading rd;
+     * while (queue.pop(rd)) {
+     *     // ...
+     * }
+     * @endcode
+     *
+     * @param sink Readings sink.
+     * @param alarm If @c true only sensors with alarm state set are read
+     *     (conditional search).
+     * @param n If not @c NULL, number of readings put into the sink is
+     *     written under the address.
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_FULL: Some readings have been dropped by the sink.
+     *     - @c EC_BUS_ERROR: Bus error.
+     *     - @c EC_CRC_ERROR: CRC error (search).
+     */
+    OneWireNg::ErrorCode readTempAll(
+        ReadingSink& sink, bool alarm = false, size_t *n = NULL)
+    {
+        return _readTempAll(sink, alarm, n, 0);
+    }
+#endif
+
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Synchronize thermometer configuration of all supported sensors on
+     * the bus with a requested one.
+     *
+     * The routine search-scans the bus, recalls EEPROM of each detected
+     * sensor and reads its scratchpad. Only sensors which configuration (Th, Tl and resolution)
+     * differs from the requested one are written and their scratchpads copied
+     * into EEPROM. If all detected sensors need to be updated and the bus
+     * contains no other devices than supported sensors, the configuration
+     * is written and copied for all sensors at once (see
+     * @ref writeScratchpadAll(), @ref copyScratchpadAll()).
+     *
+     * @param th High alarm trigger.
+     * @param tl Low alarm trigger.
+     * @param res Temperature measurement resolution (ignored for DS18S20).
+     * @param parasitic If @c true 1-wire bus is powered during the copy time.
+     * @param updated If not @c NULL, number of updated sensors is written
+     *     under the address.
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_BUS_ERROR: Bus error.
+     *     - @c EC_CRC_ERROR: CRC error (search or scratchpad read).
+     *
+     * @note Configuration written into sensors scratchpads (and not copied
+     *     into EEPROM) is overwritten by the EEPROM recall. DS1825 address
+     *     is retained.
+     */
+    OneWireNg::ErrorCode syncConfig(int8_t th, int8_t tl,
+        uint8_t res = RES_12_BIT, bool parasitic = false,
+        size_t *updated = NULL);
+#endif
+
+#if CONFIG_DSTHERM_CACHE && CONFIG_SEARCH_ENABLED
+    /**
+     * Fill the driver's cache with all supported sensors connected to the bus.
+     *
+     * The routine clears the cache, search-scans the bus and reads scratchpad
+     * of each detected sensor. If all the sensors fit into the cache, the
+     * cache is marked as complete.
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Operation finished with success.
+     *     - @c EC_UNSUPPORED: No cache provided for the driver.
+     *     - @c EC_BUS_ERROR: Bus error.
+     *     - @c EC_CRC_ERROR: CRC error (search or scratchpad read).
+     *
+     * @note Search filters are honored during the search-scan, therefore
+     *     sensors families filtered out are not cached and the completeness
+     *     of the cache may be violated.
+     */
+    OneWireNg::ErrorCode fillCache();
+#endif
+
 #if (CONFIG_MAX_SEARCH_FILTERS > 0)
     /**
      * Add supported thermometers family codes into 1-wire service search filter.
@@ -579,7 +967,8 @@ public:
     const static int SUPPORTED_SLAVES_NUM = 5;
 
 protected:
-    void waitForCompletion(int ms, bool parasitic, int scanTimeoutMs);
+    int waitForCompletion(
+        int ms, bool parasitic, int scanTimeoutMs, int scanSleepMs = 0);
 
     template<int MAX_TIME>
     OneWireNg::ErrorCode _convertTemp(
@@ -589,10 +978,30 @@ protected:
             (id ? _ow.addressSingle(*id) : _ow.addressAll());
 
         if (ec == OneWireNg::EC_SUCCESS) {
+            int maxTime = MAX_TIME;
+            int predTime = 0;
+#if CONFIG_DSTHERM_CACHE
+            if (_cache) {
+                maxTime = _cache->getConvTime(id, MAX_TIME);
+                predTime = _cache->getPredConvTime(id);
+            }
+#endif
             _ow.writeByte(CMD_CONVERT_T, parasitic);
-            waitForCompletion(
-                (convTime < 0 && parasitic ? MAX_TIME : convTime),
-                parasitic, MAX_TIME);
+#if CONFIG_DSTHERM_CACHE
+            if (_cache)
+                _cache->invalidate(id);
+#endif
+            int time = waitForCompletion(
+                (convTime < 0 && parasitic ? maxTime : convTime),
+                parasitic, maxTime,
+                /* sleep shortly before the predicted completion */
+                predTime - (predTime >> 3) - 1);
+#if CONFIG_DSTHERM_CACHE
+            if (_cache && convTime < 0 && !parasitic && time < maxTime)
+                _cache->learnConvTime(id, time);
+#else
+            (void)time;
+#endif
         }
         return ec;
     }
@@ -608,6 +1017,12 @@ protected:
 
     OneWireNg::ErrorCode _recallEeprom(const OneWireNg::Id *id);
 
+#if CONFIG_SEARCH_ENABLED
+    /* family: thermocouples family code, 0 for supported thermometers */
+    OneWireNg::ErrorCode _readTempAll(
+        ReadingSink& sink, bool alarm, size_t *n, uint8_t family);
+#endif
+
     int _readPowerSupply(const OneWireNg::Id *id);
 
     /* integer right shift (sign aware) */
@@ -621,6 +1036,9 @@ protected:
     }
 
     OneWireNg& _ow;
+#if CONFIG_DSTHERM_CACHE
+    Cache *_cache;
+#endif
 
     typedef struct {
         uint8_t code;
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_DSTHERM_BATCH__
+#define __OWNG_DSTHERM_BATCH__
+
+#include "drivers/MAX31850.h"
+
+/**
+ * Compact batch of temperature readings with batch temperature decoding.
+ *
+ * Contrary to @c DSTherm::Scratchpad objects (each of them carrying 1-wire
+ * service reference, sensor id and 9 raw scratchpad bytes) the batch stores
+ * only data needed to decode the temperatures in separate columns (structure
+ * of arrays): format (derived from the sensor family), resolution and raw
+ * temperature (plus DS18S20 counters if @c CONFIG_DS18S20_EXT_RES is
+ * configured). Readings are identified by their indexes in the batch (as
+ * added by @ref add()), a caller is responsible to keep the indexes to ids
+ * mapping if needed.
+ *
+ * The whole batch is decoded in a single pass by @ref decodeTemp(),
+ * @ref decodeTemp2() or @ref decodeTempFloat(). The decoding loops have
+ * no data dependent branches - format and resolution specific masks and
+ * shifts are taken from lookup tables - which allows the compiler to
+ * vectorize them. The decoded values are the same as the ones returned by
+ * the scratchpad objects getters.
+ *
+ * @tparam N Batch capacity.
+ */
+template<size_t N>
+class DSThermBatch
+{
+public:
+    /**
+     * Temperature format.
+     */
+    typedef enum
+    {
+        FMT_DSTHERM = 0,    /** DS18B20, DS1822, DS1825, DS28EA00 */
+        FMT_DS18S20,        /** DS18S20 */
+        FMT_MAX31850,       /** MAX31850 thermocouple temperature */
+        FMT_MAX31850_INT    /** MAX31850 internal (cold-junction) temp. */
+    } Format;
+
+    DSThermBatch(): _n(0) {}
+
+    /**
+     * Add temperature reading of a Dallas thermometer.
+     *
+     * @return @c true on success, @c false if the batch is full.
+     */
+    bool add(const DSTherm::Scratchpad& scrpd)
+    {
+        const uint8_t *raw = scrpd.getRaw();
+
+        if (scrpd.getId()[0] == DSTherm::DS18S20) {
+            return add(FMT_DS18S20, 0, raw[0], raw[1], raw[6], raw[7]);
+        }
+        return add(FMT_DSTHERM, (raw[4] >> 5) & 3, raw[0], raw[1], 0, 0);
+    }
+
+    /**
+     * Add thermocouple temperature reading of MAX31850.
+     *
+     * @param internal If @c true the internal (cold-junction) temperature
+     *     is added instead.
+     *
+     * @return @c true on success, @c false if the batch is full.
+     */
+    bool add(const MAX31850::Scratchpad& scrpd, bool internal = false)
+    {
+        const uint8_t *raw = scrpd.getRaw();
+
+        if (internal)
+            return add(FMT_MAX31850_INT, 0, raw[2], raw[3], 0, 0);
+        return add(FMT_MAX31850, 0, raw[0], raw[1], 0, 0);
+    }
+
+    /**
+     * Decode all temperatures of the batch (1000 scaled).
+     *
+     * @param temps Output table for @ref size() temperatures.
+     * @see DSTherm::Scratchpad::getTemp()
+     */
+    void decodeTemp(long *temps) const
+    {
+        for (size_t i = 0; i < _n; i++)
+        {
+            long t = div2(toTemp2(i) * 1000, 4);
+#if CONFIG_DS18S20_EXT_RES
+            long e = extMask(i);
+            long te = (rsh(_raw[i], 1) * 1000) +
+                ((1000L * (long)(int8_t)(_perC[i] - _remain[i])) /
+                    (long)(_perC[i] | !e)) - 250;
+            t = (t & ~e) | (te & e);
+#endif
+            temps[i] = t;
+        }
+    }
+
+    /**
+     * Decode all temperatures of the batch (16 scaled).
+     *
+     * @param temps Output table for @ref size() temperatures.
+     * @see DSTherm::Scratchpad::getTemp2()
+     */
+    void decodeTemp2(long *temps) const
+    {
+        for (size_t i = 0; i < _n; i++)
+            temps[i] = toTemp2(i);
+    }
+
+    /**
+     * Decode all temperatures of the batch (Celsius degrees).
+     *
+     * @param temps Output table for @ref size() temperatures.
+     */
+    void decodeTempFloat(float *temps) const
+    {
+        for (size_t i = 0; i < _n; i++)
+            temps[i] = (float)toTemp2(i) * (1.0f / 16);
+    }
+
+    /**
+     * Get number of readings in the batch.
+     */
+    size_t size() const {
+        return _n;
+    }
+
+    /**
+     * Clear the batch.
+     */
+    void clear() {
+        _n = 0;
+    }
+
+    Format getFormat(size_t i) const {
+        return (Format)_fmt[i];
+    }
+
+    /**
+     * Get raw temperature of a reading (as read from the scratchpad).
+     */
+    int16_t getRaw(size_t i) const {
+        return _raw[i];
+    }
+
+private:
+    bool add(Format fmt, uint8_t res,
+        uint8_t lsb, uint8_t msb, uint8_t remain, uint8_t perC)
+    {
+        if (_n >= N)
+            return false;
+
+        _fmt[_n] = (uint8_t)fmt;
+        _res[_n] = res;
+        _raw[_n] = (int16_t)(((unsigned)msb << 8) | lsb);
+#if CONFIG_DS18S20_EXT_RES
+        _remain[_n] = remain;
+        _perC[_n] = perC;
+#else
+        (void)remain;
+        (void)perC;
+#endif
+        _n++;
+        return true;
+    }
+
+    /*
+     * Temperature (16 scaled) of i-th reading:
+     * ((raw & mask) << lsh) >> rsh
+     * with the parameters taken from the format/resolution lookup tables.
+     */
+    long toTemp2(size_t i) const
+    {
+        unsigned d = ((unsigned)_fmt[i] << 2) | _res[i];
+        long t = rsh(
+            ((long)_raw[i] & (long)MASK[d]) * (1L << LSH[d]), RSH[d]);
+#if CONFIG_DS18S20_EXT_RES
+        long e = extMask(i);
+        long te = (((long)_raw[i] & ~1L) * 8) +
+            ((long)(int8_t)(_perC[i] - _remain[i]) * 16) /
+                (long)(_perC[i] | !e) - 4;
+        t = (t & ~e) | (te & e);
+#endif
+        return t;
+    }
+
+    /*
+     * Sign aware integer right shift and power 2 division (as their
+     * DSTherm counterparts) with no branches and no shifts of negative
+     * values; s is all ones mask for negative v.
+     */
+    static long rsh(long v, unsigned sh) {
+        long s = -(long)(v < 0);
+        return s ^ ((s ^ v) >> sh);
+    }
+
+    static long div2(long v, unsigned pow) {
+        long s = -(long)(v < 0);
+        return ((((s ^ v) - s) >> pow) ^ s) - s;
+    }
+
+#if CONFIG_DS18S20_EXT_RES
+    /*
+     * All ones mask if extended resolution applies to i-th reading
+     * (DS18S20 with non-zero count per C), zero otherwise.
+     */
+    long extMask(size_t i) const {
+        return -(long)((_fmt[i] == FMT_DS18S20) & (_perC[i] != 0));
+    }
+#endif
+
+    /* decoding parameters indexed by (format << 2 | resolution) */
+    static const int16_t MASK[16];
+    static const uint8_t LSH[16];
+    static const uint8_t RSH[16];
+
+    uint8_t _fmt[N];        /** format column */
+    uint8_t _res[N];        /** resolution column */
+    int16_t _raw[N];        /** raw temperature column */
+#if CONFIG_DS18S20_EXT_RES
+    uint8_t _remain[N];     /** DS18S20 count remain column */
+    uint8_t _perC[N];       /** DS18S20 count per C column */
+#endif
+    size_t _n;
+};
+
+template<size_t N>
+const int16_t DSThermBatch<N>::MASK[16] = {
+    /* FMT_DSTHERM: undefined bits masked per resolution */
+    ~7, ~3, ~1, ~0,
+    /* FMT_DS18S20 */
+    ~0, ~0, ~0, ~0,
+    /* FMT_MAX31850: fault and reserved bits masked */
+    ~3, ~3, ~3, ~3,
+    /* FMT_MAX31850_INT */
+    ~0, ~0, ~0, ~0
+};
+
+template<size_t N>
+const uint8_t DSThermBatch<N>::LSH[16] = {
+    0, 0, 0, 0,
+    3, 3, 3, 3,
+    0, 0, 0, 0,
+    0, 0, 0, 0
+};
+
+template<size_t N>
+const uint8_t DSThermBatch<N>::RSH[16] = {
+    0, 0, 0, 0,
+    0, 0, 0, 0,
+    0, 0, 0, 0,
+    4, 4, 4, 4
+};
+
+#endif /* __OWNG_DSTHERM_BATCH__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021,2022,2024 Piotr Stolarz
+ * Copyright (c) 2021,2022,2024,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -164,6 +164,7 @@ public:
     friend class MAX31850;
 #ifdef OWNG_TEST
     friend class MAX31850_Test;
+    friend class DSThermBatch_Test;
 #endif
     };
 
@@ -180,6 +181,22 @@ public:
      */
     MAX31850(OneWireNg& ow): DSTherm(ow) {}
 
+#if CONFIG_DSTHERM_CACHE
+    /**
+     * Sensors cache.
+     * @see DSTherm::Cache
+     */
+    using DSTherm::Cache;
+
+    /**
+     * MAX31850 driver constructor with sensors cache.
+     *
+     * @param ow 1-wire service.
+     * @param cache Sensors cache (may be @c NULL).
+     */
+    MAX31850(OneWireNg& ow, Cache *cache): DSTherm(ow, cache) {}
+#endif
+
     /**
      * Start temperature conversion for an addressed sensor.
      *
@@ -243,6 +260,30 @@ public:
      */
     using DSTherm::readPowerSupplyAll;
 
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Readings of thermocouples. Temperature of a reading is the
+     * thermocouple temperature register (16 scaled temperature in bits
+     * 2-15, fault status in bit 0).
+     *
+     * @see DSTherm::Reading
+     */
+    using DSTherm::Reading;
+    using DSTherm::ReadingSink;
+
+    /**
+     * Read temperatures of all thermocouples on the bus into a readings
+     * sink.
+     *
+     * @see DSTherm::readTempAll
+     */
+    OneWireNg::ErrorCode readTempAll(
+        ReadingSink& sink, bool alarm = false, size_t *n = NULL)
+    {
+        return _readTempAll(sink, alarm, n, FAMILY_CODE);
+    }
+#endif
+
     using DSTherm::SCAN_BUS;
 
     /** Function command set */
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "drivers/MemDevice.h"
+
+#define STR(m) #m
+
+const MemDevice::Geometry MemDevice::GEOMETRIES[SUPPORTED_SLAVES_NUM] =
+{
+    /* code  read cmd             crc        page  size */
+    { 0x06, CMD_READ_MEMORY,      CRC_NONE,    32,   512, STR(DS1993) },
+    { 0x08, CMD_READ_MEMORY,      CRC_NONE,    32,   128, STR(DS1992) },
+    { 0x0a, CMD_READ_MEMORY,      CRC_NONE,    32,  2048, STR(DS1995) },
+    { 0x0b, CMD_READ_DATA_CRC,    CRC_8,       32,  2048, STR(DS2505) },
+    { 0x0c, CMD_READ_MEMORY,      CRC_NONE,    32,  8192, STR(DS1996) },
+    { 0x0f, CMD_READ_DATA_CRC,    CRC_8,       32,  8192, STR(DS2506) },
+    { 0x23, CMD_READ_MEMORY,      CRC_NONE,    32,   512, STR(DS2433) },
+    /* data memory, control bytes and reserved row */
+    { 0x2d, CMD_READ_MEMORY,      CRC_NONE,    32,   144, STR(DS2431) },
+    { 0x43, CMD_EXT_READ_MEMORY,  CRC_INV16,   32,  2560, STR(DS28EC20) }
+};
+
+const MemDevice::Geometry *MemDevice::getGeometry(const OneWireNg::Id& id)
+{
+    for (size_t i = 0; i < SUPPORTED_SLAVES_NUM; i++) {
+        if (id[0] == GEOMETRIES[i].code)
+            return &GEOMETRIES[i];
+    }
+    return NULL;
+}
+
+OneWireNg::ErrorCode MemDevice::read(
+    unsigned addr, size_t len, Sink sink, void *arg)
+{
+    if (!_geom || addr + len > _geom->size)
+        return OneWireNg::EC_UNSUPPORED;
+    if (!len)
+        return OneWireNg::EC_SUCCESS;
+
+    OneWireNg::ErrorCode ec = _ow.addressSingle(_id);
+    if (ec != OneWireNg::EC_SUCCESS)
+        return ec;
+
+    /* command, page data followed by CRC */
+    uint8_t buf[3 + MAX_PAGE_SIZE + 2];
+    uint8_t *data = &buf[3];
+    uint8_t crc = _geom->crc;
+
+#if !CONFIG_CRC16_ENABLED
+    if (crc == CRC_INV16)
+        crc = CRC_NONE;
+#endif
+    buf[0] = (crc != CRC_NONE ? _geom->readCmd : CMD_READ_MEMORY);
+    buf[1] = (uint8_t)(addr & 0xff);    /* TA1 */
+    buf[2] = (uint8_t)(addr >> 8);      /* TA2 */
+    _ow.writeBytes(buf, 3);
+
+    if (crc == CRC_8) {
+        /* CRC-8 of the command and address */
+        if (OneWireNg::crc8(buf, 3) != _ow.readByte())
+            return OneWireNg::EC_CRC_ERROR;
+    }
+
+    for (bool first = true; len > 0; first = false)
+    {
+        /* bytes remaining to the page end */
+        size_t rem = _geom->pageSize - (addr % _geom->pageSize);
+        if (rem > _geom->size - addr)
+            rem = _geom->size - addr;
+        size_t n = (rem < len ? rem : len);
+
+        /* the whole page needs to be read to get its CRC */
+#if CONFIG_CRC16_ENABLED
+        if (crc == CRC_INV16) {
+            _ow.readBytes(data, rem + 2);
+
+            /* CRC of the 1st page covers the command and address */
+            ec = (first ?
+                OneWireNg::checkInvCrc16(
+                    buf, 3 + rem, OneWireNg::getLSB_u16(&data[rem])) :
+                OneWireNg::checkInvCrc16(
+                    data, rem, OneWireNg::getLSB_u16(&data[rem])));
+            if (ec != OneWireNg::EC_SUCCESS)
+                return ec;
+        } else
+#endif
+        if (crc == CRC_8) {
+            _ow.readBytes(data, rem + 1);
+            if (OneWireNg::crc8(data, rem) != data[rem])
+                return OneWireNg::EC_CRC_ERROR;
+        } else {
+            _ow.readBytes(data, n);
+        }
+
+        if (!sink(addr, data, n, arg))
+            break;
+
+        addr += n;
+        len -= n;
+    }
+    return ec;
+}
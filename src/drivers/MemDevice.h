@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_MEM_DEVICE__
+#define __OWNG_MEM_DEVICE__
+
+#include <string.h>  /* memcpy */
+#include "OneWireNg.h"
+
+/**
+ * Generic 1-wire memory device (EEPROM, EPROM, NV RAM) reader.
+ *
+ * Geometry of supported devices (memory and page sizes, read commands)
+ * is kept in a static table indexed by the family code. Memory is read
+ * by a single streamed read command and passed to a user sink in page
+ * sized chunks, therefore reading memory of any size requires a single
+ * page buffer only.
+ *
+ * For devices supporting read command with CRC generated at the end of
+ * each page the CRC is verified for each page before passing it to the
+ * sink:
+ * - DS28EC20 "Extended Read Memory": inverted CRC-16 per page (the 1st one
+ *   covers the command and address too). Verified if @c CONFIG_CRC16_ENABLED
+ *   is configured, otherwise "Read Memory" command is used.
+ * - DS2505, DS2506 "Read Data/Generate 8-bit CRC": CRC-8 of the command and
+ *   address followed by CRC-8 per page.
+ *
+ * For other devices data is read by the "Read Memory" command, which is not
+ * CRC protected.
+ *
+ * The following devices are supported: DS1992, DS1993, DS1995, DS1996,
+ * DS2431, DS2433, DS2505, DS2506, DS28EC20.
+ */
+class MemDevice
+{
+public:
+    /** Memory function commands */
+    const static uint8_t CMD_READ_MEMORY     = 0xf0;
+    const static uint8_t CMD_EXT_READ_MEMORY = 0xa5;  /** DS28EC20 */
+    const static uint8_t CMD_READ_DATA_CRC   = 0xc3;  /** DS2505, DS2506 */
+
+    /**
+     * CRC type of the memory read command.
+     */
+    typedef enum
+    {
+        CRC_NONE = 0,   /** no CRC */
+        CRC_INV16,      /** inverted CRC-16 per page */
+        CRC_8           /** CRC-8 of the command and address, CRC-8 per page */
+    } CrcType;
+
+    /** Maximum page size of supported devices */
+    const static size_t MAX_PAGE_SIZE = 32;
+
+    /**
+     * Memory device geometry.
+     */
+    typedef struct
+    {
+        uint8_t code;           /** family code */
+        uint8_t readCmd;        /** memory read command */
+        uint8_t crc;            /** read command CRC type (@ref CrcType) */
+        uint16_t pageSize;      /** page size */
+        uint32_t size;          /** memory size */
+        const char *name;       /** family name */
+    } Geometry;
+
+    /**
+     * Memory sink.
+     *
+     * @param addr Memory address of the chunk.
+     * @param data Chunk data.
+     * @param len Chunk length (at most page size).
+     * @param arg User argument.
+     *
+     * @return @c false to stop reading.
+     */
+    typedef bool (*Sink)(
+        unsigned addr, const uint8_t *data, size_t len, void *arg);
+
+    /**
+     * Create reader for a memory device.
+     *
+     * @param ow 1-wire service.
+     * @param id Device id.
+     */
+    MemDevice(OneWireNg& ow, const OneWireNg::Id& id):
+        _ow(ow), _geom(getGeometry(id))
+    {
+        memcpy(&_id, &id, sizeof(OneWireNg::Id));
+    }
+
+    const OneWireNg::Id& getId() const {
+        return _id;
+    }
+
+    /**
+     * Get geometry of the device or @c NULL if the device is not supported.
+     */
+    const Geometry *getGeometry() const {
+        return _geom;
+    }
+
+    /**
+     * Read device memory.
+     *
+     * The memory is read by a single read command and passed to @c sink
+     * in chunks not crossing pages boundaries.
+     *
+     * @param addr Memory address to start reading from.
+     * @param len Number of bytes to read.
+     * @param sink Memory sink.
+     * @param arg User argument passed to the sink.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success (also if reading stopped by the sink).
+     *     - @c EC_NO_DEVS: No devices on the bus.
+     *     - @c EC_CRC_ERROR: Page CRC error. Pages preceding the erroneous
+     *         one have been already passed to the sink.
+     *     - @c EC_UNSUPPORED: Not supported device or read exceeding the
+     *         memory size.
+     */
+    OneWireNg::ErrorCode read(
+        unsigned addr, size_t len, Sink sink, void *arg = NULL);
+
+    /**
+     * Get geometry of a memory device with given id.
+     *
+     * @return Geometry or @c NULL if the device is not supported.
+     */
+    static const Geometry *getGeometry(const OneWireNg::Id& id);
+
+    /**
+     * Get family name of given slave id.
+     *
+     * @return Family name or @c NULL if the id doesn't represent supported
+     *     memory device.
+     */
+    static const char *getFamilyName(const OneWireNg::Id& id)
+    {
+        const Geometry *geom = getGeometry(id);
+        return (geom ? geom->name : NULL);
+    }
+
+    const static int SUPPORTED_SLAVES_NUM = 9;
+
+protected:
+    OneWireNg& _ow;
+    OneWireNg::Id _id;
+    const Geometry *_geom;
+
+    static const Geometry GEOMETRIES[SUPPORTED_SLAVES_NUM];
+};
+
+#endif /* __OWNG_MEM_DEVICE__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022,2024 Piotr Stolarz
+ * Copyright (c) 2022,2024,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -11,6 +11,7 @@
  */
 
 #include "platform/OneWireNg_ArduinoIdfESP32.h"
+#include "platform/OneWireNg_ArduinoIdfESP32Multi.h"
 #ifdef IDF_VER
 # include "sdkconfig.h"
 #endif
@@ -218,6 +219,73 @@ void OneWireNg_ArduinoIdfESP32::initPwrCtrlGpio(unsigned pin)
 }
 #endif /* CONFIG_PWR_CTRL_ENABLED */
 
+/*
+ * Lockstep multi-bus bit-banging. GPIO port is handled by the same set/clear
+ * registers as the single GPIO, with the buses mask used as the GPIOs mask.
+ */
+TIME_CRITICAL uint32_t OneWireNg_ArduinoIdfESP32Multi::readPortIn()
+{
+    return *_port.inReg;
+}
+
+TIME_CRITICAL void OneWireNg_ArduinoIdfESP32Multi::setPortAsInput(
+    uint32_t mask)
+{
+    *_port.modClrReg = mask;
+}
+
+TIME_CRITICAL void OneWireNg_ArduinoIdfESP32Multi::setPortAsOutput(
+    uint32_t mask, int state)
+{
+    if (state) {
+        *_port.outSetReg = mask;
+    } else {
+        *_port.outClrReg = mask;
+    }
+    *_port.modSetReg = mask;
+}
+
+void OneWireNg_ArduinoIdfESP32Multi::initPort(
+    const unsigned *pins, size_t n, bool pullUp)
+{
+    uint32_t mask = 0;
+
+    assert(n > 0);
+
+#if CONFIG_BITBANG_DELAY_CCOUNT
+    ccntUpdateCpuFreqMHz();
+#endif
+
+    for (size_t i = 0; i < n; i++)
+    {
+        assert(GPIO_IS_VALID_GPIO((int)pins[i]) &&
+            GPIO_IS_VALID_OUTPUT_GPIO((int)pins[i]));
+        /* all the GPIOs must belong to the same port */
+        assert((pins[i] < 32) == (pins[0] < 32));
+
+        mask |= getBusMask(pins[i]);
+        _pinMode(pins[i], __INPUT | (pullUp ? __PULLUP : 0));
+    }
+
+    if (pins[0] < 32) {
+        _port.inReg = &REG_GPIO_IN_LO;
+        _port.outSetReg = &REG_GPIO_OUT_SET_LO;
+        _port.outClrReg = &REG_GPIO_OUT_CLR_LO;
+        _port.modSetReg = &REG_GPIO_MOD_SET_LO;
+        _port.modClrReg = &REG_GPIO_MOD_CLR_LO;
+    }
+#if (GPIO_PIN_COUNT > 32)
+    else {
+        _port.inReg = &REG_GPIO_IN_HI;
+        _port.outSetReg = &REG_GPIO_OUT_SET_HI;
+        _port.outClrReg = &REG_GPIO_OUT_CLR_HI;
+        _port.modSetReg = &REG_GPIO_MOD_SET_HI;
+        _port.modClrReg = &REG_GPIO_MOD_CLR_HI;
+    }
+#endif
+    setupBuses(mask);
+}
+
 #undef __GPIO_AS_OUTPUT
 #undef __GPIO_AS_INPUT
 #undef __WRITE_GPIO
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_ARDUINO_IDF_ESP32_MULTI__
+#define __OWNG_ARDUINO_IDF_ESP32_MULTI__
+
+#include "OneWireNg_BitBangMulti.h"
+#include "platform/Platform_Delay.h"
+
+/**
+ * Arduino/ESP-IDF ESP32 platform GPIO port specific implementation of
+ * lockstep, multi-bus bit-banging.
+ */
+class OneWireNg_ArduinoIdfESP32Multi: public OneWireNg_BitBangMulti
+{
+public:
+    /**
+     * Lockstep 1-wire service for a set of buses on Arduino/ESP-IDF ESP32
+     * platform.
+     *
+     * @param pins GPIO pin numbers used for bit-banging 1-wire buses. All
+     *     the pins must belong to the same GPIO port (that is pins numbers
+     *     0-31 or 32 and above).
+     * @param n Number of pins.
+     * @param pullUp If @c true configure internal pull-up resistors for
+     *     the buses.
+     */
+    OneWireNg_ArduinoIdfESP32Multi(const unsigned *pins, size_t n, bool pullUp)
+    {
+        initPort(pins, n, pullUp);
+    }
+
+    /**
+     * Get bus mask for a given GPIO pin number.
+     */
+    static uint32_t getBusMask(unsigned pin) {
+        return (uint32_t)(1UL << (pin & 31));
+    }
+
+protected:
+    uint32_t readPortIn();
+    void setPortAsInput(uint32_t mask);
+    void setPortAsOutput(uint32_t mask, int state);
+
+    void initPort(const unsigned *pins, size_t n, bool pullUp);
+
+    struct {
+        volatile uint32_t *inReg;
+        volatile uint32_t *outSetReg;
+        volatile uint32_t *outClrReg;
+        volatile uint32_t *modSetReg;
+        volatile uint32_t *modClrReg;
+    } _port;
+};
+
+#endif /* __OWNG_ARDUINO_IDF_ESP32_MULTI__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2022,2025 Piotr Stolarz
+ * Copyright (c) 2022,2025,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -18,6 +18,9 @@
 
 #include "hardware/clocks.h"
 #include "hardware/gpio.h"
+#if CONFIG_RP2040_PIO_DMA
+# include "hardware/dma.h"
+#endif
 #include "platform/rp2040/w1.pio.h"
 
 #if CONFIG_RP2040_PIOSM_NUM_USED == 1
@@ -34,9 +37,22 @@
  * RP2040's PIO peripheral specific implementation of 1-wire bus activities:
  * reset, touch, parasite powering.
  *
+ * Bytes are touched by a dedicated PIO program taking the bytes from the TX
+ * FIFO (autopull) and pushing the touched bytes into the RX FIFO (autopush),
+ * with no CPU intervention per bit. If @ref CONFIG_RP2040_PIO_DMA is
+ * configured, the FIFOs are served by DMA, so the CPU is involved once per
+ * transfer. The program is also used to touch search triplets, with a single
+ * PIO SM run per triplet.
+ *
  * @note The driver uses Pico SDK API to handle PIO activities. Since the SDK
  *     is part of Arduino framework, the driver may be used for both of these
  *     frameworks.
+ * @note The bytes and triplet touch methods (@ref touchByte(),
+ *     @ref touchBytes(), @ref touchTriplet()) and bulk write/read methods
+ *     (@ref writeBytes(), @ref readBytes()) are part of the extended
+ *     virtual interface. To use them by generic 1-wire routines and
+ *     devices drivers (calling the methods via @c OneWireNg interface), the
+ *     library needs to be configured with @ref CONFIG_EXT_VIRTUAL_INTF.
  */
 class OneWireNg_PicoRP2040PIO: public OneWireNg
 {
@@ -84,27 +100,43 @@ public:
         _addrs[RESET_STD]  = pio_add_program(_pio, &w1_reset_program);
         _addrs[TOUCH0_STD] = pio_add_program(_pio, &w1_touch0_program);
         _addrs[TOUCH1_STD] = pio_add_program(_pio, &w1_touch1_program);
+        _addrs[BYTES_STD]  = pio_add_program(_pio, &w1_bytes_program);
 #if CONFIG_OVERDRIVE_ENABLED
         _addrs[RESET_OD]   = _addrs[RESET_STD];
         _addrs[TOUCH0_OD]  = _addrs[TOUCH0_STD];
         _addrs[TOUCH1_OD]  = _addrs[TOUCH1_STD];
+        _addrs[BYTES_OD]   = _addrs[BYTES_STD];
 #endif
         uint sysMHz = clock_get_hz(clk_sys) / 1000000;
         _divs[RESET_STD]  = (w1_reset_cycle * sysMHz) / 10;
         _divs[TOUCH0_STD] = (w1_touch0_cycle * sysMHz) / 10;
         _divs[TOUCH1_STD] = (w1_touch1_cycle * sysMHz) / 10;
+        _divs[BYTES_STD]  = (w1_bytes_cycle * sysMHz) / 10;
 #if CONFIG_OVERDRIVE_ENABLED
         _divs[RESET_OD]   = (w1_reset_od_cycle * sysMHz) / 10;
         _divs[TOUCH0_OD]  = (w1_touch0_od_cycle * sysMHz) / 10;
         _divs[TOUCH1_OD]  = (w1_touch1_od_cycle * sysMHz) / 10;
+        _divs[BYTES_OD]   = (w1_bytes_od_cycle * sysMHz) / 10;
 #endif
         _wraps[RESET_STD]  = w1_reset_wrap_target;
         _wraps[TOUCH0_STD] = w1_touch0_wrap_target;
         _wraps[TOUCH1_STD] = w1_touch1_wrap_target;
+        _wraps[BYTES_STD]  = w1_bytes_wrap_target;
 #if CONFIG_OVERDRIVE_ENABLED
         _wraps[RESET_OD]   = _wraps[RESET_STD];
         _wraps[TOUCH0_OD]  = _wraps[TOUCH0_STD];
         _wraps[TOUCH1_OD]  = _wraps[TOUCH1_STD];
+        _wraps[BYTES_OD]   = _wraps[BYTES_STD];
+#endif
+        _wrapTops[RESET_STD]  = w1_reset_wrap;
+        _wrapTops[TOUCH0_STD] = w1_touch0_wrap;
+        _wrapTops[TOUCH1_STD] = w1_touch1_wrap;
+        _wrapTops[BYTES_STD]  = w1_bytes_wrap;
+#if CONFIG_OVERDRIVE_ENABLED
+        _wrapTops[RESET_OD]   = _wrapTops[RESET_STD];
+        _wrapTops[TOUCH0_OD]  = _wrapTops[TOUCH0_STD];
+        _wrapTops[TOUCH1_OD]  = _wrapTops[TOUCH1_STD];
+        _wrapTops[BYTES_OD]   = _wrapTops[BYTES_STD];
 #endif
         /* Prepare PIO configuration
          */
@@ -121,10 +153,25 @@ public:
         /* left-shift, no-autopush, IN threshold: 1 */
         sm_config_set_in_shift(&_pioCfg, false, false, 1);
 
+        /* bytes touch: right-shift, autopush/autopull, IN/OUT threshold: 8 */
+        _pioBytesCfg = _pioCfg;
+        sm_config_set_in_shift(&_pioBytesCfg, true, true, 8);
+        sm_config_set_out_shift(&_pioBytesCfg, true, true, 8);
+
+        /* search triplet: as bytes touch with IN/OUT threshold: 1 */
+        _pioBitsCfg = _pioBytesCfg;
+        sm_config_set_in_shift(&_pioBitsCfg, true, true, 1);
+        sm_config_set_out_shift(&_pioBitsCfg, true, true, 1);
+        _touchCfg = &_pioCfg;
+
         /* set the default config for the PIO SM(s) */
         pio_sm_set_config(_pio, _sm1, &_pioCfg);
 #if CONFIG_RP2040_PIOSM_NUM_USED > 1
         pio_sm_set_config(_pio, _sm2, &_pioCfg);
+#endif
+#if CONFIG_RP2040_PIO_DMA
+        _dmaTx = dma_claim_unused_channel(true);
+        _dmaRx = dma_claim_unused_channel(true);
 #endif
     }
 
@@ -172,6 +219,7 @@ public:
         memcpy(_addrs, base._addrs, sizeof(_addrs));
         memcpy(_divs, base._divs, sizeof(_divs));
         memcpy(_wraps, base._wraps, sizeof(_wraps));
+        memcpy(_wrapTops, base._wrapTops, sizeof(_wrapTops));
 
         /* Prepare PIO configuration
          */
@@ -188,10 +236,25 @@ public:
         /* left-shift, no-autopush, IN threshold: 1 */
         sm_config_set_in_shift(&_pioCfg, false, false, 1);
 
+        /* bytes touch: right-shift, autopush/autopull, IN/OUT threshold: 8 */
+        _pioBytesCfg = _pioCfg;
+        sm_config_set_in_shift(&_pioBytesCfg, true, true, 8);
+        sm_config_set_out_shift(&_pioBytesCfg, true, true, 8);
+
+        /* search triplet: as bytes touch with IN/OUT threshold: 1 */
+        _pioBitsCfg = _pioBytesCfg;
+        sm_config_set_in_shift(&_pioBitsCfg, true, true, 1);
+        sm_config_set_out_shift(&_pioBitsCfg, true, true, 1);
+        _touchCfg = &_pioCfg;
+
         /* set the default config for the PIO SM(s) */
         pio_sm_set_config(_pio, _sm1, &_pioCfg);
 #if CONFIG_RP2040_PIOSM_NUM_USED > 1
         pio_sm_set_config(_pio, _sm2, &_pioCfg);
+#endif
+#if CONFIG_RP2040_PIO_DMA
+        _dmaTx = dma_claim_unused_channel(true);
+        _dmaRx = dma_claim_unused_channel(true);
 #endif
     }
 
@@ -206,6 +269,10 @@ public:
 #if CONFIG_RP2040_PIOSM_NUM_USED > 1
         pio_sm_set_enabled(_pio, _sm2, false);
         pio_sm_unclaim(_pio, _sm2);
+#endif
+#if CONFIG_RP2040_PIO_DMA
+        dma_channel_unclaim(_dmaTx);
+        dma_channel_unclaim(_dmaRx);
 #endif
         /*
          * Dispose the PIO programs only in case the object is in ownership
@@ -216,6 +283,7 @@ public:
             pio_remove_program(_pio, &w1_reset_program, _addrs[RESET_STD]);
             pio_remove_program(_pio, &w1_touch0_program, _addrs[TOUCH0_STD]);
             pio_remove_program(_pio, &w1_touch1_program, _addrs[TOUCH1_STD]);
+            pio_remove_program(_pio, &w1_bytes_program, _addrs[BYTES_STD]);
             _progOwner = false;
         }
     }
@@ -255,6 +323,97 @@ public:
         return (pioRun(progId, __SM_TOUCH) & 1);
     }
 
+    /**
+     * Byte touch (via PIO bytes touch program).
+     *
+     * @note If @c power is requested, the byte is touched bit-by-bit to
+     *     switch the power pull-up just after the last bit.
+     */
+    uint8_t touchByte(uint8_t byte, bool power = false)
+    {
+        if (power)
+            return OneWireNg::touchByte(byte, power);
+
+        pioBytes(&byte, &byte, 1);
+        return byte;
+    }
+
+    /**
+     * Array of bytes touch (via PIO bytes touch program).
+     *
+     * @note If @c power is requested, the last byte is touched bit-by-bit to
+     *     switch the power pull-up just after the last bit.
+     */
+    void touchBytes(uint8_t *bytes, size_t len, bool power = false)
+    {
+        if (power && len > 0) {
+            pioBytes(bytes, bytes, len - 1);
+            bytes[len - 1] = OneWireNg::touchByte(bytes[len - 1], power);
+        } else {
+            pioBytes(bytes, bytes, len);
+        }
+    }
+
+    /**
+     * Array of bytes write (via PIO bytes touch program). The touched bytes
+     * are dropped.
+     *
+     * @note If @c power is requested, the last byte is touched bit-by-bit to
+     *     switch the power pull-up just after the last bit.
+     */
+    void writeBytes(const uint8_t *bytes, size_t len, bool power = false)
+    {
+        if (power && len > 0) {
+            pioBytes(bytes, NULL, len - 1);
+            OneWireNg::touchByte(bytes[len - 1], power);
+        } else {
+            pioBytes(bytes, NULL, len);
+        }
+    }
+
+    /**
+     * Array of bytes read (via PIO bytes touch program). 0xff bytes are
+     * touched with no source buffer.
+     */
+    void readBytes(uint8_t *bytes, size_t len) {
+        pioBytes(NULL, bytes, len);
+    }
+
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Search triplet touch (via PIO bytes touch program).
+     *
+     * The triplet is touched by a single run of the program: both read slots
+     * are queued at once, and the selecting bit is passed to the program as
+     * soon as the read bits are received (the program waits for it with
+     * the bus released).
+     */
+    int touchTriplet(int dir)
+    {
+#if CONFIG_OVERDRIVE_ENABLED
+        int progId = BYTES_STD + (int)(_overdrive == true);
+#else
+        int progId = BYTES_STD;
+#endif
+        uint sm = __SM_TOUCH;
+
+        pio_sm_clear_fifos(_pio, sm);
+        pio_sm_put(_pio, sm, 1);
+        pio_sm_put(_pio, sm, 1);
+        pioStart(progId, sm, &_pioBitsCfg);
+
+        /* sampled bit is placed on the FIFO word's MSB */
+        int v0 = (int)(pio_sm_get_blocking(_pio, sm) >> 31);
+        int v1 = (int)(pio_sm_get_blocking(_pio, sm) >> 31);
+
+        pio_sm_put(_pio, sm, (uint32_t)(v0 != v1 ? v0 : dir));
+        pio_sm_get_blocking(_pio, sm);
+
+        pio_sm_set_enabled(_pio, sm, false);
+        return (v0 | (v1 << 1));
+    }
+#endif
+
     /**
      * Enable/disable direct voltage source provisioning on the 1-wire data bus.
      * Function always successes.
@@ -271,8 +430,8 @@ public:
     }
 
 protected:
-    /** Run w1 program on the PIO SM. */
-    uint32_t pioRun(int progId, uint sm)
+    /** Start w1 program on the PIO SM with a given config. */
+    void pioStart(int progId, uint sm, const pio_sm_config *cfg)
     {
         /* bind w1-bus GPIO to PIO if needed */
         if (!_pioBound) {
@@ -280,6 +439,16 @@ protected:
             _pioBound = true;
         }
 
+        /*
+         * Bytes touch program requires its own shift configuration
+         * (set on touch SM only).
+         */
+        if (sm == __SM_TOUCH && cfg != _touchCfg) {
+            pio_sm_set_config(_pio, sm, cfg);
+            _touchCfg = cfg;
+            _exeProg = INVALID_PROG;
+        }
+
         /*
          * Try to avoid some extra configuration if the lastly
          * executed program is the same as the requested one.
@@ -289,7 +458,7 @@ protected:
             /* set wrap for the program */
             pio_sm_set_wrap(_pio, sm,
                 _addrs[progId] + _wraps[progId],
-                _addrs[progId] + _wraps[progId]);
+                _addrs[progId] + _wrapTops[progId]);
 
             _exeProg = progId;
         }
@@ -304,6 +473,12 @@ protected:
 
         /* start the program execution by PIO SM */
         pio_sm_set_enabled(_pio, sm, true);
+    }
+
+    /** Run w1 program on the PIO SM. */
+    uint32_t pioRun(int progId, uint sm)
+    {
+        pioStart(progId, sm, &_pioCfg);
 
         /* wait until result will be ready */
         uint32_t res = pio_sm_get_blocking(_pio, sm);
@@ -314,6 +489,74 @@ protected:
         return res;
     }
 
+    /**
+     * Touch bytes by the bytes touch PIO program. Bytes are taken from @c tx
+     * (0xff bytes if @c NULL) and the touched bytes are stored in @c rx
+     * (dropped if @c NULL). @c tx and @c rx may point to the same buffer.
+     */
+    void pioBytes(const uint8_t *tx, uint8_t *rx, size_t len)
+    {
+        if (!len) return;
+
+#if CONFIG_OVERDRIVE_ENABLED
+        int progId = BYTES_STD + (int)(_overdrive == true);
+#else
+        int progId = BYTES_STD;
+#endif
+        uint sm = __SM_TOUCH;
+
+        pio_sm_clear_fifos(_pio, sm);
+        pioStart(progId, sm, &_pioBytesCfg);
+
+#if CONFIG_RP2040_PIO_DMA
+        dma_channel_config cfg;
+        /* fixed source/sink of not provided buffers */
+        uint8_t ones = 0xff, drop;
+
+        /* TX: 8-bit writes are replicated over the FIFO word */
+        cfg = dma_channel_get_default_config(_dmaTx);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+        channel_config_set_read_increment(&cfg, tx != NULL);
+        channel_config_set_write_increment(&cfg, false);
+        channel_config_set_dreq(&cfg, pio_get_dreq(_pio, sm, true));
+        dma_channel_configure(_dmaTx, &cfg,
+            &_pio->txf[sm], (tx ? tx : &ones), len, false);
+
+        /* RX: touched byte is placed on the FIFO word's MSB */
+        cfg = dma_channel_get_default_config(_dmaRx);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+        channel_config_set_read_increment(&cfg, false);
+        channel_config_set_write_increment(&cfg, rx != NULL);
+        channel_config_set_dreq(&cfg, pio_get_dreq(_pio, sm, false));
+        dma_channel_configure(_dmaRx, &cfg,
+            (rx ? rx : &drop), (io_rw_8*)&_pio->rxf[sm] + 3, len, false);
+
+        dma_start_channel_mask((1u << _dmaTx) | (1u << _dmaRx));
+        dma_channel_wait_for_finish_blocking(_dmaRx);
+#else
+        size_t ntx = 0, nrx = 0;
+
+        while (nrx < len) {
+            if (ntx < len && !pio_sm_is_tx_fifo_full(_pio, sm)) {
+                pio_sm_put(_pio, sm, (tx ? tx[ntx] : 0xff));
+                ntx++;
+            }
+
+            /* touched byte is placed on the FIFO word's MSB */
+            if (!pio_sm_is_rx_fifo_empty(_pio, sm)) {
+                uint8_t byte = (uint8_t)(pio_sm_get(_pio, sm) >> 24);
+                if (rx) rx[nrx] = byte;
+                nrx++;
+            }
+        }
+#endif
+        /*
+         * The last byte is pushed at the slot end, the program stalls
+         * on the bus released waiting for the next byte.
+         */
+        pio_sm_set_enabled(_pio, sm, false);
+    }
+
 #if CONFIG_OVERDRIVE_ENABLED
     enum {
         RESET_STD = 0,
@@ -322,6 +565,8 @@ protected:
         TOUCH0_OD,
         TOUCH1_STD,
         TOUCH1_OD,
+        BYTES_STD,
+        BYTES_OD,
 
         PROGS_NUM,
         INVALID_PROG = PROGS_NUM
@@ -331,6 +576,7 @@ protected:
         RESET_STD = 0,
         TOUCH0_STD,
         TOUCH1_STD,
+        BYTES_STD,
 
         PROGS_NUM,
         INVALID_PROG = PROGS_NUM
@@ -347,6 +593,20 @@ protected:
     /** PIO SM(s) common config */
     pio_sm_config _pioCfg;
 
+    /** PIO SM config for bytes touch program */
+    pio_sm_config _pioBytesCfg;
+
+    /** PIO SM config for bytes touch program touching search triplets */
+    pio_sm_config _pioBitsCfg;
+
+    /** Current config of touch PIO SM */
+    const pio_sm_config *_touchCfg;
+
+#if CONFIG_RP2040_PIO_DMA
+    int _dmaTx;   /** DMA channel feeding TX FIFO */
+    int _dmaRx;   /** DMA channel draining RX FIFO */
+#endif
+
     /** Lastly executed program */
     int _exeProg;
 
@@ -362,8 +622,11 @@ protected:
     /** PIO clock dividers for w1 programs */
     uint _divs[PROGS_NUM];
 
-    /** Programs wrap addresses */
+    /** Programs wrap target addresses */
     uint _wraps[PROGS_NUM];
+
+    /** Programs wrap (top) addresses */
+    uint _wrapTops[PROGS_NUM];
 };
 
 #undef __SM_TOUCH
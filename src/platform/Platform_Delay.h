@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021,2022 Piotr Stolarz
+ * Copyright (c) 2021,2022,2026 Piotr Stolarz
  * OneWireNg: Arduino 1-wire service library
  *
  * Distributed under the 2-clause BSD License (the License)
@@ -15,18 +15,29 @@
 
 #include "platform/Platform_TimeCritical.h"
 
+/*
+ * timeMs() returns monotonic time in milliseconds, timeUs() in microseconds
+ * (both as unsigned long, which may wrap around).
+ */
 #ifdef ARDUINO
 # define delayMs(ms) delay(ms)
 # define _delayUs(us) delayMicroseconds(us)
+# define timeMs() millis()
+# define timeUs() micros()
 #elif defined(IDF_VER)
 # include "freertos/task.h"
+# include "esp_timer.h"
 void idf_delayUs(uint32_t us);
 # define delayMs(ms) vTaskDelay((ms) / portTICK_PERIOD_MS)
 # define _delayUs(us) idf_delayUs(us)
+# define timeMs() ((unsigned long)(esp_timer_get_time() / 1000))
+# define timeUs() ((unsigned long)esp_timer_get_time())
 #elif defined(PICO_BUILD)
 # include "pico/time.h"
 # define delayMs(ms) sleep_ms(ms)
 # define delayUs(us) sleep_us(us)
+# define timeMs() ((unsigned long)to_ms_since_boot(get_absolute_time()))
+# define timeUs() ((unsigned long)to_us_since_boot(get_absolute_time()))
 #elif defined(__MBED__)
 # ifndef NO_RTOS
 #  define delayMs(ms) rtos::ThisThread::sleep_for(ms * 1ms)
@@ -34,10 +45,30 @@ void idf_delayUs(uint32_t us);
 #  define delayMs(ms) wait_us(ms * 1000)
 # endif
 # define delayUs(us) wait_us(us)
+# define timeMs() ((unsigned long) \
+    std::chrono::duration_cast<std::chrono::milliseconds>( \
+        mbed::HighResClock::now().time_since_epoch()).count())
+# define timeUs() ((unsigned long) \
+    std::chrono::duration_cast<std::chrono::microseconds>( \
+        mbed::HighResClock::now().time_since_epoch()).count())
 #elif OWNG_TEST
+# include <time.h>
 # include <unistd.h>
 # define delayMs(ms) usleep(1000L * (ms))
 # define delayUs(us) usleep(us)
+static inline unsigned long timeMs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)ts.tv_sec * 1000UL + ts.tv_nsec / 1000000UL;
+}
+
+static inline unsigned long timeUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)ts.tv_sec * 1000000UL + ts.tv_nsec / 1000UL;
+}
 #else
 # error "Delay API unsupported for the target platform."
 #endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_PLATFORM_MUTEX__
+#define __OWNG_PLATFORM_MUTEX__
+/*
+ * The header defines platform agnostic (non-recursive) mutex class used to
+ * synchronize tasks sharing the library objects.
+ *
+ * On platforms with no threading support (e.g. Arduino AVR) the mutex is a
+ * no-op. Note, the mutex is not intended to synchronize with interrupt
+ * handlers, time critical sections (see Platform_TimeCritical.h) shall be
+ * used for this purpose.
+ */
+
+#include "OneWireNg_Config.h"
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(IDF_VER)
+# include "freertos/FreeRTOS.h"
+# include "freertos/semphr.h"
+
+class OneWireNg_Mutex
+{
+public:
+    OneWireNg_Mutex() {
+        _mtx = xSemaphoreCreateMutexStatic(&_buf);
+    }
+
+    ~OneWireNg_Mutex() {
+        vSemaphoreDelete(_mtx);
+    }
+
+    void lock() {
+        xSemaphoreTake(_mtx, portMAX_DELAY);
+    }
+
+    void unlock() {
+        xSemaphoreGive(_mtx);
+    }
+
+private:
+    SemaphoreHandle_t _mtx;
+    StaticSemaphore_t _buf;
+};
+#elif defined(PICO_BUILD)
+# include "pico/mutex.h"
+
+class OneWireNg_Mutex
+{
+public:
+    OneWireNg_Mutex() {
+        mutex_init(&_mtx);
+    }
+
+    void lock() {
+        mutex_enter_blocking(&_mtx);
+    }
+
+    void unlock() {
+        mutex_exit(&_mtx);
+    }
+
+private:
+    mutex_t _mtx;
+};
+#elif defined(__MBED__) && !defined(NO_RTOS)
+# include "mbed.h"
+
+class OneWireNg_Mutex
+{
+public:
+    void lock() {
+        _mtx.lock();
+    }
+
+    void unlock() {
+        _mtx.unlock();
+    }
+
+private:
+    rtos::Mutex _mtx;
+};
+#elif defined(OWNG_TEST) || defined(__linux__)
+# include <mutex>
+
+class OneWireNg_Mutex
+{
+public:
+    void lock() {
+        _mtx.lock();
+    }
+
+    void unlock() {
+        _mtx.unlock();
+    }
+
+private:
+    std::mutex _mtx;
+};
+#else
+/* no threading support */
+class OneWireNg_Mutex
+{
+public:
+    void lock() {}
+    void unlock() {}
+};
+#endif
+
+/**
+ * Scoped lock of a mutex.
+ */
+class OneWireNg_MutexLock
+{
+public:
+    OneWireNg_MutexLock(OneWireNg_Mutex& mtx): _mtx(mtx) {
+        _mtx.lock();
+    }
+
+    ~OneWireNg_MutexLock() {
+        _mtx.unlock();
+    }
+
+private:
+    OneWireNg_MutexLock(const OneWireNg_MutexLock&);
+    OneWireNg_MutexLock& operator=(const OneWireNg_MutexLock&);
+
+    OneWireNg_Mutex& _mtx;
+};
+
+#endif /* __OWNG_PLATFORM_MUTEX__ */
@@ -118,3 +118,43 @@ static inline pio_sm_config w1_touch1_program_get_default_config(uint offset) {
 }
 #endif
 
+
+// -------- //
+// w1_bytes //
+// -------- //
+
+#define w1_bytes_wrap_target 0
+#define w1_bytes_wrap 9
+
+#define w1_bytes_cycle 20
+#define w1_bytes_od_cycle 2
+
+static const uint16_t w1_bytes_program_instructions[] = {
+            //     .wrap_target
+    0x7021, //  0: out    x, 1            side 1     
+    0xe081, //  1: set    pindirs, 1      side 0     
+    0x0025, //  2: jmp    !x, 5           side 0     
+    0xe280, //  3: set    pindirs, 0      side 0 [2] 
+    0x0006, //  4: jmp    6               side 0     
+    0xa342, //  5: nop                    side 0 [3] 
+    0xaf40, //  6: mov    y, pins         side 0 [15]
+    0xa742, //  7: nop                    side 0 [7] 
+    0xf280, //  8: set    pindirs, 0      side 1 [2] 
+    0x5041, //  9: in     y, 1            side 1     
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program w1_bytes_program = {
+    .instructions = w1_bytes_program_instructions,
+    .length = 10,
+    .origin = -1,
+};
+
+static inline pio_sm_config w1_bytes_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + w1_bytes_wrap_target, offset + w1_bytes_wrap);
+    sm_config_set_sideset(&c, 1, false, false);
+    return c;
+}
+#endif
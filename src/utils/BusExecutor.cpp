@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "utils/BusExecutor.h"
+#include "platform/Platform_Delay.h"
+
+bool BusExecutor::Request::isCompatible(const Request& req) const
+{
+    if (_type != req._type)
+        return false;
+
+    switch (_type)
+    {
+    case TR_CONVERT_TEMP:
+        return (_u.conv.parasitic == req._u.conv.parasitic);
+
+    case TR_READ_SCRATCHPAD:
+        return !memcmp(_id, req._id, sizeof(OneWireNg::Id));
+
+    case TR_READ_MEMORY:
+        return (!memcmp(_id, req._id, sizeof(OneWireNg::Id)) &&
+            _u.mem.cmd == req._u.mem.cmd &&
+            _u.mem.addr == req._u.mem.addr &&
+            _u.mem.len == req._u.mem.len);
+
+    default:
+        return false;
+    }
+}
+
+/*
+ * Check if (subsequently processed) req may change state observed by
+ * this request.
+ */
+bool BusExecutor::Request::isConflicting(const Request& req) const
+{
+    /* custom transaction may do anything on the bus */
+    if (req._type == TR_CUSTOM)
+        return true;
+
+    return (req._type == TR_CONVERT_TEMP &&
+        (_type == TR_READ_SCRATCHPAD || _type == TR_READ_MEMORY));
+}
+
+OneWireNg::ErrorCode BusExecutor::submit(
+    Request& req, uint8_t prio, unsigned long deadline)
+{
+    OneWireNg_MutexLock lock(_qLock);
+
+    if (req._queued)
+        return OneWireNg::EC_FULL;
+
+    req._prio = prio;
+    req._hasDeadline = (deadline > 0);
+    req._deadline = timeMs() + deadline;
+    req._coalesced = false;
+    req._done = false;
+    req._queued = true;
+
+    Request **pp = &_head;
+    while (*pp && !isBefore(req, **pp))
+        pp = &(*pp)->_next;
+
+    req._next = *pp;
+    *pp = &req;
+
+    return OneWireNg::EC_SUCCESS;
+}
+
+/*
+ * Check if r1 shall be processed before (already queued) r2.
+ */
+bool BusExecutor::isBefore(const Request& r1, const Request& r2) const
+{
+    if (r1._prio != r2._prio)
+        return (r1._prio > r2._prio);
+
+    if (r1._hasDeadline != r2._hasDeadline)
+        return r1._hasDeadline;
+
+    /* deadlines compared with time wrap-around taken into account */
+    return (r1._hasDeadline && (long)(r1._deadline - r2._deadline) < 0);
+}
+
+size_t BusExecutor::process()
+{
+    Request *expired = NULL, **expTail = &expired;
+    Request *batch = NULL, **batchTail = &batch;
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+
+    {
+        /*
+         * The bus lock is held across the dequeue and the bus transaction,
+         * so concurrent process() calls can't reorder the transactions
+         * (e.g. a read dequeued behind a conversion performed before it).
+         */
+        OneWireNg_MutexLock busLock(_busLock);
+        {
+            OneWireNg_MutexLock lock(_qLock);
+            unsigned long now = timeMs();
+
+            /* expired requests */
+            for (Request **pp = &_head; *pp;) {
+                Request *req = *pp;
+                if (req->_hasDeadline && (long)(now - req->_deadline) > 0) {
+                    *pp = req->_next;
+                    req->_ec = OneWireNg::EC_TIMEOUT;
+                    *expTail = req;
+                    expTail = &req->_next;
+                } else {
+                    pp = &req->_next;
+                }
+            }
+            *expTail = NULL;
+
+            /* the highest priority request with its compatible requests */
+            if ((batch = _head) != NULL) {
+                _head = batch->_next;
+                batchTail = &batch->_next;
+
+                for (Request **pp = &_head; *pp;) {
+                    Request *req = *pp;
+                    if (batch->isCompatible(*req)) {
+                        *pp = req->_next;
+                        req->_coalesced = true;
+                        *batchTail = req;
+                        batchTail = &req->_next;
+                    } else
+                    if (batch->isConflicting(*req)) {
+                        /* requests behind need to see the conflicting one */
+                        break;
+                    } else {
+                        pp = &req->_next;
+                    }
+                }
+                *batchTail = NULL;
+            }
+        }
+
+        if (batch)
+            ec = perform(*batch, batch->_next != NULL);
+    }
+
+    size_t n = complete(expired);
+
+    if (batch)
+    {
+        for (Request *req = batch; req; req = req->_next)
+        {
+            req->_ec = ec;
+            if (req == batch || ec != OneWireNg::EC_SUCCESS)
+                continue;
+
+            /* pass the result to the coalesced requests */
+            if (req->_type == Request::TR_READ_SCRATCHPAD) {
+                new (req->_u.scrpd) DSTherm::Scratchpad(*batch->_u.scrpd);
+            } else
+            if (req->_type == Request::TR_READ_MEMORY) {
+                memcpy(req->_u.mem.buf, batch->_u.mem.buf, batch->_u.mem.len);
+            }
+        }
+        n += complete(batch);
+    }
+    return n;
+}
+
+OneWireNg::ErrorCode BusExecutor::perform(Request& req, bool coalesced)
+{
+#if CONFIG_DSTHERM_CACHE
+    DSTherm drv(_ow, _cache);
+#else
+    DSTherm drv(_ow);
+#endif
+
+    switch (req._type)
+    {
+    case Request::TR_CONVERT_TEMP:
+        if (req._allIds || coalesced) {
+            return drv.convertTempAll(
+                DSTherm::SCAN_BUS, req._u.conv.parasitic);
+        }
+        return drv.convertTemp(
+            req._id, DSTherm::SCAN_BUS, req._u.conv.parasitic);
+
+    case Request::TR_READ_SCRATCHPAD:
+        return drv.readScratchpad(req._id, req._u.scrpd);
+
+    case Request::TR_READ_MEMORY:
+      {
+        OneWireNg::ErrorCode ec = _ow.addressSingle(req._id);
+        if (ec == OneWireNg::EC_SUCCESS) {
+            uint8_t cmd[] = {
+                req._u.mem.cmd,
+                (uint8_t)(req._u.mem.addr & 0xff),
+                (uint8_t)(req._u.mem.addr >> 8)
+            };
+            _ow.writeBytes(cmd, sizeof(cmd));
+            _ow.readBytes(req._u.mem.buf, req._u.mem.len);
+        }
+        return ec;
+      }
+
+    case Request::TR_CUSTOM:
+        return req._u.cust.tr(_ow, req._u.cust.arg);
+
+    default:
+        return OneWireNg::EC_UNSUPPORED;
+    }
+}
+
+/*
+ * Complete list of requests. Callbacks are called with no locks held.
+ */
+size_t BusExecutor::complete(Request *reqs)
+{
+    size_t n = 0;
+
+    while (reqs) {
+        Request *req = reqs;
+        reqs = req->_next;
+
+        /* the request may be re-submitted as soon as marked as done */
+        Request::Callback cb = req->_cb;
+        void *arg = req->_arg;
+
+        req->_next = NULL;
+        req->_queued = false;
+        req->_done = true;
+
+        if (cb) cb(*req, arg);
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_BUS_EXECUTOR__
+#define __OWNG_BUS_EXECUTOR__
+
+#include "OneWireNg.h"
+#include "drivers/DSTherm.h"
+#include "platform/Platform_Mutex.h"
+
+/**
+ * Prioritized transactions executor for a 1-wire bus shared by a number of
+ * tasks.
+ *
+ * 1-wire service objects are not synchronized, therefore a bus shared by
+ * several tasks needs to be accessed in a serialized manner. The executor
+ * accepts bus transaction requests (@ref Request objects) submitted by
+ * the tasks via @ref submit() and performs them on the bus in @ref process()
+ * called by a task owning the bus (or by any of the sharing tasks - the bus
+ * access is serialized by the executor).
+ *
+ * Pending requests are ordered by their priorities, requests of the same
+ * priority by their deadlines (requests with no deadline at the end), and
+ * in the FIFO order at last. Request not started before its deadline is
+ * completed with @c EC_TIMEOUT status.
+ *
+ * Compatible pending requests are coalesced into a single bus transaction
+ * performed together with the request being processed (regardless of their
+ * priorities):
+ * - Temperature conversions (with the same parasitic powering mode) are
+ *   coalesced into single conversion for all sensors on the bus.
+ * - Scratchpad reads of the same sensor are coalesced into single read.
+ * - Memory reads of the same device (with the same command, address and
+ *   length) are coalesced into single read.
+ *
+ * A request is not coalesced across a pending request conflicting with it
+ * (a read is not coalesced across a conversion or custom transaction, any
+ * request is not coalesced across a custom transaction), so the coalesced
+ * request never observes the bus state from before the conflicting one.
+ *
+ * Requests' completion callbacks are called in the context of the task
+ * calling @ref process(), with no executor's locks held (therefore the
+ * callbacks may submit new requests).
+ *
+ * @note The bus shall not be used directly by the tasks while the executor
+ *     is in use. @ref Request::setCustom() may be used to perform arbitrary
+ *     bus transaction within the executor.
+ */
+class BusExecutor
+{
+public:
+    /**
+     * Bus transaction request.
+     */
+    class Request
+    {
+    public:
+        typedef enum
+        {
+            TR_NONE = 0,
+            TR_CONVERT_TEMP,    /** temperature conversion */
+            TR_READ_SCRATCHPAD, /** sensor's scratchpad read */
+            TR_READ_MEMORY,     /** device's memory read */
+            TR_CUSTOM           /** custom transaction */
+        } Type;
+
+        /**
+         * Request completion callback.
+         */
+        typedef void (*Callback)(Request& req, void *arg);
+
+        /**
+         * Custom transaction routine performed on the bus.
+         */
+        typedef OneWireNg::ErrorCode (*Transaction)(OneWireNg& ow, void *arg);
+
+        Request(): _type(TR_NONE), _cb(NULL), _arg(NULL), _next(NULL),
+            _queued(false), _done(true), _ec(OneWireNg::EC_SUCCESS) {}
+
+        /**
+         * Set temperature conversion request.
+         *
+         * @param id Sensor id or @c NULL for all sensors on the bus.
+         * @param parasitic If @c true the bus is powered during the
+         *     conversion time.
+         * @param cb Completion callback (may be @c NULL).
+         * @param arg Callback's argument.
+         *
+         * @note The conversion is performed with @ref DSTherm::SCAN_BUS
+         *     conversion time (the executor waits for the conversion
+         *     completion).
+         */
+        void setConvertTemp(const OneWireNg::Id *id, bool parasitic = false,
+            Callback cb = NULL, void *arg = NULL)
+        {
+            set(TR_CONVERT_TEMP, id, cb, arg);
+            _u.conv.parasitic = parasitic;
+        }
+
+        /**
+         * Set scratchpad read request.
+         *
+         * @param id Sensor id.
+         * @param scratchpad Memory region where @c DSTherm::Scratchpad
+         *     object will be created in-place (see @ref
+         *     DSTherm::readScratchpad()). The region must be valid until
+         *     the request completes.
+         * @param cb Completion callback (may be @c NULL).
+         * @param arg Callback's argument.
+         */
+        void setReadScratchpad(const OneWireNg::Id& id,
+            DSTherm::Scratchpad *scratchpad, Callback cb = NULL,
+            void *arg = NULL)
+        {
+            set(TR_READ_SCRATCHPAD, &id, cb, arg);
+            _u.scrpd = scratchpad;
+        }
+
+        /**
+         * Set memory read request. The device is addressed and sent
+         * @c cmd followed by 2 bytes of the @c addr (LSB first), next
+         * @c len bytes are read. Most of 1-wire memory devices support
+         * this scheme by their "Read Memory" command (0xf0).
+         *
+         * @param id Device id.
+         * @param cmd Read command.
+         * @param addr Memory address.
+         * @param buf Buffer for the read bytes (must be valid until the
+         *     request completes).
+         * @param len Number of bytes to read.
+         * @param cb Completion callback (may be @c NULL).
+         * @param arg Callback's argument.
+         */
+        void setReadMemory(const OneWireNg::Id& id, uint8_t cmd,
+            uint16_t addr, uint8_t *buf, size_t len, Callback cb = NULL,
+            void *arg = NULL)
+        {
+            set(TR_READ_MEMORY, &id, cb, arg);
+            _u.mem.cmd = cmd;
+            _u.mem.addr = addr;
+            _u.mem.buf = buf;
+            _u.mem.len = len;
+        }
+
+        /**
+         * Set custom transaction request. Custom transactions are never
+         * coalesced.
+         *
+         * @param tr Transaction routine.
+         * @param trArg Transaction routine's argument.
+         * @param cb Completion callback (may be @c NULL).
+         * @param arg Callback's argument.
+         */
+        void setCustom(Transaction tr, void *trArg, Callback cb = NULL,
+            void *arg = NULL)
+        {
+            set(TR_CUSTOM, NULL, cb, arg);
+            _u.cust.tr = tr;
+            _u.cust.arg = trArg;
+        }
+
+        Type getType() const {
+            return _type;
+        }
+
+        /**
+         * Check if the request has been completed.
+         */
+        bool isDone() const {
+            return _done;
+        }
+
+        /**
+         * Check if the request has been completed as a part of a bus
+         * transaction performed for another request.
+         */
+        bool isCoalesced() const {
+            return _coalesced;
+        }
+
+        /**
+         * Get completed request status:
+         * - @c EC_TIMEOUT: Request's deadline passed before the request has
+         *   been started.
+         * - Otherwise: Status of the performed transaction.
+         */
+        OneWireNg::ErrorCode getStatus() const {
+            return _ec;
+        }
+
+    private:
+        void set(Type type, const OneWireNg::Id *id, Callback cb, void *arg)
+        {
+            _type = type;
+            _allIds = (id == NULL);
+            if (id) memcpy(_id, *id, sizeof(OneWireNg::Id));
+            _cb = cb;
+            _arg = arg;
+        }
+
+        bool isCompatible(const Request& req) const;
+        bool isConflicting(const Request& req) const;
+
+        Type _type;
+        OneWireNg::Id _id;
+        bool _allIds;
+        Callback _cb;
+        void *_arg;
+
+        union {
+            struct {
+                bool parasitic;
+            } conv;
+            DSTherm::Scratchpad *scrpd;
+            struct {
+                uint8_t cmd;
+                uint16_t addr;
+                uint8_t *buf;
+                size_t len;
+            } mem;
+            struct {
+                Transaction tr;
+                void *arg;
+            } cust;
+        } _u;
+
+        uint8_t _prio;
+        bool _hasDeadline;
+        unsigned long _deadline;
+        bool _coalesced;
+
+        Request *_next;
+        volatile bool _queued;
+        volatile bool _done;
+        OneWireNg::ErrorCode _ec;
+
+    friend class BusExecutor;
+    };
+
+    /**
+     * Executor constructor.
+     *
+     * @param ow 1-wire service of the shared bus.
+     */
+    BusExecutor(OneWireNg& ow): _ow(ow), _head(NULL)
+#if CONFIG_DSTHERM_CACHE
+        , _cache(NULL)
+#endif
+    {}
+
+#if CONFIG_DSTHERM_CACHE
+    /**
+     * Executor constructor with sensors parameters cache.
+     *
+     * @param ow 1-wire service of the shared bus.
+     * @param cache Sensors parameters cache used by @c DSTherm driver
+     *     performing temperature related requests (may be @c NULL).
+     */
+    BusExecutor(OneWireNg& ow, DSTherm::Cache *cache):
+        _ow(ow), _head(NULL), _cache(cache) {}
+#endif
+
+    /**
+     * Submit a request.
+     *
+     * @param req The request.
+     * @param prio Request priority (higher value - higher priority).
+     * @param deadline Time (in milliseconds, relative to the submission
+     *     time) the request shall be started in. 0: no deadline.
+     *
+     * @return Error codes:
+     *     - @c EC_SUCCESS: Request queued.
+     *     - @c EC_FULL: The request is already queued.
+     */
+    OneWireNg::ErrorCode submit(Request& req, uint8_t prio = 0,
+        unsigned long deadline = 0);
+
+    /**
+     * Process the highest priority pending request (with compatible pending
+     * requests coalesced to it). Requests with passed deadlines are
+     * completed with @c EC_TIMEOUT.
+     *
+     * @return Number of completed requests. 0 if there are no pending
+     *     requests.
+     */
+    size_t process();
+
+    /**
+     * Process all pending requests.
+     *
+     * @return Number of completed requests.
+     */
+    size_t processAll()
+    {
+        size_t n = 0, p;
+        while ((p = process()) > 0) n += p;
+        return n;
+    }
+
+    /**
+     * Check if there are no pending requests.
+     */
+    bool isIdle() const {
+        return !_head;
+    }
+
+private:
+    bool isBefore(const Request& r1, const Request& r2) const;
+    OneWireNg::ErrorCode perform(Request& req, bool coalesced);
+    size_t complete(Request *reqs);
+
+    OneWireNg& _ow;
+
+    OneWireNg_Mutex _qLock;     /** requests queue lock */
+    OneWireNg_Mutex _busLock;   /** bus access lock */
+    Request *_head;             /** pending requests queue */
+#if CONFIG_DSTHERM_CACHE
+    DSTherm::Cache *_cache;
+#endif
+
+#ifdef OWNG_TEST
+friend class BusExecutor_Test;
+#endif
+};
+
+#endif /* __OWNG_BUS_EXECUTOR__ */
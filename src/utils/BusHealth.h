@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_BUS_HEALTH__
+#define __OWNG_BUS_HEALTH__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "OneWireNg_BitBang.h"
+
+/**
+ * Presence-only health sweep across a set of 1-wire buses.
+ *
+ * Buses (already existing 1-wire service objects, e.g. @c
+ * OneWireNg_CurrentPlatform or @c OneWireNg_PicoRP2040PIO) are registered
+ * by @ref add() and swept by @ref sweep(), which performs a reset (presence
+ * detect) on each of them. Bus states are reported as compact bitmaps (bus
+ * index is the bit position):
+ * - present: presence pulse detected,
+ * - shorted: the bus held low,
+ * - no devices: none of the above.
+ *
+ * Bit-banged buses (@c OneWireNg_BitBang derivatives) are reset at once
+ * with overlapped reset pulses and a single presence detection window (see
+ * @ref OneWireNg_BitBang::resetAll()), their presence pulse timing is
+ * measured and the shorted bus is detected by the measurement. Other buses
+ * are reset one by one, the shorted bus is detected by a read slot issued
+ * after the presence pulse detection (no slave device pulls the bus low in
+ * this slot).
+ *
+ * The sweep cost is bound by a single reset time for all bit-banged buses
+ * in the standard mode plus the reset time (about 1 msec in the standard,
+ * 0.15 msec in the overdrive mode) per each other bus. Note the presence
+ * pulse timing resolution of the bit-banged buses degrades with their
+ * number (see @ref OneWireNg_BitBang::resetAll()).
+ *
+ * @note Sweeping a bus interrupts any 1-wire activity in progress on it
+ *     (including parasite powering of the bus).
+ *
+ * @tparam N Max number of registered buses (up to 32).
+ */
+template<size_t N = 32>
+class BusHealth
+{
+#if __cplusplus >= 201103L
+    static_assert(N > 0 && N <= 32, "Invalid number of buses");
+#endif
+
+public:
+    typedef enum
+    {
+        BUS_PRESENT = 0,    /** presence pulse detected */
+        BUS_NO_DEVS,        /** no slave devices */
+        BUS_SHORTED         /** bus held low */
+    } State;
+
+    BusHealth(): _n(0), _present(0), _shorted(0) {}
+
+    /**
+     * Register a bus. The bus index (as used by other methods) is the number
+     * of already registered buses.
+     *
+     * @return @c EC_SUCCESS on success, @c EC_FULL if no space.
+     */
+    OneWireNg::ErrorCode add(OneWireNg& bus) {
+        return add(&bus, NULL);
+    }
+
+    /**
+     * Register a bit-banged bus (presence pulse timing is measured for the
+     * bus).
+     *
+     * @see add(OneWireNg&)
+     */
+    OneWireNg::ErrorCode add(OneWireNg_BitBang& bus) {
+        return add(&bus, &bus);
+    }
+
+    /**
+     * Sweep all the registered buses.
+     *
+     * @return Bitmap of buses with presence pulse detected.
+     */
+    uint32_t sweep()
+    {
+        OneWireNg::ErrorCode ecs[N];
+
+        _present = _shorted = 0;
+
+        /* bit-banged buses reset at once */
+        OneWireNg_BitBang::resetAll(_bb, _tm, ecs, _n);
+
+        for (size_t i = 0; i < _n; i++)
+        {
+            OneWireNg::ErrorCode ec;
+
+            /* reset result is set by resetAll() for bit-banged buses only */
+            if (_bb[i]) {
+                ec = ecs[i];
+            } else {
+                ec = _ow[i]->reset();
+                if (ec == OneWireNg::EC_SUCCESS && !_ow[i]->touchBit(1))
+                    ec = OneWireNg::EC_BUS_ERROR;
+            }
+
+            if (ec == OneWireNg::EC_SUCCESS)
+                _present |= (uint32_t)1 << i;
+            else
+            if (ec == OneWireNg::EC_BUS_ERROR)
+                _shorted |= (uint32_t)1 << i;
+        }
+        return _present;
+    }
+
+    /**
+     * Get bitmap of buses with presence pulse detected by the last sweep.
+     */
+    uint32_t getPresent() const {
+        return _present;
+    }
+
+    /**
+     * Get bitmap of buses detected as shorted by the last sweep.
+     */
+    uint32_t getShorted() const {
+        return _shorted;
+    }
+
+    /**
+     * Get bitmap of buses with no devices detected by the last sweep.
+     */
+    uint32_t getNoDevs() const {
+        return getBuses() & ~(_present | _shorted);
+    }
+
+    /**
+     * Get bitmap of all registered buses.
+     */
+    uint32_t getBuses() const {
+        return (_n >= 32 ? ~(uint32_t)0 : (((uint32_t)1 << _n) - 1));
+    }
+
+    /**
+     * Get state of a bus detected by the last sweep.
+     */
+    State getState(size_t i) const
+    {
+        uint32_t bm = (uint32_t)1 << i;
+        return ((_present & bm) ? BUS_PRESENT :
+            ((_shorted & bm) ? BUS_SHORTED : BUS_NO_DEVS));
+    }
+
+    /**
+     * Get presence pulse timing of a bus measured by the last sweep.
+     *
+     * @return Pointer to the timing or @c NULL if the timing is not
+     *     measured for the bus (not a bit-banged bus).
+     */
+    const OneWireNg_BitBang::PresenceTiming *getTiming(size_t i) const {
+        return (_bb[i] ? &_tm[i] : NULL);
+    }
+
+private:
+    OneWireNg::ErrorCode add(OneWireNg *ow, OneWireNg_BitBang *bb)
+    {
+        if (_n >= N)
+            return OneWireNg::EC_FULL;
+
+        _ow[_n] = ow;
+        _bb[_n] = bb;
+        _tm[_n].start = _tm[_n].length = 0;
+        _n++;
+        return OneWireNg::EC_SUCCESS;
+    }
+
+    OneWireNg *_ow[N];
+    OneWireNg_BitBang *_bb[N];      /** NULL for not bit-banged bus */
+    OneWireNg_BitBang::PresenceTiming _tm[N];
+
+    size_t _n;          /** number of registered buses */
+    uint32_t _present;  /** buses with presence pulse detected */
+    uint32_t _shorted;  /** shorted buses */
+};
+
+#endif /* __OWNG_BUS_HEALTH__ */
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "utils/IButtonReader.h"
+
+unsigned long IButtonReader::poll(unsigned long now)
+{
+    _stats.polls++;
+
+    switch (_state)
+    {
+    case ST_IDLE:
+        if (reset() != OneWireNg::EC_SUCCESS)
+            return backoff();
+
+        _state = ST_DEBOUNCE;
+        _cnt = _miss = 0;
+        return debounce(now, true);
+
+    case ST_DEBOUNCE:
+        return debounce(now, reset() == OneWireNg::EC_SUCCESS);
+
+    case ST_PRESENT:
+    default:
+        if (reset() == OneWireNg::EC_SUCCESS) {
+            _miss = 0;
+            return _maxInterval;
+        }
+        if (++_miss < _debounce)
+            return _minInterval;
+
+        removed(now);
+        return _interval;
+    }
+}
+
+unsigned long IButtonReader::backoff()
+{
+    unsigned long ret = _interval;
+
+    _interval = (_interval < _maxInterval / 2 ? 2 * _interval : _maxInterval);
+    return ret;
+}
+
+unsigned long IButtonReader::debounce(unsigned long now, bool present)
+{
+    OneWireNg::Id id;
+
+    /* the id is read just after the presence detection */
+    if (present && readId(id) == OneWireNg::EC_SUCCESS)
+    {
+        _miss = 0;
+        if (_cnt > 0 && !memcmp(id, _cand, sizeof(OneWireNg::Id))) {
+            _cnt++;
+        } else {
+            memcpy(_cand, id, sizeof(OneWireNg::Id));
+            _touchTime = now;
+            _cnt = 1;
+        }
+
+        if (_cnt >= _debounce) {
+            confirmed(now);
+            return _maxInterval;
+        }
+    } else {
+        _cnt = 0;
+        if (++_miss >= _debounce) {
+            /* bounce or contact too short */
+            _state = ST_IDLE;
+            _interval = _minInterval;
+        }
+    }
+    return _minInterval;
+}
+
+void IButtonReader::confirmed(unsigned long now)
+{
+    bool dup = (_hasLast && _dupWindow &&
+        !memcmp(_cand, _last, sizeof(OneWireNg::Id)) &&
+        (unsigned long)(now - _removeTime) < _dupWindow);
+
+    _state = ST_PRESENT;
+    _miss = 0;
+    memcpy(_last, _cand, sizeof(OneWireNg::Id));
+    _hasLast = true;
+
+    if (dup) {
+        _stats.duplicates++;
+    } else {
+        _stats.touches++;
+        _stats.confirmLatency = now - _touchTime;
+        if (_stats.confirmLatency > _stats.maxConfirmLatency)
+            _stats.maxConfirmLatency = _stats.confirmLatency;
+
+        if (_cb)
+            _cb(_last, _arg);
+    }
+
+#if CONFIG_OVERDRIVE_ENABLED
+    if (_useOd)
+    {
+        OneWireNg::Id id;
+
+        /* Skip ROM Overdrive (standard speed reset) */
+        _stats.resets++;
+        _stats.estBusTime += RESET_TIME_US + 8 * SLOT_TIME_US;
+
+        if (_ow.overdriveAll() == OneWireNg::EC_SUCCESS) {
+            /* verify the iButton responds in the overdrive */
+            _od = true;
+            _od = (reset() == OneWireNg::EC_SUCCESS &&
+                readId(id) == OneWireNg::EC_SUCCESS &&
+                !memcmp(id, _last, sizeof(OneWireNg::Id)));
+        }
+
+        if (!_od) {
+            /* standard speed reset restores the iButton speed */
+            _ow.setOverdrive(false);
+            reset();
+        }
+    }
+#endif
+}
+
+void IButtonReader::removed(unsigned long now)
+{
+    _state = ST_IDLE;
+    _removeTime = now;
+    _interval = _minInterval;
+    _cnt = _miss = 0;
+
+#if CONFIG_OVERDRIVE_ENABLED
+    if (_od) {
+        _ow.setOverdrive(false);
+        _od = false;
+    }
+#endif
+}
+
+OneWireNg::ErrorCode IButtonReader::reset()
+{
+    _stats.resets++;
+#if CONFIG_OVERDRIVE_ENABLED
+    if (_od) {
+        _stats.estBusTime += RESET_TIME_OD_US;
+    } else
+#endif
+    {
+        _stats.estBusTime += RESET_TIME_US;
+    }
+    return _ow.reset();
+}
+
+OneWireNg::ErrorCode IButtonReader::readId(OneWireNg::Id& id)
+{
+    _stats.reads++;
+#if CONFIG_OVERDRIVE_ENABLED
+    if (_od) {
+        _stats.estBusTime += (8 + 64) * SLOT_TIME_OD_US;
+    } else
+#endif
+    {
+        _stats.estBusTime += (8 + 64) * SLOT_TIME_US;
+    }
+
+    /* "Read ROM" on the already reset bus */
+    _ow.writeByte(OneWireNg::CMD_READ_ROM);
+    _ow.readBytes(&id[0], sizeof(OneWireNg::Id));
+
+    /* all zeros (e.g. bus held low) pass the CRC check */
+    if (!id[0])
+        return OneWireNg::EC_CRC_ERROR;
+    return OneWireNg::checkCrcId(id);
+}
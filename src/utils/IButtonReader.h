@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_IBUTTON_READER__
+#define __OWNG_IBUTTON_READER__
+
+#include <string.h>  /* memset */
+#include "OneWireNg.h"
+#include "platform/Platform_Delay.h"
+
+/**
+ * iButton (e.g. DS1990) touch reader.
+ *
+ * The reader polls the touch probe (1-wire bus with at most one iButton
+ * in contact) for presence of an iButton by @ref poll(), which shall be
+ * called in the time returned by its previous call. The poll performs
+ * a single reset (presence detect) in most cases, followed by an id read
+ * while debouncing a touch. The poll confirming a touch with the overdrive
+ * enabled blocks longer: a reset with Skip ROM Overdrive, an overdrive reset
+ * with an id read verifying the switch and, if the iButton doesn't support
+ * the overdrive, a standard speed reset restoring its speed.
+ *
+ * - With no iButton in contact, the polling interval backs off from the
+ *   min to the max interval (see @ref setPolling()) doubling on each poll.
+ * - On presence detection the id is read with no additional reset. The
+ *   touch is confirmed (debounced) after a configured number of consecutive
+ *   identical id reads, polled with the min interval.
+ * - Confirmed iButton id is reported via the touch callback, unless the
+ *   same iButton has been removed within the duplicate suppression window.
+ * - iButton in contact is polled by resets with the max interval. If
+ *   overdrive is enabled (see @ref setOverdrive()) and supported by the
+ *   iButton, it's switched into the overdrive mode and polled by short
+ *   overdrive resets. iButton is considered removed after a number of
+ *   consecutive missed presence pulses (the same as for the debouncing).
+ *
+ * Example:
+ *
+ * @code
+ * void touched(const OneWireNg::Id& id, void *arg) {
+ *     // handle the touch
+ * }
+ *
+ * IButtonReader reader(ow, touched);
+ *
+ * for (;;) {
+ *     delayMs(reader.poll());
+ * }
+ * @endcode
+ */
+class IButtonReader
+{
+public:
+    /** Default min, max polling intervals (ms) */
+    const static unsigned long MIN_INTERVAL = 5;
+    const static unsigned long MAX_INTERVAL = 50;
+
+    /** Default number of consecutive reads confirming a touch */
+    const static int DEBOUNCE = 2;
+
+    /** Default duplicate suppression window (ms) */
+    const static unsigned long DUP_WINDOW = 1000;
+
+    /** Estimated bus time of reset and a bit slot (us) */
+    const static unsigned RESET_TIME_US = 960;
+    const static unsigned SLOT_TIME_US = 65;
+#if CONFIG_OVERDRIVE_ENABLED
+    const static unsigned RESET_TIME_OD_US = 120;
+    const static unsigned SLOT_TIME_OD_US = 10;
+#endif
+
+    /**
+     * Touch callback.
+     *
+     * @param id Touched iButton id.
+     * @param arg User argument.
+     */
+    typedef void (*Callback)(const OneWireNg::Id& id, void *arg);
+
+    /**
+     * Reader statistics.
+     */
+    typedef struct
+    {
+        /** Number of polls */
+        unsigned long polls;
+        /** Number of resets */
+        unsigned long resets;
+        /** Number of id reads */
+        unsigned long reads;
+        /**
+         * Bus time consumed by the polls (us), estimated from the nominal
+         * reset and slot times (see @ref RESET_TIME_US, @ref SLOT_TIME_US)
+         */
+        unsigned long estBusTime;
+        /** Number of reported touches */
+        unsigned long touches;
+        /** Number of suppressed duplicated touches */
+        unsigned long duplicates;
+        /**
+         * Last touch confirmation latency: 1st read of the confirmed id to
+         * its report (ms). The delay from the contact to its detection
+         * (up to the idle polling interval) is not included.
+         */
+        unsigned long confirmLatency;
+        /** Max touch confirmation latency (ms) */
+        unsigned long maxConfirmLatency;
+    } Stats;
+
+    /**
+     * Reader constructor.
+     *
+     * @param ow 1-wire service of the touch probe.
+     * @param cb Touch callback.
+     * @param arg Callback's argument.
+     */
+    IButtonReader(OneWireNg& ow, Callback cb, void *arg = NULL):
+        _ow(ow), _cb(cb), _arg(arg),
+        _minInterval(MIN_INTERVAL), _maxInterval(MAX_INTERVAL),
+        _debounce(DEBOUNCE), _dupWindow(DUP_WINDOW),
+#if CONFIG_OVERDRIVE_ENABLED
+        _useOd(false), _od(false),
+#endif
+        _state(ST_IDLE), _interval(MIN_INTERVAL), _cnt(0), _miss(0),
+        _hasLast(false)
+    {
+        resetStats();
+    }
+
+    /**
+     * Set polling intervals (ms).
+     *
+     * @param minInterval Polling interval just after contact loss and while
+     *     debouncing.
+     * @param maxInterval Max polling interval with no iButton in contact
+     *     and polling interval of iButton in contact.
+     */
+    void setPolling(unsigned long minInterval, unsigned long maxInterval)
+    {
+        _minInterval = (minInterval > 0 ? minInterval : 1);
+        _maxInterval =
+            (maxInterval > _minInterval ? maxInterval : _minInterval);
+        _interval = _minInterval;
+    }
+
+    /**
+     * Set number of consecutive identical id reads confirming a touch
+     * (and missed presence pulses confirming removal).
+     */
+    void setDebounce(int n) {
+        _debounce = (n > 0 ? n : 1);
+    }
+
+    /**
+     * Set duplicate suppression window (ms). Touch of an iButton removed
+     * within the window is not reported (0 disables the suppression).
+     */
+    void setDupWindow(unsigned long ms) {
+        _dupWindow = ms;
+    }
+
+#if CONFIG_OVERDRIVE_ENABLED
+    /**
+     * Enable polling of iButton in contact in the overdrive mode (if
+     * supported by the iButton).
+     */
+    void setOverdrive(bool on) {
+        _useOd = on;
+    }
+#endif
+
+    /**
+     * Poll the touch probe.
+     *
+     * @param now Current time (ms).
+     *
+     * @return Time (ms) to the next poll.
+     */
+    unsigned long poll(unsigned long now);
+
+    /**
+     * Poll the touch probe.
+     *
+     * @see poll(unsigned long)
+     */
+    unsigned long poll() {
+        return poll(timeMs());
+    }
+
+    /**
+     * Check if an iButton is in contact (confirmed touch).
+     */
+    bool isPresent() const {
+        return (_state == ST_PRESENT);
+    }
+
+    /**
+     * Get id of the last confirmed iButton.
+     */
+    const OneWireNg::Id& getId() const {
+        return _last;
+    }
+
+    const Stats& getStats() const {
+        return _stats;
+    }
+
+    void resetStats() {
+        memset(&_stats, 0, sizeof(_stats));
+    }
+
+private:
+    typedef enum
+    {
+        ST_IDLE = 0,    /** no iButton in contact */
+        ST_DEBOUNCE,    /** confirming touch */
+        ST_PRESENT      /** iButton in contact */
+    } State;
+
+    OneWireNg::ErrorCode reset();
+    OneWireNg::ErrorCode readId(OneWireNg::Id& id);
+    unsigned long debounce(unsigned long now, bool present);
+    unsigned long backoff();
+    void confirmed(unsigned long now);
+    void removed(unsigned long now);
+
+    OneWireNg& _ow;
+    Callback _cb;
+    void *_arg;
+
+    unsigned long _minInterval;
+    unsigned long _maxInterval;
+    int _debounce;
+    unsigned long _dupWindow;
+#if CONFIG_OVERDRIVE_ENABLED
+    bool _useOd;
+    bool _od;                   /** iButton in contact polled in overdrive */
+#endif
+
+    State _state;
+    unsigned long _interval;    /** current idle polling interval */
+    int _cnt;                   /** consecutive identical reads */
+    int _miss;                  /** consecutive missed presence pulses */
+    unsigned long _touchTime;   /** 1st read time of the candidate id */
+    unsigned long _removeTime;  /** last iButton removal time */
+    OneWireNg::Id _cand;        /** id being confirmed */
+    OneWireNg::Id _last;        /** last confirmed id */
+    bool _hasLast;
+
+    Stats _stats;
+};
+
+#endif /* __OWNG_IBUTTON_READER__ */
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#include "utils/MicroLan.h"
+#include "utils/Placeholder.h"
+#include "platform/Platform_Delay.h"
+
+OneWireNg::ErrorCode MicroLan::add(
+    const OneWireNg::Id& id, int coupler, DS2409::Branch branch)
+{
+    /* couplers on the trunk only (nested couplers are not supported) */
+    if (coupler != TRUNK && (coupler < 0 || (size_t)coupler >= _n ||
+        _entries[coupler].id[0] != DS2409::FAMILY_CODE ||
+        _entries[coupler].coupler != TRUNK))
+    {
+        return OneWireNg::EC_UNSUPPORED;
+    }
+    if (_n >= _max)
+        return OneWireNg::EC_FULL;
+
+    Entry& e = _entries[_n++];
+    memcpy(e.id, id, sizeof(OneWireNg::Id));
+    e.coupler = coupler;
+    e.branch = (uint8_t)(coupler == TRUNK ? 0 : branch);
+    return OneWireNg::EC_SUCCESS;
+}
+
+#if CONFIG_SEARCH_ENABLED
+OneWireNg::ErrorCode MicroLan::discover()
+{
+    _n = 0;
+
+    /* no confirmation (bus error) if there are no couplers */
+    allLinesOff();
+
+    OneWireNg::ErrorCode ec = searchBranch(TRUNK, 0);
+    size_t nTrunk = _n;
+
+    for (size_t c = 0; ec == OneWireNg::EC_SUCCESS && c < nTrunk; c++)
+    {
+        if (_entries[c].id[0] != DS2409::FAMILY_CODE)
+            continue;
+
+        for (uint8_t br = DS2409::BRANCH_MAIN; br <= DS2409::BRANCH_AUX; br++)
+        {
+            /* nothing to search for on a branch with no presence */
+            if (activate((int)c, br) == OneWireNg::EC_SUCCESS) {
+                ec = searchBranch((int)c, br);
+                if (ec != OneWireNg::EC_SUCCESS)
+                    break;
+            }
+        }
+
+        /* don't let the branch devices be found behind the next coupler */
+        if (_active != TRUNK) {
+            _coupler.allLinesOff(_entries[c].id);
+            _stats.linesOff++;
+            _active = TRUNK;
+        }
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode MicroLan::searchBranch(int coupler, uint8_t branch)
+{
+    OneWireNg::ErrorCode ec;
+    OneWireNg::Id id;
+
+    _ow.searchReset();
+    while ((ec = _ow.search(id)) == OneWireNg::EC_MORE)
+    {
+        /* trunk devices are found on each branch */
+        if (find(id) >= 0)
+            continue;
+
+        ec = add(id, coupler, (DS2409::Branch)branch);
+        if (ec != OneWireNg::EC_SUCCESS)
+            return ec;
+    }
+    return (ec == OneWireNg::EC_NO_DEVS ? OneWireNg::EC_SUCCESS : ec);
+}
+#endif
+
+OneWireNg::ErrorCode MicroLan::allLinesOff()
+{
+    _active = TRUNK;
+    _stats.linesOff++;
+    return _coupler.allLinesOffAll();
+}
+
+OneWireNg::ErrorCode MicroLan::forEach(
+    Visitor visitor, void *arg, uint8_t family)
+{
+    OneWireNg::ErrorCode ec = OneWireNg::EC_SUCCESS;
+    int active = _active;
+    uint8_t activeBranch = _activeBranch;
+
+    if (!visitGroup(TRUNK, 0, visitor, arg, family, ec))
+        return ec;
+
+    /* connected branch first, no switching needed */
+    if (active != TRUNK &&
+        !visitGroup(active, activeBranch, visitor, arg, family, ec))
+    {
+        return ec;
+    }
+
+    for (size_t i = 0; i < _n; i++)
+    {
+        const Entry& e = _entries[i];
+
+        if (e.coupler == TRUNK || !isGroupStart(i) ||
+            (e.coupler == active && e.branch == activeBranch))
+        {
+            continue;
+        }
+        if (!visitGroup(e.coupler, e.branch, visitor, arg, family, ec))
+            break;
+    }
+    return ec;
+}
+
+OneWireNg::ErrorCode MicroLan::readTempAll(DSTherm& dsth,
+    DSTherm::ReadingSink& sink, int convTime, bool parasitic, size_t *n)
+{
+    struct {
+        int coupler;
+        uint8_t branch;
+        unsigned long start;
+    } grp[CONV_ROUND];
+
+    OneWireNg::ErrorCode ret = OneWireNg::EC_SUCCESS;
+    bool dropped = false;
+    bool started = false;
+    unsigned long lastStart = 0;
+    size_t i = 0;
+
+    if (convTime <= 0)
+        convTime = DSTherm::MAX_CONV_TIME;
+    if (n) *n = 0;
+
+    while (i < _n)
+    {
+        size_t ng = 0;
+
+        /* start conversions on a round of branches */
+        for (; i < _n && ng < CONV_ROUND; i++)
+        {
+            const Entry& e = _entries[i];
+
+            if (e.coupler == TRUNK || !isGroupStart(i) ||
+                !hasTherm(e.coupler, e.branch))
+            {
+                continue;
+            }
+
+            OneWireNg::ErrorCode ec = activate(e.coupler, e.branch);
+            if (ec != OneWireNg::EC_SUCCESS) {
+                ret = ec;
+                continue;
+            }
+
+            lastStart = timeMs();
+            started = true;
+
+            if (parasitic) {
+                /* the branch needs to be powered during the conversion */
+                dsth.convertTempAll(convTime, true);
+                readGroup(dsth, e.coupler, e.branch, sink, n, dropped);
+            } else {
+                dsth.convertTempAll(0);
+                grp[ng].coupler = e.coupler;
+                grp[ng].branch = e.branch;
+                grp[ng].start = lastStart;
+                ng++;
+            }
+        }
+
+        /* read the round in the conversions order */
+        for (size_t k = 0; k < ng; k++)
+        {
+            long wait = (long)(grp[k].start + convTime - timeMs());
+            if (wait > 0)
+                delayMs(wait);
+
+            OneWireNg::ErrorCode ec = activate(grp[k].coupler, grp[k].branch);
+            if (ec != OneWireNg::EC_SUCCESS) {
+                ret = ec;
+                continue;
+            }
+            readGroup(dsth, grp[k].coupler, grp[k].branch, sink, n, dropped);
+        }
+    }
+
+    if (hasTherm(TRUNK, 0))
+    {
+        if (!started) {
+            dsth.convertTempAll(convTime, parasitic);
+        } else {
+            /* trunk converted along with the last started branch */
+            long wait = (long)(lastStart + convTime - timeMs());
+            if (wait > 0)
+                delayMs(wait);
+        }
+        readGroup(dsth, TRUNK, 0, sink, n, dropped);
+    }
+
+    if (ret == OneWireNg::EC_SUCCESS && dropped)
+        ret = OneWireNg::EC_FULL;
+    return ret;
+}
+
+int MicroLan::find(const OneWireNg::Id& id) const
+{
+    for (size_t i = 0; i < _n; i++) {
+        if (!memcmp(_entries[i].id, id, sizeof(OneWireNg::Id)))
+            return (int)i;
+    }
+    return -1;
+}
+
+OneWireNg::ErrorCode MicroLan::activate(int coupler, uint8_t branch)
+{
+    if (coupler == TRUNK ||
+        (coupler == _active && branch == _activeBranch))
+    {
+        return OneWireNg::EC_SUCCESS;
+    }
+
+    /* smart-on disconnects the other branch of the same coupler only */
+    if (_active != TRUNK && _active != coupler) {
+        _coupler.allLinesOff(_entries[_active].id);
+        _stats.linesOff++;
+    }
+
+    OneWireNg::ErrorCode ec = _coupler.smartOn(
+        _entries[coupler].id, (DS2409::Branch)branch);
+    _stats.switches++;
+
+    /* with no presence detected the branch is connected anyway */
+    if (ec == OneWireNg::EC_SUCCESS || ec == OneWireNg::EC_NO_DEVS) {
+        _active = coupler;
+        _activeBranch = branch;
+    } else {
+        _active = TRUNK;
+    }
+    return ec;
+}
+
+bool MicroLan::isGroupStart(size_t i) const
+{
+    for (size_t j = 0; j < i; j++) {
+        if (inGroup(j, _entries[i].coupler, _entries[i].branch))
+            return false;
+    }
+    return true;
+}
+
+bool MicroLan::visitGroup(int coupler, uint8_t branch, Visitor visitor,
+    void *arg, uint8_t family, OneWireNg::ErrorCode& ec)
+{
+    bool connected = false;
+
+    for (size_t i = 0; i < _n; i++)
+    {
+        const Entry& e = _entries[i];
+
+        if (!inGroup(i, coupler, branch) || (family && e.id[0] != family))
+            continue;
+
+        /* connect the branch lazily, only if there is something to visit */
+        if (!connected) {
+            OneWireNg::ErrorCode aec = activate(coupler, branch);
+            if (aec != OneWireNg::EC_SUCCESS) {
+                ec = aec;
+                return true;
+            }
+            connected = true;
+        }
+
+        if (!visitor(_ow, e, arg))
+            return false;
+    }
+    return true;
+}
+
+bool MicroLan::hasTherm(int coupler, uint8_t branch) const
+{
+    for (size_t i = 0; i < _n; i++) {
+        if (inGroup(i, coupler, branch) &&
+            DSTherm::getFamilyName(_entries[i].id) != NULL)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MicroLan::readGroup(DSTherm& dsth, int coupler, uint8_t branch,
+    DSTherm::ReadingSink& sink, size_t *n, bool& dropped)
+{
+    Placeholder<DSTherm::Scratchpad> scrpd;
+    DSTherm::Reading rd;
+
+    for (size_t i = 0; i < _n; i++)
+    {
+        const Entry& e = _entries[i];
+
+        if (!inGroup(i, coupler, branch) ||
+            DSTherm::getFamilyName(e.id) == NULL)
+        {
+            continue;
+        }
+
+        OneWireNg::ErrorCode ec = dsth.readScratchpad(e.id, scrpd);
+
+        memcpy(rd.id, e.id, sizeof(OneWireNg::Id));
+        rd.temp = (ec == OneWireNg::EC_SUCCESS ?
+            (int16_t)scrpd->getTemp2() : 0);
+        rd.status = (uint8_t)ec;
+        rd.time = (uint32_t)timeMs();
+
+        if (sink.put(rd)) {
+            if (n) (*n)++;
+        } else {
+            dropped = true;
+        }
+    }
+}
@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_MICROLAN__
+#define __OWNG_MICROLAN__
+
+#include <string.h>  /* memset */
+#include "drivers/DS2409.h"
+#include "drivers/DSTherm.h"
+
+/**
+ * Topology aware roster of devices on a 1-wire bus (trunk) split into
+ * branches by DS2409 couplers.
+ *
+ * The roster remembers the branch each device lives on and tracks the
+ * currently connected branch, so a branch is switched (smart-on) only if
+ * an accessed device is not reachable with the current one. Devices on the
+ * trunk (including the couplers) are reachable regardless of the connected
+ * branch. Operations on a number of devices are grouped by branches to
+ * minimise the switching (see @ref forEach(), @ref readTempAll()).
+ *
+ * Roster entries are stored in a table provided by a caller. A single level
+ * of couplers is supported (couplers on the branches are not explored).
+ *
+ * @code
+ * MicroLan::Entry entries[32];
+ * MicroLan lan(ow, entries, 32);
+ *
+ * lan.discover();
+ *
+ * // access a device
+ * if (lan.select(i) == OneWireNg::EC_SUCCESS) {
+ *     // the device is reachable on the bus
+ * }
+ * @endcode
+ */
+class MicroLan
+{
+public:
+    /** Coupler index of devices on the trunk */
+    const static int TRUNK = -1;
+
+    /** Max number of branches with overlapped conversions (see
+        @ref readTempAll()) */
+    const static size_t CONV_ROUND = 8;
+
+    /**
+     * Roster entry.
+     */
+    typedef struct
+    {
+        /** Device id */
+        OneWireNg::Id id;
+        /** Roster index of the coupler the device is behind (@ref TRUNK
+            for devices on the trunk) */
+        int coupler;
+        /** Coupler branch (@c DS2409::Branch) */
+        uint8_t branch;
+    } Entry;
+
+    /**
+     * Roster devices visitor (see @ref forEach()). The visited device is
+     * reachable on the bus while the visitor is called.
+     *
+     * @param ow 1-wire service.
+     * @param entry Visited device.
+     * @param arg User argument.
+     *
+     * @return @c false to stop visiting.
+     */
+    typedef bool (*Visitor)(OneWireNg& ow, const Entry& entry, void *arg);
+
+    /**
+     * Branch switching statistics.
+     */
+    typedef struct
+    {
+        /** Number of branch activations (smart-on commands) */
+        unsigned long switches;
+        /** Number of coupler disconnections (all lines off commands) */
+        unsigned long linesOff;
+    } Stats;
+
+    /**
+     * Roster constructor.
+     *
+     * @param ow 1-wire service of the trunk.
+     * @param entries Roster entries table.
+     * @param max Size of the table.
+     */
+    MicroLan(OneWireNg& ow, Entry *entries, size_t max):
+        _ow(ow), _coupler(ow), _entries(entries), _max(max), _n(0),
+        _active(TRUNK), _activeBranch(0)
+    {
+        resetStats();
+    }
+
+    /**
+     * Add a device to the roster (for known topologies, no search needed).
+     *
+     * @param id Device id.
+     * @param coupler Roster index of the coupler the device is behind
+     *     (@ref TRUNK for a device on the trunk).
+     * @param branch Coupler branch.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_FULL: No space in the roster.
+     *     - @c EC_UNSUPPORED: Invalid coupler (not a DS2409 coupler
+     *         already in the roster, or a coupler not on the trunk).
+     */
+    OneWireNg::ErrorCode add(const OneWireNg::Id& id, int coupler = TRUNK,
+        DS2409::Branch branch = DS2409::BRANCH_MAIN);
+
+#if CONFIG_SEARCH_ENABLED
+    /**
+     * Discover the bus topology. Branches of all couplers are disconnected,
+     * the trunk is searched and subsequently each branch of each coupler on
+     * the trunk is connected and searched for devices not found before.
+     * Previous roster content is discarded.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success (also for no devices on the bus).
+     *     - @c EC_FULL: No space in the roster for all devices.
+     *     - Search process error.
+     */
+    OneWireNg::ErrorCode discover();
+#endif
+
+    /**
+     * Make a roster device reachable on the bus by connecting its branch
+     * (if not already connected).
+     *
+     * @param i Roster index of the device.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_NO_DEVS: No presence on the branch.
+     *     - @c EC_BUS_ERROR: Branch activation not confirmed by the coupler.
+     */
+    OneWireNg::ErrorCode select(size_t i) {
+        return activate(_entries[i].coupler, _entries[i].branch);
+    }
+
+    /**
+     * Disconnect branches of all couplers.
+     *
+     * @see DS2409::allLinesOffAll()
+     */
+    OneWireNg::ErrorCode allLinesOff();
+
+    /**
+     * Visit roster devices grouped by branches: devices on the trunk, on
+     * the currently connected branch and then on the remaining branches,
+     * each of them connected once.
+     *
+     * @param visitor Devices visitor.
+     * @param arg Visitor's argument.
+     * @param family If not zero, only devices of the family are visited.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - Otherwise error of the last branch failed to connect (devices
+     *       on the remaining branches are visited anyway).
+     */
+    OneWireNg::ErrorCode forEach(
+        Visitor visitor, void *arg = NULL, uint8_t family = 0);
+
+    /**
+     * Measure temperature of all Dallas thermometers in the roster and put
+     * the readings into a sink.
+     *
+     * Conversions are started on up to @ref CONV_ROUND branches one after
+     * another (each of them with a single Skip ROM "Convert T" command)
+     * and the branches are read in the same order, each of them not before
+     * its conversion time elapsed. Therefore conversions on a branch are
+     * performed in parallel with conversions started and reads done on the
+     * other branches. Thermometers on the trunk are converted along with
+     * each branch and read at the end.
+     *
+     * Parasitically powered thermometers need their branch connected during
+     * the conversion, therefore for @c parasitic set the branches are
+     * converted and read one by one.
+     *
+     * @param dsth Thermometers driver (of the roster's 1-wire service).
+     * @param sink Readings sink.
+     * @param convTime Conversion time (ms).
+     * @param parasitic Parasitically powered thermometers.
+     * @param n If not @c NULL, number of readings put into the sink is
+     *     written under the address.
+     *
+     * @return
+     *     - @c EC_SUCCESS: Success.
+     *     - @c EC_FULL: Some readings have been dropped by the sink.
+     *     - Otherwise error of the last branch failed to connect.
+     *
+     * @note Read status of each thermometer is provided by
+     *     @c DSTherm::Reading::status.
+     */
+    OneWireNg::ErrorCode readTempAll(DSTherm& dsth,
+        DSTherm::ReadingSink& sink, int convTime = DSTherm::MAX_CONV_TIME,
+        bool parasitic = false, size_t *n = NULL);
+
+    /**
+     * Get roster index of a device.
+     *
+     * @return Roster index or -1 if not found.
+     */
+    int find(const OneWireNg::Id& id) const;
+
+    /**
+     * Get number of devices in the roster.
+     */
+    size_t size() const {
+        return _n;
+    }
+
+    const Entry& getEntry(size_t i) const {
+        return _entries[i];
+    }
+
+    const Stats& getStats() const {
+        return _stats;
+    }
+
+    void resetStats() {
+        memset(&_stats, 0, sizeof(_stats));
+    }
+
+protected:
+    OneWireNg::ErrorCode activate(int coupler, uint8_t branch);
+
+#if CONFIG_SEARCH_ENABLED
+    OneWireNg::ErrorCode searchBranch(int coupler, uint8_t branch);
+#endif
+
+    /* check if i-th entry is the first one of its branch */
+    bool isGroupStart(size_t i) const;
+
+    bool inGroup(size_t i, int coupler, uint8_t branch) const {
+        return (_entries[i].coupler == coupler &&
+            (coupler == TRUNK || _entries[i].branch == branch));
+    }
+
+    bool visitGroup(int coupler, uint8_t branch, Visitor visitor,
+        void *arg, uint8_t family, OneWireNg::ErrorCode& ec);
+
+    bool hasTherm(int coupler, uint8_t branch) const;
+
+    void readGroup(DSTherm& dsth, int coupler, uint8_t branch,
+        DSTherm::ReadingSink& sink, size_t *n, bool& dropped);
+
+    OneWireNg& _ow;
+    DS2409 _coupler;
+
+    Entry *_entries;
+    size_t _max;
+    size_t _n;
+
+    int _active;            /* coupler with connected branch */
+    uint8_t _activeBranch;
+
+    Stats _stats;
+
+#ifdef OWNG_TEST
+    friend class MicroLan_Test;
+#endif
+};
+
+#endif /* __OWNG_MICROLAN__ */
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_READINGS_QUEUE__
+#define __OWNG_READINGS_QUEUE__
+
+#include "drivers/DSTherm.h"
+#include "utils/SpscRing.h"
+
+/**
+ * Lock-free queue of temperature readings passed from a task owning a 1-wire
+ * bus (producer) to a consumer task.
+ *
+ * The queue is a readings sink for @ref DSTherm::readTempAll() (and @c
+ * MAX31850 counterpart). Readings are popped by the consumer via @c pop().
+ * Readings not fitting into the queue are dropped (the producer is never
+ * blocked).
+ *
+ * @tparam N Queue capacity (power of 2).
+ */
+template<size_t N = 16>
+class ReadingsQueue:
+    public DSTherm::ReadingSink, public SpscRing<DSTherm::Reading, N>
+{
+public:
+    ReadingsQueue(): _dropped(0) {}
+
+    bool put(const DSTherm::Reading& rd)
+    {
+        if (this->push(rd))
+            return true;
+
+        _dropped++;
+        return false;
+    }
+
+    /**
+     * Get number of readings dropped due to the queue overflow.
+     */
+    unsigned long getDropped() const {
+        return _dropped;
+    }
+
+private:
+    unsigned long _dropped;     /** written by the producer only */
+};
+
+#endif /* __OWNG_READINGS_QUEUE__ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Piotr Stolarz
+ * OneWireNg: Arduino 1-wire service library
+ *
+ * Distributed under the 2-clause BSD License (the License)
+ * see accompanying file LICENSE for details.
+ *
+ * This software is distributed WITHOUT ANY WARRANTY; without even the
+ * implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the License for more information.
+ */
+
+#ifndef __OWNG_SPSC_RING__
+#define __OWNG_SPSC_RING__
+
+#include <stddef.h>
+
+/*
+ * Ring indexes (size_t) are accessed with acquire/release semantics to
+ * guarantee an element is fully written (read) before its index update is
+ * observed by the other side. For compilers with no atomic builtins, the
+ * indexes are accessed as volatile, which prevents the compiler from caching
+ * them, but doesn't order the (non-volatile) element accesses; the fallback
+ * relies on the compiler not moving memory accesses across volatile ones
+ * and is intended for single core platforms only.
+ */
+#if defined(__ATOMIC_ACQUIRE) && defined(__ATOMIC_RELEASE)
+# define __SPSC_LOAD_ACQ(v) __atomic_load_n(&(v), __ATOMIC_ACQUIRE)
+# define __SPSC_STORE_REL(v, n) __atomic_store_n(&(v), (n), __ATOMIC_RELEASE)
+#else
+# define __SPSC_LOAD_ACQ(v) (*(const volatile size_t*)&(v))
+# define __SPSC_STORE_REL(v, n) (*(volatile size_t*)&(v) = (n))
+#endif
+
+/**
+ * Fixed capacity, lock-free single-producer/single-consumer ring.
+ *
+ * Both @ref push() (producer side) and @ref pop() (consumer side) are
+ * wait-free and may be called concurrently from different tasks (or
+ * a task and an interrupt handler), provided there is a single producer
+ * and a single consumer. The ring is intended to pass data between a task
+ * owning a 1-wire bus and a consumer task with no locking of the bus task.
+ *
+ * @tparam T Element type (trivially copyable).
+ * @tparam N Ring capacity (power of 2; the ring stores up to @c N
+ *     elements).
+ *
+ * @note On platforms where @c size_t access is not atomic (8-bit AVR)
+ *     the ring may be used between tasks only (no interrupt handlers).
+ */
+template<class T, size_t N>
+class SpscRing
+{
+#if __cplusplus >= 201103L
+    static_assert(N > 0 && !(N & (N - 1)), "Capacity not a power of 2");
+#endif
+
+public:
+    SpscRing(): _head(0), _tail(0) {}
+
+    /**
+     * Push an element (producer side).
+     *
+     * @return @c true on success, @c false if the ring is full.
+     */
+    bool push(const T& v)
+    {
+        size_t tail = _tail;    /* owned by the producer */
+        if (tail - __SPSC_LOAD_ACQ(_head) >= N)
+            return false;
+
+        _buf[tail & (N - 1)] = v;
+        __SPSC_STORE_REL(_tail, tail + 1);
+        return true;
+    }
+
+    /**
+     * Pop an element (consumer side).
+     *
+     * @return @c true on success, @c false if the ring is empty.
+     */
+    bool pop(T& v)
+    {
+        size_t head = _head;    /* owned by the consumer */
+        if (head == __SPSC_LOAD_ACQ(_tail))
+            return false;
+
+        v = _buf[head & (N - 1)];
+        __SPSC_STORE_REL(_head, head + 1);
+        return true;
+    }
+
+    /**
+     * Get pointer to the oldest element with no popping it (consumer side).
+     *
+     * @return Pointer to the element or @c NULL if the ring is empty.
+     */
+    const T *peek() const
+    {
+        size_t head = _head;
+        return (head == __SPSC_LOAD_ACQ(_tail) ? NULL : &_buf[head & (N - 1)]);
+    }
+
+    /**
+     * Get number of elements in the ring. The number is a snapshot, which
+     * may be outdated on return if called concurrently with the other side.
+     */
+    size_t size() const {
+        return __SPSC_LOAD_ACQ(_tail) - __SPSC_LOAD_ACQ(_head);
+    }
+
+    bool isEmpty() const {
+        return !size();
+    }
+
+    bool isFull() const {
+        return size() >= N;
+    }
+
+    static size_t capacity() {
+        return N;
+    }
+
+private:
+    T _buf[N];
+
+    /* indexes are free running (wrapped by the capacity mask) */
+    size_t _head;   /** next element to pop; written by the consumer */
+    size_t _tail;   /** next element to push; written by the producer */
+};
+
+#undef __SPSC_LOAD_ACQ
+#undef __SPSC_STORE_REL
+
+#endif /* __OWNG_SPSC_RING__ */